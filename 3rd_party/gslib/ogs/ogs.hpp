@@ -260,6 +260,10 @@ typedef struct {
 
   int earlyPrepostRecv;
 
+  // persistent MPI requests on dedicated buffers, one set per unit size
+  int persistent;
+  void *persistentComm;
+
   oogs_mode mode;
 
 } oogs_t;
@@ -267,7 +271,10 @@ typedef struct {
 namespace oogs{
 
 void start(occa::memory &o_v, const int k, const int stride, const char *type, const char *op, oogs_t *h);
-void finish(occa::memory &o_v, const int k, const int stride, const char *type, const char *op, oogs_t *h);
+// callback is invoked once the local gather-scatter is enqueued, work launched
+// from it overlaps the halo exchange but must not touch halo nodes
+void finish(occa::memory &o_v, const int k, const int stride, const char *type, const char *op, oogs_t *h,
+            std::function<void()> callback = nullptr);
 void startFinish(void *v, const int k, const int stride, const char *type, const char *op, oogs_t *h);
 void startFinish(occa::memory &o_v, const int k, const int stride, const char *type, const char *op, oogs_t *h);
 oogs_t *setup(ogs_t *ogs, int nVec, int stride, const char *type, std::function<void()> callback, oogs_mode gsMode);
@@ -1,5 +1,6 @@
 #include <limits>
 #include <list>
+#include <vector>
 #include <occa.hpp>
 
 #include "ogstypes.h"
@@ -61,6 +62,15 @@ struct gs_data {
 }
 #endif
 
+struct persistentComm_t {
+  int unitSize;
+  oogs_mode mode;
+  occa::memory h_buffSend, h_buffRecv;
+  unsigned char *bufSend, *bufRecv;
+  occa::memory o_bufSend, o_bufRecv;
+  std::vector<MPI_Request> req; /* recvs followed by sends */
+};
+
 static void convertPwMap(const uint *restrict map,
                          int *restrict starts,
                          int *restrict ids)
@@ -79,6 +89,87 @@ static void convertPwMap(const uint *restrict map,
   }
 }
 
+// buffers and requests are created on first use and reused for the rest of the run
+static persistentComm_t *persistentComm(int unit_size, oogs_t *gs)
+{
+  ogs_t *ogs = gs->ogs;
+  struct gs_data *hgs = (gs_data*) ogs->haloGshSym;
+  const struct pw_data *pwd = (pw_data*) hgs->r.data;
+  const struct comm *comm = &hgs->comm;
+
+  if(!gs->persistentComm) gs->persistentComm = new std::list<persistentComm_t>();
+  std::list<persistentComm_t> *list = (std::list<persistentComm_t>*) gs->persistentComm;
+  for(auto &pc : *list)
+    if(pc.unitSize == unit_size && pc.mode == gs->mode) return &pc;
+
+  list->emplace_back();
+  persistentComm_t *pc = &list->back();
+  pc->unitSize = unit_size;
+  pc->mode = gs->mode;
+  pc->bufSend = (unsigned char*) ogsHostMallocPinned(ogs->device, pwd->comm[send].total*unit_size, NULL, pc->o_bufSend, pc->h_buffSend);
+  pc->bufRecv = (unsigned char*) ogsHostMallocPinned(ogs->device, pwd->comm[recv].total*unit_size, NULL, pc->o_bufRecv, pc->h_buffRecv);
+  pc->req.resize(pwd->comm[recv].n + pwd->comm[send].n);
+
+  {
+    unsigned char *buf = (unsigned char*)pc->o_bufRecv.ptr();
+    if(gs->mode != OOGS_DEVICEMPI) buf = pc->bufRecv;
+
+    MPI_Request *req = pc->req.data();
+    const struct pw_comm_data *c = &pwd->comm[recv];
+    const uint *p, *pe, *size=c->size;
+    for(p=c->p,pe=p+c->n;p!=pe;++p) {
+      const int len = *(size++) * unit_size;
+      MPI_Recv_init((void*)buf,len,MPI_UNSIGNED_CHAR,*p,*p,comm->c,req++);
+      buf += len;
+    }
+  }
+
+  {
+    unsigned char *buf = (unsigned char*)pc->o_bufSend.ptr();
+    if(gs->mode != OOGS_DEVICEMPI) buf = pc->bufSend;
+
+    MPI_Request *req = pc->req.data() + pwd->comm[recv].n;
+    const struct pw_comm_data *c = &pwd->comm[send];
+    const uint *p, *pe, *size=c->size;
+    for(p=c->p,pe=p+c->n;p!=pe;++p) {
+      const int len = *(size++) * unit_size;
+      MPI_Send_init((void*)buf,len,MPI_UNSIGNED_CHAR,*p,comm->id,comm->c,req++);
+      buf += len;
+    }
+  }
+
+  return pc;
+}
+
+static void freePersistentComm(oogs_t *gs)
+{
+  std::list<persistentComm_t> *list = (std::list<persistentComm_t>*) gs->persistentComm;
+  if(!list) return;
+  for(auto &pc : *list) {
+    for(auto &req : pc.req) MPI_Request_free(&req);
+    pc.o_bufSend.free();
+    pc.o_bufRecv.free();
+    pc.h_buffSend.free();
+    pc.h_buffRecv.free();
+  }
+  delete list;
+  gs->persistentComm = NULL;
+}
+
+// recvs were already started in oogs::start
+static void persistentExchange(persistentComm_t *pc, oogs_t *gs)
+{
+  ogs_t *ogs = gs->ogs;
+  struct gs_data *hgs = (gs_data*) ogs->haloGshSym;
+  const struct pw_data *pwd = (pw_data*) hgs->r.data;
+  const int nrecv = pwd->comm[recv].n;
+  const int nsend = pwd->comm[send].n;
+
+  if(gs->mode != OOGS_DEVICEMPI) ogs->device.finish(); // waiting for send buffers to be ready
+  MPI_Startall(nsend, pc->req.data() + nrecv);
+  MPI_Waitall(nrecv + nsend, pc->req.data(), MPI_STATUSES_IGNORE);
+}
+
 static void pairwiseExchange(int unit_size, oogs_t *gs)
 {
   ogs_t *ogs = gs->ogs;
@@ -139,6 +230,8 @@ oogs_t* oogs::setup(ogs_t *ogs, int nVec, dlong stride, const char *type, std::f
   MPI_Comm_rank(gs->comm, &rank);
   gs->rank = rank; 
   gs->mode = gsMode;
+  gs->persistent = 0;
+  gs->persistentComm = NULL;
 
   if(gsMode == OOGS_DEFAULT) return gs; 
   for(int r = 0; r < 2; ++r){
@@ -202,18 +295,30 @@ oogs_t* oogs::setup(ogs_t *ogs, int nVec, dlong stride, const char *type, std::f
     char* q = (char*) calloc(std::max(stride,ogs->N)*unit_size, sizeof(char));
     occa::memory o_q = device.malloc(std::max(stride,ogs->N)*unit_size, q);
     int* prepostRecv = (int*) calloc(oogs_mode_list.size(), sizeof(int));
+    int* persistent = (int*) calloc(oogs_mode_list.size(), sizeof(int));
 
     for (auto const& mode : oogs_mode_list)
     {
       gs->mode = mode;
       prepostRecv[gs->mode] = 0; 
+      persistent[gs->mode] = 0;
+      gs->earlyPrepostRecv = 0;
+      gs->persistent = 0;
       // warum-up
       oogs::start (o_q, nVec, stride, type, ogsAdd, gs);
       if(callback) callback();
       oogs::finish(o_q, nVec, stride, type, ogsAdd, gs);
 
-      for(int pass = 0; pass < 2; pass++) {
-        gs->earlyPrepostRecv = pass;
+      // plain, early prepost recvs and persistent requests (implies early prepost)
+      const int Npasses = (gs->mode == OOGS_DEFAULT) ? 2 : 3;
+      for(int pass = 0; pass < Npasses; pass++) {
+        gs->earlyPrepostRecv = (pass > 0);
+        gs->persistent = (pass == 2);
+        if(gs->persistent) {
+          // exclude request setup from timing
+          oogs::start (o_q, nVec, stride, type, ogsAdd, gs);
+          oogs::finish(o_q, nVec, stride, type, ogsAdd, gs);
+        }
         device.finish();
         MPI_Barrier(gs->comm);
         const double tStart = MPI_Wtime();
@@ -229,26 +334,38 @@ oogs_t* oogs::setup(ogs_t *ogs, int nVec, dlong stride, const char *type, std::f
         if(elapsed < elapsedMin){
           fastestMode = gs->mode;
           elapsedMin = elapsed;
-          if(pass) prepostRecv[fastestMode] = 1;
+          prepostRecv[fastestMode] = gs->earlyPrepostRecv;
+          persistent[fastestMode] = gs->persistent;
         }
       }
     }
     MPI_Bcast(&fastestMode, 1, MPI_INT, 0, gs->comm);
     MPI_Bcast(prepostRecv, oogs_mode_list.size(), MPI_INT, 0, gs->comm);
+    MPI_Bcast(persistent, oogs_mode_list.size(), MPI_INT, 0, gs->comm);
     gs->mode = fastestMode;
     gs->earlyPrepostRecv = prepostRecv[gs->mode];
+    gs->persistent = persistent[gs->mode];
     o_q.free();
     free(q);
     free(prepostRecv);
+    free(persistent);
+    freePersistentComm(gs); // drop buffers of the modes not taken
   } else {
     gs->mode = gsMode;
     gs->earlyPrepostRecv = 0;
   }
 
+  const char* env_persistent = std::getenv ("OGS_PERSISTENT_COMM");
+  if(env_persistent != NULL && gs->mode != OOGS_DEFAULT) {
+    gs->persistent = std::stoi(env_persistent) ? 1 : 0;
+    gs->earlyPrepostRecv |= gs->persistent;
+  }
+
 #ifdef DISABLE_OOGS
   gs->mode = OOGS_DEFAULT;
+  gs->persistent = 0;
 #endif
-  if(gs->rank == 0) printf("used mode: %d.%d\n", gs->mode, gs->earlyPrepostRecv);
+  if(gs->rank == 0) printf("used mode: %d.%d.%d\n", gs->mode, gs->earlyPrepostRecv, gs->persistent);
 
   return gs; 
 }
@@ -381,6 +498,20 @@ void oogs::start(occa::memory &o_v, const int k, const dlong stride, const char
   }
 
   if (ogs->NhaloGather) {
+    if(gs->persistent) {
+      persistentComm_t *pc = persistentComm(Nbytes*k, gs);
+
+      packBuf(gs, ogs->NhaloGather, k, stride, ogs->o_haloGatherOffsets, ogs->o_haloGatherIds, 
+              gs->o_scatterOffsets, gs->o_scatterIds, _type, op, o_v, pc->o_bufSend);
+
+      struct gs_data *hgs = (gs_data*) ogs->haloGshSym;
+      const struct pw_data *pwd = (pw_data*) hgs->r.data;
+      MPI_Startall(pwd->comm[recv].n, pc->req.data());
+
+      ogs->device.finish();
+      return;
+    }
+
     reallocBuffers(Nbytes*k, gs);
 
     packBuf(gs, ogs->NhaloGather, k, stride, ogs->o_haloGatherOffsets, ogs->o_haloGatherIds, 
@@ -400,8 +531,8 @@ void oogs::start(occa::memory &o_v, const int k, const dlong stride, const char
       const uint *p, *pe, *size=c->size;
       uint bufOffset = 0;
       for(p=c->p,pe=p+c->n;p!=pe;++p) {
-        const size_t len = *(size++) * unit_size;
-        MPI_Irecv((void*)buf,len*unit_size,MPI_UNSIGNED_CHAR,*p,*p,gs->comm,req++);
+        const int len = *(size++) * unit_size;
+        MPI_Irecv((void*)buf,len,MPI_UNSIGNED_CHAR,*p,*p,gs->comm,req++);
         buf += len;
       }
     }
@@ -410,7 +541,8 @@ void oogs::start(occa::memory &o_v, const int k, const dlong stride, const char
   }
 }
 
-void oogs::finish(occa::memory &o_v, const int k, const dlong stride, const char *_type, const char *op, oogs_t *gs) 
+void oogs::finish(occa::memory &o_v, const int k, const dlong stride, const char *_type, const char *op, oogs_t *gs,
+                  std::function<void()> callback) 
 {
   size_t Nbytes;
   ogs_t *ogs = gs->ogs; 
@@ -433,7 +565,8 @@ void oogs::finish(occa::memory &o_v, const int k, const dlong stride, const char
       ogsGatherScatterManyFinish(o_v, k, stride, type, op, ogs);
     else
       ogsGatherScatterFinish(o_v, type, op, ogs);
-    
+
+    if(callback) callback();
     return;
   }
 
@@ -441,6 +574,8 @@ void oogs::finish(occa::memory &o_v, const int k, const dlong stride, const char
     occaGatherScatterMany(ogs->NlocalGather, k, stride, ogs->o_localGatherOffsets, 
 		          ogs->o_localGatherIds, type, op, o_v);
 
+  if(callback) callback();
+
   if (ogs->NhaloGather) {
     ogs->device.setStream(ogs::dataStream);
 
@@ -448,18 +583,27 @@ void oogs::finish(occa::memory &o_v, const int k, const dlong stride, const char
     const void* execdata = hgs->r.data;
     const struct pw_data *pwd = (pw_data*) execdata;
 
+    persistentComm_t *pc = (gs->persistent) ? persistentComm(Nbytes*k, gs) : NULL;
+    occa::memory &o_bufSend = (pc) ? pc->o_bufSend : gs->o_bufSend;
+    occa::memory &o_bufRecv = (pc) ? pc->o_bufRecv : gs->o_bufRecv;
+    unsigned char *bufSend = (pc) ? pc->bufSend : gs->bufSend;
+    unsigned char *bufRecv = (pc) ? pc->bufRecv : gs->bufRecv;
+
     if(gs->mode == OOGS_HOSTMPI)
-      gs->o_bufSend.copyTo(gs->bufSend, pwd->comm[send].total*Nbytes*k, 0, "async: true");
+      o_bufSend.copyTo(bufSend, pwd->comm[send].total*Nbytes*k, 0, "async: true");
 
     ogsHostTic(gs->comm, 1);
-    pairwiseExchange(Nbytes*k, gs);
+    if(pc)
+      persistentExchange(pc, gs);
+    else
+      pairwiseExchange(Nbytes*k, gs);
     ogsHostToc();
 
     if(gs->mode == OOGS_HOSTMPI)
-      gs->o_bufRecv.copyFrom(gs->bufRecv,pwd->comm[recv].total*Nbytes*k, 0, "async: true");
+      o_bufRecv.copyFrom(bufRecv,pwd->comm[recv].total*Nbytes*k, 0, "async: true");
 
     unpackBuf(gs, ogs->NhaloGather, k, stride, gs->o_gatherOffsets, gs->o_gatherIds, 
-              ogs->o_haloGatherOffsets, ogs->o_haloGatherIds, _type, op, gs->o_bufRecv, o_v);
+              ogs->o_haloGatherOffsets, ogs->o_haloGatherIds, _type, op, o_bufRecv, o_v);
 
     ogs->device.finish();
     ogs->device.setStream(ogs::defaultStream);
@@ -480,6 +624,8 @@ void oogs::destroy(oogs_t *gs)
 {
   //ogsFree(gs->ogs);
 
+  freePersistentComm(gs);
+
   gs->h_buffSend.free();
   gs->h_buffRecv.free();
 
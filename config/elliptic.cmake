@@ -2,6 +2,8 @@ set(ELLIPTIC_SOURCE_DIR ${CMAKE_CURRENT_SOURCE_DIR}/src/elliptic)
 
 set(ELLIPTIC_SOURCES
         ${ELLIPTIC_SOURCE_DIR}/linearSolver/PCG.cpp
+        ${ELLIPTIC_SOURCE_DIR}/linearSolver/PCGMixed.cpp
+        ${ELLIPTIC_SOURCE_DIR}/linearSolver/Chebyshev.cpp
 	      ${ELLIPTIC_SOURCE_DIR}/ellipticBuildContinuous.cpp
         ${ELLIPTIC_SOURCE_DIR}/ellipticBuildContinuousGalerkin.cpp
         ${ELLIPTIC_SOURCE_DIR}/ellipticJacobi.cpp
@@ -12,6 +14,7 @@ set(ELLIPTIC_SOURCES
         ${ELLIPTIC_SOURCE_DIR}/ellipticMultiGridLevelSetup.cpp
         ${ELLIPTIC_SOURCE_DIR}/ellipticMultiGridSchwarz.cpp
         ${ELLIPTIC_SOURCE_DIR}/ellipticMultiGridSetup.cpp
+        ${ELLIPTIC_SOURCE_DIR}/ellipticMultiGridUpdate.cpp
         ${ELLIPTIC_SOURCE_DIR}/ellipticOperator.cpp
         ${ELLIPTIC_SOURCE_DIR}/ellipticPreconditioner.cpp
         ${ELLIPTIC_SOURCE_DIR}/ellipticPreconditionerSetup.cpp
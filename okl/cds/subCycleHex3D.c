@@ -26,16 +26,15 @@ extern "C" void subCycleStrongCubatureVolumeHex3D(const int & Nelements,
                                                   const int & offset,
                                                   const int & cubatureOffset,
                                                   const int & NSOffset,
+                                                  const int & Nfields,
                                                   const dfloat * __restrict__ invLumpedMassMatrix,
                                                   const dfloat * __restrict__ BdivW,
-                                                  const dfloat & c0,
-                                                  const dfloat & c1,
-                                                  const dfloat & c2,
+                                                  const dfloat * __restrict__ extC,
                                                   const dfloat * __restrict__ conv,
                                                   const dfloat * __restrict__ S,
                                                   dfloat * __restrict__ NU) {
   // (phi, U.grad Ud)
-  dfloat r_c[3] = {c0, c1,c2};
+  dfloat r_c[3] = {extC[0], extC[1], extC[2]};
   dfloat s_cubD[p_cubNq][p_cubNq];
   dfloat s_cubInterpT[p_Nq][p_cubNq];
   dfloat s_cubProjectT[p_cubNq][p_Nq];
@@ -44,6 +43,9 @@ extern "C" void subCycleStrongCubatureVolumeHex3D(const int & Nelements,
   dfloat s_Ud1[p_Nq][p_cubNq];
   dfloat r_U2[p_cubNq][p_cubNq][p_cubNq];
   dfloat r_Ud[p_cubNq][p_cubNq][p_cubNq];
+  dfloat r_Uhat[p_cubNq][p_cubNq][p_cubNq];
+  dfloat r_Vhat[p_cubNq][p_cubNq][p_cubNq];
+  dfloat r_What[p_cubNq][p_cubNq][p_cubNq];
   #pragma unroll
   for (int j = 0; j < p_cubNq; ++j) {
     #pragma unroll
@@ -56,209 +58,216 @@ extern "C" void subCycleStrongCubatureVolumeHex3D(const int & Nelements,
       s_cubD[j][i] = cubD[id];
     }
   }
-  #pragma omp parallel for private(s_U, s_Ud, s_Ud1, r_U2, r_Ud)
+  #pragma omp parallel for private(s_U, s_Ud, s_Ud1, r_U2, r_Ud, r_Uhat, r_Vhat, r_What)
   for (int e = 0; e < Nelements; ++e) {
     const int element = elementList[e];
+
+    // extrapolated velocity, shared by all fields
     #pragma unroll
-    for (int j = 0; j < p_cubNq; ++j) {
+    for (int k = 0; k < p_cubNq; ++k) {
       #pragma unroll
-      for (int i = 0; i < p_cubNq; ++i) {
+      for (int j = 0; j < p_cubNq; ++j) {
         #pragma unroll
-        for (int k = 0; k < p_cubNq; ++k) {
-          r_Ud[j][i][k] = 0;
+        for (int i = 0; i < p_cubNq; ++i) {
+          const int id = element * p_cubNp + k * p_cubNq * p_cubNq + j * p_cubNq + i;
+          dfloat Uhat = 0.0, Vhat = 0.0, What = 0.0;
+          #pragma unroll
+          for (int s = 0; s < p_nEXT; ++s) {
+            const int s_offset = s * p_NVfields * cubatureOffset;
+            const dfloat coeff = r_c[s];
+            Uhat += coeff * conv[id + 0 * cubatureOffset + s_offset];
+            Vhat += coeff * conv[id + 1 * cubatureOffset + s_offset];
+            What += coeff * conv[id + 2 * cubatureOffset + s_offset];
+          }
+          r_Uhat[j][i][k] = Uhat;
+          r_Vhat[j][i][k] = Vhat;
+          r_What[j][i][k] = What;
         }
       }
     }
-    #pragma unroll
-    for (int c = 0; c < p_Nq; ++c) {
-      #pragma unroll
-      for (int b = 0; b < p_Nq; ++b) {
-        #pragma unroll
-        for (int a = 0; a < p_Nq; ++a) {
-            // this can be improved
-            const int id = element * p_Np + c * p_Nq * p_Nq + b * p_Nq + a;
-            s_Ud[b][a] = S[id];
-        }
-      }
 
-      // interpolate in 'r'
+    for (int fld = 0; fld < Nfields; ++fld) {
       #pragma unroll
-      for (int b = 0; b < p_Nq; ++b) {
+      for (int j = 0; j < p_cubNq; ++j) {
         #pragma unroll
         for (int i = 0; i < p_cubNq; ++i) {
-            dfloat Ud1 = 0;
-            #pragma unroll
-            for (int a = 0; a < p_Nq; ++a) {
-              dfloat Iia = s_cubInterpT[a][i];
-              Ud1 += Iia * s_Ud[b][a];
-            }
-            s_Ud1[b][i] = Ud1;
+          #pragma unroll
+          for (int k = 0; k < p_cubNq; ++k) {
+            r_Ud[j][i][k] = 0;
+          }
         }
       }
-
-      // interpolate in 's'
       #pragma unroll
-      for (int j = 0; j < p_cubNq; ++j) {
+      for (int c = 0; c < p_Nq; ++c) {
         #pragma unroll
-        for (int i = 0; i < p_cubNq; ++i) {
-          dfloat Ud2 = 0;
-
-          // interpolate in b
+        for (int b = 0; b < p_Nq; ++b) {
           #pragma unroll
-          for (int b = 0; b < p_Nq; ++b) {
-            dfloat Ijb = s_cubInterpT[b][j];
-            Ud2 += Ijb * s_Ud1[b][i];
+          for (int a = 0; a < p_Nq; ++a) {
+              // this can be improved
+              const int id = element * p_Np + c * p_Nq * p_Nq + b * p_Nq + a;
+              s_Ud[b][a] = S[id + fld * offset];
           }
+        }
 
-          // interpolate in c progressively
+        // interpolate in 'r'
+        #pragma unroll
+        for (int b = 0; b < p_Nq; ++b) {
           #pragma unroll
-          for (int k = 0; k < p_cubNq; ++k) {
-            dfloat Ikc = s_cubInterpT[c][k];
-            r_Ud[j][i][k] += Ikc * Ud2;
+          for (int i = 0; i < p_cubNq; ++i) {
+              dfloat Ud1 = 0;
+              #pragma unroll
+              for (int a = 0; a < p_Nq; ++a) {
+                dfloat Iia = s_cubInterpT[a][i];
+                Ud1 += Iia * s_Ud[b][a];
+              }
+              s_Ud1[b][i] = Ud1;
           }
         }
-      }
-    }
 
-    // Uhat * dr
-    #pragma unroll p_cubNq
-    for (int j = 0; j < p_cubNq; ++j) {
-      #pragma unroll
-      for (int k = 0; k < p_cubNq; ++k) {
+        // interpolate in 's'
         #pragma unroll
-        for (int i = 0; i < p_cubNq; ++i) {
-          dfloat Udr = 0;
+        for (int j = 0; j < p_cubNq; ++j) {
           #pragma unroll
-          for (int n = 0; n < p_cubNq; ++n) {
-            dfloat Din = s_cubD[i][n];
-            Udr += Din * r_Ud[j][n][k];
-          }
-          dfloat Uhat = 0.0;
-          const int id = element * p_cubNp + k * p_cubNq * p_cubNq + j * p_cubNq + i;
-          #pragma unroll
-          for (int s = 0; s < p_nEXT; ++s) {
-            const int s_offset = s * p_NVfields * cubatureOffset;
-            const dfloat coeff = r_c[s];
-            Uhat += coeff * conv[id + 0 * cubatureOffset + s_offset];
-          }
+          for (int i = 0; i < p_cubNq; ++i) {
+            dfloat Ud2 = 0;
 
-          // U*dUdx + V*dUdy + W*dUdz = (U*(drdx*dUdr+dsdx*dUds+dtdx*dUdt) + V*(drdy*dUdr ..))
+            // interpolate in b
+            #pragma unroll
+            for (int b = 0; b < p_Nq; ++b) {
+              dfloat Ijb = s_cubInterpT[b][j];
+              Ud2 += Ijb * s_Ud1[b][i];
+            }
 
-          // I_f^t*(J_f*C_f^t)*G_f*\hat{D}_f*I_f*u
-          r_U2[j][i][k] = Uhat * Udr;
+            // interpolate in c progressively
+            #pragma unroll
+            for (int k = 0; k < p_cubNq; ++k) {
+              dfloat Ikc = s_cubInterpT[c][k];
+              r_Ud[j][i][k] += Ikc * Ud2;
+            }
+          }
         }
       }
-    }
-    // Vhat * ds
-    #pragma unroll p_cubNq
-    for (int j = 0; j < p_cubNq; ++j) {
-      #pragma unroll
-      for (int i = 0; i < p_cubNq; ++i) {
+
+      // Uhat * dr
+      #pragma unroll p_cubNq
+      for (int j = 0; j < p_cubNq; ++j) {
         #pragma unroll
         for (int k = 0; k < p_cubNq; ++k) {
-          dfloat Uds = 0;
-          #pragma unroll
-          for (int n = 0; n < p_cubNq; ++n) {
-            dfloat Djn = s_cubD[j][n];
-            Uds += Djn * r_Ud[n][i][k];
-          }
-          dfloat Vhat = 0.0;
-          const int id = element * p_cubNp + k * p_cubNq * p_cubNq + j * p_cubNq + i;
           #pragma unroll
-          for (int s = 0; s < p_nEXT; ++s) {
-            const int s_offset = s * p_NVfields * cubatureOffset;
-            const dfloat coeff = r_c[s];
-            Vhat += coeff * conv[id + 1 * cubatureOffset + s_offset];
-          }
+          for (int i = 0; i < p_cubNq; ++i) {
+            dfloat Udr = 0;
+            #pragma unroll
+            for (int n = 0; n < p_cubNq; ++n) {
+              dfloat Din = s_cubD[i][n];
+              Udr += Din * r_Ud[j][n][k];
+            }
+            const dfloat Uhat = r_Uhat[j][i][k];
 
-          // U*dUdx + V*dUdy + W*dUdz = (U*(drdx*dUdr+dsdx*dUds+dtdx*dUdt) + V*(drdy*dUdr ..))
+            // U*dUdx + V*dUdy + W*dUdz = (U*(drdx*dUdr+dsdx*dUds+dtdx*dUdt) + V*(drdy*dUdr ..))
 
-          // I_f^t*(J_f*C_f^t)*G_f*\hat{D}_f*I_f*u
-          r_U2[j][i][k] += Vhat * Uds;
+            // I_f^t*(J_f*C_f^t)*G_f*\hat{D}_f*I_f*u
+            r_U2[j][i][k] = Uhat * Udr;
+          }
         }
       }
-    }
-    // What * dt
-    #pragma unroll p_cubNq
-    for (int j = 0; j < p_cubNq; ++j) {
-      #pragma unroll
-      for (int k = 0; k < p_cubNq; ++k) {
+      // Vhat * ds
+      #pragma unroll p_cubNq
+      for (int j = 0; j < p_cubNq; ++j) {
         #pragma unroll
         for (int i = 0; i < p_cubNq; ++i) {
-          dfloat Udt = 0;
-          #pragma unroll
-          for (int n = 0; n < p_cubNq; ++n) {
-            dfloat Dkn = s_cubD[k][n];
-            Udt += Dkn * r_Ud[j][i][n];
-          }
-          dfloat What = 0.0;
-          const int id = element * p_cubNp + k * p_cubNq * p_cubNq + j * p_cubNq + i;
           #pragma unroll
-          for (int s = 0; s < p_nEXT; ++s) {
-            const int s_offset = s * p_NVfields * cubatureOffset;
-            const dfloat coeff = r_c[s];
-            What += coeff * conv[id + 2 * cubatureOffset + s_offset];
-          }
+          for (int k = 0; k < p_cubNq; ++k) {
+            dfloat Uds = 0;
+            #pragma unroll
+            for (int n = 0; n < p_cubNq; ++n) {
+              dfloat Djn = s_cubD[j][n];
+              Uds += Djn * r_Ud[n][i][k];
+            }
+            const dfloat Vhat = r_Vhat[j][i][k];
 
-          // U*dUdx + V*dUdy + W*dUdz = (U*(drdx*dUdr+dsdx*dUds+dtdx*dUdt) + V*(drdy*dUdr ..))
+            // U*dUdx + V*dUdy + W*dUdz = (U*(drdx*dUdr+dsdx*dUds+dtdx*dUdt) + V*(drdy*dUdr ..))
 
-          // I_f^t*(J_f*C_f^t)*G_f*\hat{D}_f*I_f*u
-          r_U2[j][i][k] += What * Udt;
+            // I_f^t*(J_f*C_f^t)*G_f*\hat{D}_f*I_f*u
+            r_U2[j][i][k] += Vhat * Uds;
+          }
         }
       }
-    }
-
-    // now project back in t
-    #pragma unroll
-    for (int c = 0; c < p_Nq; ++c) {
-      #pragma unroll
+      // What * dt
+      #pragma unroll p_cubNq
       for (int j = 0; j < p_cubNq; ++j) {
         #pragma unroll
-        for (int i = 0; i < p_cubNq; ++i) {
-          dfloat rhsU = 0;
+        for (int k = 0; k < p_cubNq; ++k) {
           #pragma unroll
-          for (int k = 0; k < p_cubNq; ++k) {
-            dfloat Ikc = s_cubInterpT[c][k];
-            rhsU += Ikc * r_U2[j][i][k];
+          for (int i = 0; i < p_cubNq; ++i) {
+            dfloat Udt = 0;
+            #pragma unroll
+            for (int n = 0; n < p_cubNq; ++n) {
+              dfloat Dkn = s_cubD[k][n];
+              Udt += Dkn * r_Ud[j][i][n];
+            }
+            const dfloat What = r_What[j][i][k];
+
+            // U*dUdx + V*dUdy + W*dUdz = (U*(drdx*dUdr+dsdx*dUds+dtdx*dUdt) + V*(drdy*dUdr ..))
+
+            // I_f^t*(J_f*C_f^t)*G_f*\hat{D}_f*I_f*u
+            r_U2[j][i][k] += What * Udt;
           }
-          s_U[j][i] = rhsU;
         }
       }
+
+      // now project back in t
       #pragma unroll
-      for (int b = 0; b < p_Nq; ++b) {
+      for (int c = 0; c < p_Nq; ++c) {
         #pragma unroll
-        for (int i = 0; i < p_cubNq; ++i) {
+        for (int j = 0; j < p_cubNq; ++j) {
+          #pragma unroll
+          for (int i = 0; i < p_cubNq; ++i) {
             dfloat rhsU = 0;
             #pragma unroll
-            for (int j = 0; j < p_cubNq; ++j) {
-              dfloat Ijb = s_cubInterpT[b][j];
-              rhsU += Ijb * s_U[j][i];
+            for (int k = 0; k < p_cubNq; ++k) {
+              dfloat Ikc = s_cubInterpT[c][k];
+              rhsU += Ikc * r_U2[j][i][k];
             }
-            s_Ud[b][i] = rhsU;
+            s_U[j][i] = rhsU;
+          }
         }
-      }
-      #pragma unroll
-      for (int b = 0; b < p_Nq; ++b) {
         #pragma unroll
-        for (int a = 0; a < p_Nq; ++a) {
-            dfloat rhsU = 0;
-            #pragma unroll
-            for (int i = 0; i < p_cubNq; ++i) {
-              dfloat Iia = s_cubInterpT[a][i];
-              rhsU += Iia * s_Ud[b][i];
-            }
-            const int id = element * p_Np + c * p_Nq * p_Nq + b * p_Nq + a;
-            dfloat invLMM = p_MovingMesh ? 0.0 : invLumpedMassMatrix[id];
-            dfloat bdivw = 0.0;
-            if (p_MovingMesh) {
+        for (int b = 0; b < p_Nq; ++b) {
+          #pragma unroll
+          for (int i = 0; i < p_cubNq; ++i) {
+              dfloat rhsU = 0;
               #pragma unroll
-              for (int s = 0; s < p_nEXT; s++) {
-                const dfloat coeff = r_c[s];
-                invLMM += coeff * invLumpedMassMatrix[id + s * offset];
-                bdivw += coeff * BdivW[id + s * offset];
+              for (int j = 0; j < p_cubNq; ++j) {
+                dfloat Ijb = s_cubInterpT[b][j];
+                rhsU += Ijb * s_U[j][i];
               }
-            }
-            NU[id + NSOffset] = (rhsU - bdivw * S[id]) * invLMM;
+              s_Ud[b][i] = rhsU;
+          }
+        }
+        #pragma unroll
+        for (int b = 0; b < p_Nq; ++b) {
+          #pragma unroll
+          for (int a = 0; a < p_Nq; ++a) {
+              dfloat rhsU = 0;
+              #pragma unroll
+              for (int i = 0; i < p_cubNq; ++i) {
+                dfloat Iia = s_cubInterpT[a][i];
+                rhsU += Iia * s_Ud[b][i];
+              }
+              const int id = element * p_Np + c * p_Nq * p_Nq + b * p_Nq + a;
+              dfloat invLMM = p_MovingMesh ? 0.0 : invLumpedMassMatrix[id];
+              dfloat bdivw = 0.0;
+              if (p_MovingMesh) {
+                #pragma unroll
+                for (int s = 0; s < p_nEXT; s++) {
+                  const dfloat coeff = r_c[s];
+                  // time level order, invLumpedMassMatrix is not a ring buffer
+                  invLMM += extC[3 + s] * invLumpedMassMatrix[id + s * offset];
+                  bdivw += coeff * BdivW[id + s * offset];
+                }
+              }
+              NU[id + NSOffset + fld * offset] = (rhsU - bdivw * S[id + fld * offset]) * invLMM;
+          }
         }
       }
     }
@@ -24,19 +24,19 @@
 
  */
 extern "C" void ellipticPreconCoarsenHex3D(const dlong& Nelements,
-                                            const dfloat* __restrict__  R,
-                                            const dfloat* __restrict__  qf,
-                                            dfloat* __restrict__  qc)
+                                            const pfloat* __restrict__  R,
+                                            const pfloat* __restrict__  qf,
+                                            pfloat* __restrict__  qc)
 {
-  dfloat s_q[p_NqFine][p_NqFine];
-  dfloat s_Pq[p_NqCoarse][p_NqFine];
-  dfloat s_R[p_NqCoarse][p_NqFine];
-  dfloat s_RT[p_NqFine][p_NqCoarse];
-  dfloat r_q[p_NqFine][p_NqFine][p_NqCoarse];
+  pfloat s_q[p_NqFine][p_NqFine];
+  pfloat s_Pq[p_NqCoarse][p_NqFine];
+  pfloat s_R[p_NqCoarse][p_NqFine];
+  pfloat s_RT[p_NqFine][p_NqCoarse];
+  pfloat r_q[p_NqFine][p_NqFine][p_NqCoarse];
   for(int j = 0; j < p_NqCoarse; ++j){
     for(int i = 0; i < p_NqFine; ++i) {
       const int t = i + j * p_NqFine;
-      const dfloat r = R[t];
+      const pfloat r = R[t];
       s_R[j][i] = r;
       s_RT[i][j] = r;
     }
@@ -51,7 +51,7 @@ extern "C" void ellipticPreconCoarsenHex3D(const dlong& Nelements,
 
         for(int k = 0; k < p_NqFine; ++k) {
           const int id = i + j * p_NqFine + k * p_NqFine * p_NqFine + e * p_NpFine;
-          const dfloat tmp = qf[id];
+          const pfloat tmp = qf[id];
 
           #pragma unroll
           for(int m = 0; m < p_NqCoarse; ++m)
@@ -70,7 +70,7 @@ extern "C" void ellipticPreconCoarsenHex3D(const dlong& Nelements,
 
       for(int j = 0; j < p_NqCoarse; ++j){
         for(int i = 0; i < p_NqFine; ++i){
-          dfloat res = 0;
+          pfloat res = 0;
 
           #pragma unroll
           for(int m = 0; m < p_NqFine; ++m)
@@ -83,7 +83,7 @@ extern "C" void ellipticPreconCoarsenHex3D(const dlong& Nelements,
 
       for(int j = 0; j < p_NqCoarse; ++j)
         for(int i = 0; i < p_NqCoarse; ++i) {
-            dfloat res = 0;
+            pfloat res = 0;
 
             #pragma unroll
             for(int m = 0; m < p_NqFine; ++m)
@@ -25,20 +25,20 @@
  */
 
 extern "C" void ellipticPreconProlongateHex3D(const dlong& Nelements,
-                                               const dfloat* __restrict__  R,
-                                               const dfloat* __restrict__  qc,
-                                               dfloat* __restrict__  qN)
+                                               const pfloat* __restrict__  R,
+                                               const pfloat* __restrict__  qc,
+                                               pfloat* __restrict__  qN)
 {
-  dfloat r_q[p_NqCoarse][p_NqFine][p_NqFine];
+  pfloat r_q[p_NqCoarse][p_NqFine][p_NqFine];
 
-  dfloat s_q[p_NqCoarse][p_NqCoarse];
-  dfloat s_Pq[p_NqFine][p_NqCoarse];
+  pfloat s_q[p_NqCoarse][p_NqCoarse];
+  pfloat s_Pq[p_NqFine][p_NqCoarse];
 
-  dfloat s_R[p_NqCoarse][p_NqFine];
+  pfloat s_R[p_NqCoarse][p_NqFine];
   for(int j = 0; j < p_NqCoarse; ++j){
     for(int i = 0; i < p_NqFine; ++i) {
       int t = i + j * p_NqFine;
-      const dfloat r = R[t];
+      const pfloat r = R[t];
       s_R[j][i] = r;
     }
   }
@@ -56,7 +56,7 @@ extern "C" void ellipticPreconProlongateHex3D(const dlong& Nelements,
 
           for(int k = 0; k < p_NqCoarse; ++k) {
             const int id = t + k * p_NqCoarse * p_NqCoarse + e * p_NpCoarse;
-            const dfloat tmp = qc[id];
+            const pfloat tmp = qc[id];
 
             #pragma unroll
             for(int m = 0; m < p_NqFine; ++m)
@@ -86,7 +86,7 @@ extern "C" void ellipticPreconProlongateHex3D(const dlong& Nelements,
             const int ti = t % p_NqCoarse;
             const int tj = t / p_NqCoarse;
 
-            dfloat res = 0;
+            pfloat res = 0;
 
             #pragma unroll
             for(int m = 0; m < p_NqCoarse; ++m)
@@ -98,7 +98,7 @@ extern "C" void ellipticPreconProlongateHex3D(const dlong& Nelements,
 
       for(int j = 0; j < p_NqFine; ++j)
         for(int i = 0; i < p_NqFine; ++i) {
-          dfloat res = 0;
+          pfloat res = 0;
 
           #pragma unroll
           for(int m = 0; m < p_NqCoarse; ++m)
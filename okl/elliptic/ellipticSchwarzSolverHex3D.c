@@ -1,4 +1,22 @@
+// FDM operators may be stored as bfloat16 (upper half of a float), arithmetic stays in pfloat
+#if p_fdmBF16
+#include <math.h>
+#define fdmFloat unsigned short
+static inline pfloat fdmLoad(const unsigned short h)
+{
+  const int e = (h >> 7) & 0xff;
+  const pfloat m = (e > 0) ? 128 + (h & 0x7f) : 0;
+  const pfloat v = ldexp(m, e - 134);
+  return (h & 0x8000) ? -v : v;
+}
+#else
+#define fdmFloat pfloat
+#define fdmLoad(a) (a)
+#endif
+
 extern "C" void preFDM(const dlong& Nelements,
+                    const dlong& localNelements,
+                    const dlong* __restrict__  elementList,
                     const pfloat* __restrict__ u,
                     pfloat* __restrict__ work1)
 {
@@ -248,10 +266,10 @@ extern "C" void fusedFDM(
   const dlong& localNelements,
   const dlong* __restrict__  elementList,
   pfloat* __restrict__ Su,
-  const pfloat* __restrict__ S_x,
-  const pfloat* __restrict__ S_y,
-  const pfloat* __restrict__ S_z,
-  const pfloat* __restrict__ inv_L,
+  const fdmFloat* __restrict__ S_x,
+  const fdmFloat* __restrict__ S_y,
+  const fdmFloat* __restrict__ S_z,
+  const fdmFloat* __restrict__ inv_L,
 #if p_restrict
   const dfloat* __restrict__ wts,
 #endif
@@ -334,9 +352,9 @@ extern "C" void fusedFDM(
       #pragma unroll
       for (int j = 0; j < p_Nq_e; j++) {
         const int ij = j + i * p_Nq_e;
-        S_x_e[i][j] = S_x[ij + element * p_Nq_e * p_Nq_e];
-        S_y_e[i][j] = S_y[ij + element * p_Nq_e * p_Nq_e];
-        S_z_e[i][j] = S_z[ij + element * p_Nq_e * p_Nq_e];
+        S_x_e[i][j] = fdmLoad(S_x[ij + element * p_Nq_e * p_Nq_e]);
+        S_y_e[i][j] = fdmLoad(S_y[ij + element * p_Nq_e * p_Nq_e]);
+        S_z_e[i][j] = fdmLoad(S_z[ij + element * p_Nq_e * p_Nq_e]);
         S_x_eT[j][i] = S_x_e[i][j];
         S_y_eT[j][i] = S_y_e[i][j];
         S_z_eT[j][i] = S_z_e[i][j];
@@ -383,7 +401,7 @@ extern "C" void fusedFDM(
           #pragma unroll
           for (int l = 0; l < p_Nq_e; l++)
             value += S_z_e[l][k] * tmp[j][l][i];
-          work2[k][i][j] = value * inv_L[v + element * p_Nq_e * p_Nq_e * p_Nq_e];
+          work2[k][i][j] = value * fdmLoad(inv_L[v + element * p_Nq_e * p_Nq_e * p_Nq_e]);
         }
       }
     }
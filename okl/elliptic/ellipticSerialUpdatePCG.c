@@ -27,12 +27,12 @@
 extern "C"
 void ellipticUpdatePCG(const dlong & N,
                        const dlong & offset,
-                       const dfloat* __restrict__ cpu_invDegree,
-                       const dfloat* __restrict__ cpu_p,
-                       const dfloat* __restrict__ cpu_Ap,
+                       const pfloat* __restrict__ cpu_invDegree,
+                       const pfloat* __restrict__ cpu_p,
+                       const pfloat* __restrict__ cpu_Ap,
                        const dfloat & alpha,
-                       dfloat* __restrict__ cpu_x,
-                       dfloat* __restrict__ cpu_r,
+                       pfloat* __restrict__ cpu_x,
+                       pfloat* __restrict__ cpu_r,
                        dfloat* __restrict__ cpu_rdotr)
 {
   dfloat rdotr = 0;
@@ -43,7 +43,7 @@ void ellipticUpdatePCG(const dlong & N,
       const dlong n = i + fld * offset;
       cpu_x[n] += alpha * cpu_p[n];
 
-      const dfloat rn = cpu_r[n] - alpha * cpu_Ap[n];
+      const pfloat rn = cpu_r[n] - alpha * cpu_Ap[n];
       rdotr += rn * rn * cpu_invDegree[i];
       cpu_r[n] = rn;
     }
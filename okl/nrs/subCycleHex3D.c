@@ -28,14 +28,12 @@ extern "C" void subCycleStrongCubatureVolumeHex3D(const int & Nelements,
                                                   const int & NUoffset,
                                                   const dfloat * __restrict__ invLumpedMassMatrix,
                                                   const dfloat * __restrict__ BdivW,
-                                                  const dfloat & c0,
-                                                  const dfloat & c1,
-                                                  const dfloat & c2,
+                                                  const dfloat * __restrict__ extC,
                                                   const dfloat * __restrict__ conv,
                                                   const dfloat * __restrict__ Ud,
                                                   dfloat * __restrict__ NU) {
   // (phi, U.grad Ud)
-  dfloat r_c[3] = {c0, c1,c2};
+  dfloat r_c[3] = {extC[0], extC[1], extC[2]};
   dfloat s_cubD[p_cubNq][p_cubNq];
   dfloat s_cubInterpT[p_Nq][p_cubNq];
   dfloat s_cubProjectT[p_cubNq][p_Nq];
@@ -300,7 +298,8 @@ extern "C" void subCycleStrongCubatureVolumeHex3D(const int & Nelements,
               #pragma unroll
               for (int s = 0; s < p_nEXT; s++) {
                 const dfloat coeff = r_c[s];
-                invLMM += coeff * invLumpedMassMatrix[id + s * offset];
+                // time level order, invLumpedMassMatrix is not a ring buffer
+                invLMM += extC[3 + s] * invLumpedMassMatrix[id + s * offset];
                 bdivw += coeff * BdivW[id + s * offset];
               }
             }
@@ -16,10 +16,15 @@ occa::memory cdsSolve(const int is, cds_t* cds, dfloat time, int stage)
   }
   elliptic_t* solver = cds->solver[is];
 
-  platform->o_mempool.slice0.copyFrom(cds->o_S, cds->fieldOffset[is] * sizeof(dfloat), 0, cds->fieldOffsetScan[is] * sizeof(dfloat));
+  const size_t Nbytes = cds->fieldOffset[is] * sizeof(dfloat);
+  occa::memory o_Snew = platform->scratch.acquire(Nbytes);
+  occa::memory o_rhs = platform->scratch.acquire(Nbytes);
+  occa::memory o_SBC = platform->scratch.acquire(Nbytes);
+
+  o_Snew.copyFrom(cds->o_S, cds->fieldOffset[is] * sizeof(dfloat), 0, cds->fieldOffsetScan[is] * sizeof(dfloat));
 
   //enforce Dirichlet BCs
-  platform->linAlg->fill(cds->fieldOffset[is], std::numeric_limits<dfloat>::min(), platform->o_mempool.slice2); 
+  platform->linAlg->fill(cds->fieldOffset[is], std::numeric_limits<dfloat>::min(), o_SBC); 
   for (int sweep = 0; sweep < 2; sweep++) {
     cds->dirichletBCKernel(mesh->Nelements,
                            cds->fieldOffset[is],
@@ -33,16 +38,16 @@ occa::memory cdsSolve(const int is, cds_t* cds, dfloat time, int stage)
                            mesh->o_EToB,
                            cds->o_EToB[is],
                            *(cds->o_usrwrk),
-                           platform->o_mempool.slice2);
+                           o_SBC);
 
     //take care of Neumann-Dirichlet shared edges across elements
-    if(sweep == 0) oogs::startFinish(platform->o_mempool.slice2, 1, cds->fieldOffset[is], ogsDfloat, ogsMax, gsh);
-    if(sweep == 1) oogs::startFinish(platform->o_mempool.slice2, 1, cds->fieldOffset[is], ogsDfloat, ogsMin, gsh);
+    if(sweep == 0) oogs::startFinish(o_SBC, 1, cds->fieldOffset[is], ogsDfloat, ogsMax, gsh);
+    if(sweep == 1) oogs::startFinish(o_SBC, 1, cds->fieldOffset[is], ogsDfloat, ogsMin, gsh);
   }
-  if (solver->Nmasked) cds->maskCopyKernel(solver->Nmasked, 0, solver->o_maskIds, platform->o_mempool.slice2, platform->o_mempool.slice0);
+  if (solver->Nmasked) cds->maskCopyKernel(solver->Nmasked, 0, solver->o_maskIds, o_SBC, o_Snew);
 
   //build RHS
-  platform->o_mempool.slice1.copyFrom(cds->o_BF, cds->fieldOffset[is] * sizeof(dfloat), 0,  cds->fieldOffsetScan[is] * sizeof(dfloat));
+  o_rhs.copyFrom(cds->o_BF, cds->fieldOffset[is] * sizeof(dfloat), 0,  cds->fieldOffsetScan[is] * sizeof(dfloat));
   cds->helmholtzRhsBCKernel(mesh->Nelements,
                             mesh->o_sgeo,
                             mesh->o_vmapM,
@@ -53,22 +58,26 @@ occa::memory cdsSolve(const int is, cds_t* cds, dfloat time, int stage)
                             mesh->o_x,
                             mesh->o_y,
                             mesh->o_z,
-                            platform->o_mempool.slice0,
+                            o_Snew,
                             cds->o_EToB[is],
                             cds->o_mapB[is],
                             *(cds->o_usrwrk),
-                            platform->o_mempool.slice1);
+                            o_rhs);
 
   std::stringstream ss;
   ss << std::setfill('0') << std::setw(2) << is;
   string sid = ss.str();
   if(cds->options[is].compareArgs("SCALAR" + sid + " INITIAL GUESS DEFAULT", "EXTRAPOLATION") && stage == 1) {
-    platform->o_mempool.slice0.copyFrom(cds->o_Se, cds->fieldOffset[is] * sizeof(dfloat), 0, cds->fieldOffsetScan[is] * sizeof(dfloat));
-    if (solver->Nmasked) cds->maskCopyKernel(solver->Nmasked, 0, solver->o_maskIds, platform->o_mempool.slice2, platform->o_mempool.slice0);
+    o_Snew.copyFrom(cds->o_Se, cds->fieldOffset[is] * sizeof(dfloat), 0, cds->fieldOffsetScan[is] * sizeof(dfloat));
+    if (solver->Nmasked) cds->maskCopyKernel(solver->Nmasked, 0, solver->o_maskIds, o_SBC, o_Snew);
   }
-  ellipticSolve(solver, platform->o_mempool.slice1, platform->o_mempool.slice0);
+  platform->scratch.release(o_SBC);
+
+  ellipticSolve(solver, o_rhs, o_Snew);
+
+  platform->scratch.release(o_rhs);
 
-  return platform->o_mempool.slice0;
+  return o_Snew;
 }
 
 
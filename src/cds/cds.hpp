@@ -9,9 +9,18 @@
 #include "nrssys.hpp"
 #include "mesh3D.h"
 #include "elliptic.h"
+#include "launchGraph.hpp"
 
 #define NSCALAR_MAX 100
 
+// storage form of the OIFS subcycling Runge-Kutta scheme
+enum subCycleRK_t { SUBCYCLE_ERK, SUBCYCLE_LSRK_2N, SUBCYCLE_SSPRK_2S };
+
+// layout of the per-step coefficient block (o_stepCoeff), offsets in dfloat
+// the subcycling extrapolation weights follow as [torder][ststep][rk][3]
+enum stepCoeffLayout_t { STEPCOEFF_BDF = 0, STEPCOEFF_EXT = 3, STEPCOEFF_AB = 6, STEPCOEFF_DT = 9,
+                         STEPCOEFF_EXTC = 12 };
+
 struct cds_t
 {
   int dim, elementType;
@@ -49,11 +58,15 @@ struct cds_t
 
   //RK Subcycle Data
   int nRK;
+  subCycleRK_t RKform;
+  launchGraph_t subCycleGraph[NSCALAR_MAX];
   dfloat* coeffsfRK, * weightsRK, * nodesRK;
   occa::memory o_coeffsfRK, o_weightsRK;
 
   occa::memory o_relUrst;
   occa::memory o_Urst;
+  int UrstHead, NUrstLevels;
+  dlong UrstLevelOffset;
 
   //EXTBDF data
   dfloat* coeffEXT, * coeffBDF, * coeffSubEXT;
@@ -96,6 +109,7 @@ struct cds_t
 
   //EXTBDF data
   occa::memory o_coeffEXT, o_coeffBDF, o_coeffSubEXT;
+  occa::memory o_stepCoeff;
 
   occa::kernel advectionVolumeKernel;
   occa::kernel advectionSurfaceKernel;
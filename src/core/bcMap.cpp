@@ -63,6 +63,7 @@ static void v_setup(string field, std::vector<std::string> slist)
     if (key.compare("wall") == 0) key = "zerovalue";
     if (key.compare("inlet") == 0) key = "fixedvalue";
     if (key.compare("v") == 0) key = "fixedvalue";
+    if (key.compare("mv") == 0) key = "fixedvalue";
     if (key.compare("outlet") == 0) key = "zerogradient";
     if (key.compare("outflow") == 0) key = "zerogradient";
     if (key.compare("o") == 0) key = "zerogradient";
@@ -132,7 +133,7 @@ void setup(std::vector<std::string> slist, string field)
   nbid[0] = slist.size();
   if (field.compare(0, 8, "scalar00") == 0) nbid[1] = slist.size();
 
-  if (field.compare("velocity") == 0)
+  if (field.compare("velocity") == 0 || field.compare("mesh") == 0)
     v_setup(field, slist);
   else if (field.compare(0, 6, "scalar") == 0)
     s_setup(field, slist);
@@ -149,24 +150,24 @@ int type(int bid, string field)
 {
   if (bid < 1) return NOTBOUNDARY;
 
-  if (field.compare("x-velocity") == 0) {
-    const int bcID = bToBc[{"velocity", bid - 1}];
+  if (field.compare("x-velocity") == 0 || field.compare("x-mesh") == 0) {
+    const int bcID = bToBc[{field.substr(2), bid - 1}];
     if (bcID == 1) return DIRICHLET;
     if (bcID == 2) return DIRICHLET;
     if (bcID == 3) return NEUMANN;
     if (bcID == 4) return DIRICHLET;
     if (bcID == 5) return NEUMANN;
     if (bcID == 6) return NEUMANN;
-  } else if (field.compare("y-velocity") == 0) {
-    const int bcID = bToBc[{"velocity", bid - 1}];
+  } else if (field.compare("y-velocity") == 0 || field.compare("y-mesh") == 0) {
+    const int bcID = bToBc[{field.substr(2), bid - 1}];
     if (bcID == 1) return DIRICHLET;
     if (bcID == 2) return DIRICHLET;
     if (bcID == 3) return NEUMANN;
     if (bcID == 4) return NEUMANN;
     if (bcID == 5) return DIRICHLET;
     if (bcID == 6) return NEUMANN;
-  } else if (field.compare("z-velocity") == 0) {
-    const int bcID = bToBc[{"velocity", bid - 1}];
+  } else if (field.compare("z-velocity") == 0 || field.compare("z-mesh") == 0) {
+    const int bcID = bToBc[{field.substr(2), bid - 1}];
     if (bcID == 1) return DIRICHLET;
     if (bcID == 2) return DIRICHLET;
     if (bcID == 3) return NEUMANN;
@@ -198,7 +199,7 @@ string text(int bid, string field)
   if (bid < 1) return std::string();
 
   const int bcID = bToBc[{field, bid - 1}];
-  if (field.compare("velocity") == 0)
+  if (field.compare("velocity") == 0 || field.compare("mesh") == 0)
 
     return vBcIDToText[bcID];
 
@@ -36,6 +36,8 @@ dfloat computeCFL(nrs_t* nrs)
   
   if(firstTime) setup(nrs);
 
+  occa::memory o_cfl = platform->scratch.acquireFields(1);
+
   // Compute cfl factors i.e. dt* U / h
   nrs->cflKernel(mesh->Nelements,
                  nrs->dt[0],
@@ -44,7 +46,9 @@ dfloat computeCFL(nrs_t* nrs)
                  nrs->fieldOffset,
                  nrs->o_U,
                  mesh->o_U,
-                 platform->o_mempool.slice0);
+                 o_cfl);
 
-  return platform->linAlg->max(mesh->Nlocal, platform->o_mempool.slice0, platform->comm.mpiComm);
+  const dfloat cfl = platform->linAlg->max(mesh->Nlocal, o_cfl, platform->comm.mpiComm);
+  platform->scratch.release(o_cfl);
+  return cfl;
 }
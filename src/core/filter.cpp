@@ -2,6 +2,8 @@
 
 void filterFunctionRelaxation1D(int Nmodes, int Nc, dfloat* A);
 
+void filterNodal1D(int N, dfloat* r, dfloat* A);
+
 void filterVandermonde1D(int N, int Np, dfloat* r, dfloat* V);
 
 dfloat filterSimplex3D(dfloat a, dfloat b, dfloat c, int i, int j, int k);
@@ -23,16 +25,52 @@ void filterSetup(nrs_t* nrs)
   // Construct Filter Function
   int Nmodes = mesh->N + 1; // N+1, 1D GLL points
 
-  // Vandermonde matrix
-  dfloat* V = (dfloat*) calloc(Nmodes * Nmodes, sizeof(dfloat));
   // Filter matrix, diagonal
   dfloat* A = (dfloat*) calloc(Nmodes * Nmodes, sizeof(dfloat));
 
   // Construct Filter Function
   filterFunctionRelaxation1D(Nmodes, nrs->filterNc, A);
 
+  // Transform to nodal space
+  filterNodal1D(mesh->N, mesh->r, A);
+
+  // store filter matrix (row major)
+  nrs->filterM = (dfloat*) calloc(Nmodes * Nmodes, sizeof(dfloat));
+  for(int c = 0; c < Nmodes; c++)
+    for(int r = 0; r < Nmodes; r++)
+      nrs->filterM[c + r * Nmodes] = A[r + c * Nmodes];
+
+  nrs->o_filterMT =  platform->device.malloc(Nmodes * Nmodes * sizeof(dfloat), A); // copy Tranpose
+
+  if(platform->comm.mpiRank == 0)
+    printf("High pass filter relaxation: chi = %.4f using %d mode(s)\n",
+           fabs(nrs->filterS), nrs->filterNc);
+
+  free(A);
+}
+
+dfloat* filterModalTruncation(mesh_t* mesh, int Nmodes)
+{
+  const int Nq = mesh->N + 1;
+  dfloat* A = (dfloat*) calloc(Nq * Nq, sizeof(dfloat));
+
+  // keep the first Nmodes Legendre modes, drop the rest
+  for(int n = 0; n < Nmodes; n++)
+    A[n * Nq + n] = 1.0;
+
+  filterNodal1D(mesh->N, mesh->r, A);
+  return A;
+}
+
+// V*A*V^-1 where A is diagonal in modal space, result in column major
+void filterNodal1D(int Nfilter, dfloat* r, dfloat* A)
+{
+  const int Nmodes = Nfilter + 1;
+
+  // Vandermonde matrix
+  dfloat* V = (dfloat*) calloc(Nmodes * Nmodes, sizeof(dfloat));
   // Construct Vandermonde Matrix
-  filterVandermonde1D(mesh->N, Nmodes, mesh->r, V);
+  filterVandermonde1D(Nfilter, Nmodes, r, V);
 
   // Invert the Vandermonde
   int INFO;
@@ -73,19 +111,6 @@ void filterSetup(nrs_t* nrs)
   TRANSB = 'N';
   dgemm_(&TRANSA, &TRANSB, &MD, &ND, &KD, &ALPHA, V, &LDA, C, &LDB, &BETA, A, &LDC);
 
-  // store filter matrix (row major)
-  nrs->filterM = (dfloat*) calloc(Nmodes * Nmodes, sizeof(dfloat));
-  for(int c = 0; c < Nmodes; c++)
-    for(int r = 0; r < Nmodes; r++)
-      nrs->filterM[c + r * Nmodes] = A[r + c * Nmodes];
-
-  nrs->o_filterMT =  platform->device.malloc(Nmodes * Nmodes * sizeof(dfloat), A); // copy Tranpose
-
-  if(platform->comm.mpiRank == 0)
-    printf("High pass filter relaxation: chi = %.4f using %d mode(s)\n",
-           fabs(nrs->filterS), nrs->filterNc);
-
-  free(A);
   free(C);
   free(V);
   free(iV);
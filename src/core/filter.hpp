@@ -3,5 +3,6 @@
 
 #include "nrs.hpp"
 void filterSetup(nrs_t* nrs);
+dfloat* filterModalTruncation(mesh_t* mesh, int Nmodes);
 
 #endif
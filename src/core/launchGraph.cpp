@@ -0,0 +1,64 @@
+#include "launchGraph.hpp"
+
+void launchGraph_t::enable(bool on)
+{
+  isEnabled = on;
+  if(!isEnabled) clear();
+}
+
+void launchGraph_t::clear()
+{
+  recordings.clear();
+  active = nullptr;
+}
+
+bool launchGraph_t::replay(const std::string& key)
+{
+  if(!isEnabled) return false;
+  auto entry = recordings.find(key);
+  if(entry == recordings.end()) return false;
+
+  // OCCA does not expose native command graphs, replay the flat launch list
+  for(auto& node : entry->second)
+    run(node);
+
+  return true;
+}
+
+void launchGraph_t::beginCapture(const std::string& key)
+{
+  if(!isEnabled) return;
+  // a varying dt gives a new key every step, don't let stale recordings pile up
+  if(recordings.size() >= maxRecordings) clear();
+  active = &recordings[key];
+  active->clear();
+  capturing = true;
+}
+
+void launchGraph_t::endCapture()
+{
+  if(!capturing) return;
+  capturing = false;
+  active = nullptr;
+}
+
+void launchGraph_t::host(const std::function<void()>& f)
+{
+  f();
+  if(!capturing) return;
+  node_t node;
+  node.hostFn = f;
+  active->push_back(node);
+}
+
+void launchGraph_t::run(node_t& node)
+{
+  if(node.hostFn) {
+    node.hostFn();
+    return;
+  }
+  node.kernel.clearArgs();
+  for(auto& arg : node.args)
+    node.kernel.pushArg(arg);
+  node.kernel.run();
+}
@@ -0,0 +1,99 @@
+#if !defined(nekrs_launchgraph_hpp_)
+#define nekrs_launchgraph_hpp_
+
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "nrssys.hpp"
+
+// Records a sequence of kernel launches and host callbacks (gather-scatter,
+// linAlg, copies) once and replays it as a flat launch list, i.e. without
+// re-walking the host control flow and option lookups in between.
+// A recording is only valid for the key it was captured with, so the key has
+// to contain every host value which ends up in a kernel argument. A few
+// recordings are kept side by side, e.g. one per ring buffer slot.
+class launchGraph_t
+{
+public:
+  void enable(bool on);
+  bool enabled() const { return isEnabled; }
+
+  template<typename... Args>
+  static std::string key(const Args&... args)
+  {
+    std::string k;
+    int dummy[] = {0, (append(k, args), 0)...};
+    (void) dummy;
+    return k;
+  }
+
+  // runs the recorded sequence, returns false if nothing was recorded for key
+  bool replay(const std::string& key);
+
+  void beginCapture(const std::string& key);
+  void endCapture();
+  void clear();
+
+  // launches immediately and records the launch while capturing
+  template<typename... Args>
+  void operator()(occa::kernel& kernel, const Args&... args)
+  {
+    if(!capturing) {
+      kernel(args...);
+      return;
+    }
+    node_t node;
+    node.kernel = kernel;
+    int dummy[] = {0, (bind(node, args), 0)...};
+    (void) dummy;
+    run(node);
+    active->push_back(node);
+  }
+
+  // runs f immediately and records it while capturing, f must not refer to
+  // stack variables of the capturing scope
+  void host(const std::function<void()>& f);
+
+private:
+  struct node_t {
+    occa::kernel kernel;
+    std::vector<occa::kernelArg> args;
+    std::vector<occa::memory> buffers; // keeps bound (sliced) memory alive
+    std::function<void()> hostFn;
+  };
+
+  static void bind(node_t& node, const occa::memory& o_buf)
+  {
+    node.buffers.push_back(o_buf);
+    node.args.push_back(o_buf);
+  }
+  template<typename T>
+  static void bind(node_t& node, const T& val)
+  {
+    node.args.push_back(occa::kernelArg(val));
+  }
+
+  static void append(std::string& k, const occa::memory& o_buf)
+  {
+    const void* ptr = o_buf.isInitialized() ? o_buf.ptr() : nullptr;
+    k.append((const char*) &ptr, sizeof(ptr));
+  }
+  template<typename T>
+  static void append(std::string& k, const T& val)
+  {
+    k.append((const char*) &val, sizeof(T));
+  }
+
+  void run(node_t& node);
+
+  static constexpr size_t maxRecordings = 8;
+
+  bool isEnabled = false;
+  bool capturing = false;
+  std::map<std::string, std::vector<node_t>> recordings;
+  std::vector<node_t>* active = nullptr;
+};
+
+#endif
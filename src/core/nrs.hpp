@@ -30,6 +30,11 @@ struct nrs_t
   elliptic_t* wSolver;
   elliptic_t* uvwSolver;
   elliptic_t* pSolver;
+  elliptic_t* meshSolver;
+
+  // elasticity mesh solver nodes following the fluid velocity
+  dlong NmeshFluidIds;
+  occa::memory o_meshFluidIds;
 
   cds_t* cds;
 
@@ -41,7 +46,7 @@ struct nrs_t
 
   int Nscalar;
   dlong fieldOffset;
-  setupAide vOptions, pOptions;
+  setupAide vOptions, pOptions, mOptions;
 
   inipp::Ini<char> *par;
 
@@ -67,6 +72,10 @@ struct nrs_t
 
   //RK Subcycle Data
   int nRK;
+  subCycleRK_t RKform;
+  launchGraph_t subCycleGraph;
+  // step sections between the time dependent BCs and the elliptic solves
+  launchGraph_t makefGraph, pressureRhsGraph, velocityRhsGraph;
   dfloat* coeffsfRK, * weightsRK, * nodesRK;
   occa::memory o_coeffsfRK, o_weightsRK;
 
@@ -99,12 +108,12 @@ struct nrs_t
   dfloat* filterM, filterS;
   occa::memory o_filterMT; // transpose of filter matrix
   occa::kernel filterRTKernel; // Relaxation-Term based filtering
+  occa::kernel filterKernel;
   occa::kernel advectMeshVelocityKernel;
 
   occa::kernel pressureAddQtlKernel;
   occa::kernel pressureStressKernel;
 
-  occa::kernel mueDivKernel;
 
   occa::kernel subCycleVolumeKernel,  subCycleCubatureVolumeKernel;
   occa::kernel subCycleSurfaceKernel, subCycleCubatureSurfaceKernel;
@@ -114,7 +123,6 @@ struct nrs_t
   occa::kernel subCycleInitU0Kernel;
   occa::kernel nStagesSum3Kernel;
 
-  occa::kernel wgradientVolumeKernel;
 
   occa::kernel subCycleStrongCubatureVolumeKernel;
   occa::kernel subCycleStrongVolumeKernel;
@@ -123,6 +131,9 @@ struct nrs_t
 
   occa::memory o_relUrst;
   occa::memory o_Urst;
+  // o_Urst time levels form a ring buffer, level s is stored in slot (UrstHead + s) % NUrstLevels
+  int UrstHead, NUrstLevels;
+  dlong UrstLevelOffset;
   occa::kernel UrstCubatureKernel;
   occa::kernel UrstKernel;
 
@@ -136,6 +147,11 @@ struct nrs_t
   //EXTBDF data
   occa::memory o_coeffEXT, o_coeffBDF, o_coeffSubEXT;
 
+  // all per-step scalar coefficients, uploaded once per step
+  dlong NstepCoeff;
+  dfloat* stepCoeff;
+  occa::memory o_stepCoeff;
+
   occa::kernel advectionVolumeKernel;
   occa::kernel advectionCubatureVolumeKernel;
 
@@ -149,12 +165,13 @@ struct nrs_t
   occa::kernel divergenceSurfaceKernel;
 
   occa::kernel divergenceStrongVolumeKernel;
-  occa::kernel sumMakefKernel;
+  occa::kernel makefKernel;
   occa::kernel pressureRhsKernel;
   occa::kernel pressureDirichletBCKernel;
   occa::kernel pressureUpdateKernel;
 
   occa::kernel velocityRhsKernel;
+  occa::kernel velocityRhsDivKernel;
   occa::kernel velocityNeumannBCKernel;
   occa::kernel velocityDirichletBCKernel;
 
@@ -169,6 +186,7 @@ struct nrs_t
 
   int* EToB;
   occa::memory o_EToB;
+  int velocityNeumannBC;
 
   occa::properties* kernelInfo;
 };
@@ -33,6 +33,7 @@ void setDefaultSettings(setupAide &options, string casename, int rank)
   options.setArgs("SUBCYCLING STEPS", "0");
   options.setArgs("SUBCYCLING TIME ORDER", "4");
   options.setArgs("SUBCYCLING TIME STAGE NUMBER", "4");
+  options.setArgs("SUBCYCLING TIME INTEGRATOR", "ERK44");
 
   options.setArgs("CASENAME", casename);
   options.setArgs("UDF OKL FILE", casename + ".oudf");
@@ -47,8 +48,12 @@ void setDefaultSettings(setupAide &options, string casename, int rank)
   options.setArgs("ADVECTION TYPE", "CUBATURE+CONVECTIVE");
 
   options.setArgs("RESTART FROM FILE", "0");
+  options.setArgs("HOST MIRRORS", "PERSISTENT");
+  options.setArgs("LAUNCH GRAPH", "FALSE");
   options.setArgs("SOLUTION OUTPUT INTERVAL", "0");
   options.setArgs("SOLUTION OUTPUT CONTROL", "STEPS");
+  options.setArgs("SOLUTION OUTPUT COORDINATES", "ALWAYS");
+  options.setArgs("SOLUTION OUTPUT MODES", "0");
   options.setArgs("FILTER STABILIZATION", "NONE");
 
   options.setArgs("START TIME", "0.0");
@@ -58,6 +63,8 @@ void setDefaultSettings(setupAide &options, string casename, int rank)
   options.setArgs("VELOCITY BASIS", "NODAL");
   options.setArgs("VELOCITY PRECONDITIONER", "JACOBI");
   options.setArgs("VELOCITY DISCRETIZATION", "CONTINUOUS");
+  options.setArgs("VELOCITY CHEBYSHEV DEGREE", "8");
+  options.setArgs("VELOCITY CHEBYSHEV RESIDUAL CHECK", "TRUE");
 
   options.setArgs("STRESSFORMULATION", "FALSE");
 
@@ -161,6 +168,44 @@ setupAide parRead(void *ppar, std::string setupFile, MPI_Comm comm)
     options.setArgs("RESTART FILE NAME", startFrom);
   }
 
+  string restartReader;
+  if (par->extract("general", "restartreader", restartReader)) {
+    UPPER(restartReader);
+    if(restartReader != "NATIVE" && restartReader != "NEK")
+      exit("Invalid GENERAL::restartReader!", EXIT_FAILURE);
+    options.setArgs("RESTART READER", restartReader);
+  }
+
+  // full-state checkpoints are always read by nekRS
+  const string chkpExt = ".chkp";
+  if(startFrom.size() > chkpExt.size() &&
+     startFrom.compare(startFrom.size() - chkpExt.size(), chkpExt.size(), chkpExt) == 0)
+    options.setArgs("RESTART READER", "CHECKPOINT");
+
+  string runTimeStatFile;
+  if(par->extract("general", "runtimestatfile", runTimeStatFile))
+    options.setArgs("RUNTIME STATISTICS FILE", runTimeStatFile);
+
+  int checkpointInterval;
+  if(par->extract("general", "checkpointinterval", checkpointInterval))
+    options.setArgs("CHECKPOINT INTERVAL", std::to_string(checkpointInterval));
+
+  bool checkpointProjection;
+  if(par->extract("general", "checkpointprojection", checkpointProjection))
+    if(checkpointProjection) options.setArgs("CHECKPOINT PROJECTION", "TRUE");
+
+  string hostMirrors;
+  if(par->extract("general", "hostmirrors", hostMirrors)) {
+    UPPER(hostMirrors);
+    if(hostMirrors != "PERSISTENT" && hostMirrors != "LAZY")
+      exit("Invalid GENERAL::hostMirrors!", EXIT_FAILURE);
+    options.setArgs("HOST MIRRORS", hostMirrors);
+  }
+
+  bool launchGraph;
+  if(par->extract("general", "launchgraph", launchGraph))
+    if(launchGraph) options.setArgs("LAUNCH GRAPH", "TRUE");
+
   int N;
   if(par->extract("general", "polynomialorder", N)) {
     options.setArgs("POLYNOMIAL DEGREE", std::to_string(N));
@@ -223,8 +268,33 @@ setupAide parRead(void *ppar, std::string setupFile, MPI_Comm comm)
     double targetCFL;
     int NSubCycles = 0;
 
+    // stable CFL per substep of the supported schemes
+    double subCycleCFL = 2.0;
+    string subCycleScheme;
+    if(par->extract("general", "subcyclingscheme", subCycleScheme)) {
+      if(subCycleScheme == "erk44") {
+        options.setArgs("SUBCYCLING TIME ORDER", "4");
+        options.setArgs("SUBCYCLING TIME STAGE NUMBER", "4");
+      } else if(subCycleScheme == "lsrk54") {
+        options.setArgs("SUBCYCLING TIME ORDER", "4");
+        options.setArgs("SUBCYCLING TIME STAGE NUMBER", "5");
+        subCycleCFL = 2.35;
+      } else if(subCycleScheme == "ssprk33") {
+        options.setArgs("SUBCYCLING TIME ORDER", "3");
+        options.setArgs("SUBCYCLING TIME STAGE NUMBER", "3");
+        subCycleCFL = 1.2;
+      } else if(subCycleScheme == "ssprk43") {
+        options.setArgs("SUBCYCLING TIME ORDER", "3");
+        options.setArgs("SUBCYCLING TIME STAGE NUMBER", "4");
+      } else {
+        exit("Unknown GENERAL::subCyclingScheme!", EXIT_FAILURE);
+      }
+      UPPER(subCycleScheme);
+      options.setArgs("SUBCYCLING TIME INTEGRATOR", subCycleScheme);
+    }
+
     if(par->extract("general", "targetcfl", targetCFL))
-      NSubCycles = round(targetCFL / 2);
+      NSubCycles = round(targetCFL / subCycleCFL);
     if(par->extract("general", "subcyclingsteps", NSubCycles));
     if(!NSubCycles) NSubCycles = 1;
     options.setArgs("SUBCYCLING STEPS", std::to_string(NSubCycles));
@@ -245,6 +315,22 @@ setupAide parRead(void *ppar, std::string setupFile, MPI_Comm comm)
       options.setArgs("SOLUTION OUTPUT CONTROL", "RUNTIME");
   }
 
+  string writeCoordinates;
+  if(par->extract("general", "writecoordinates", writeCoordinates)) {
+    if(writeCoordinates == "once")
+      options.setArgs("SOLUTION OUTPUT COORDINATES", "ONCE");
+    else if(writeCoordinates != "always")
+      exit("Invalid value for GENERAL::writeCoordinates!", EXIT_FAILURE);
+  }
+
+  int writeModes;
+  if(par->extract("general", "writemodes", writeModes)) {
+    if(writeModes < 2 || writeModes > N + 1)
+      exit("GENERAL::writeModes has to be in [2, polynomialOrder + 1]!", EXIT_FAILURE);
+    if(writeModes < N + 1)
+      options.setArgs("SOLUTION OUTPUT MODES", std::to_string(writeModes));
+  }
+
   bool dealiasing;
   if(par->extract("general", "dealiasing", dealiasing))
     if(dealiasing)
@@ -285,8 +371,70 @@ setupAide parRead(void *ppar, std::string setupFile, MPI_Comm comm)
     options.setArgs("MOVING MESH", "TRUE");
     if(meshSolver == "user") options.setArgs("MESH SOLVER", "USER");
     if(meshSolver == "none") options.setArgs("MOVING MESH", "FALSE"); 
+    if(meshSolver == "elasticity") {
+      options.setArgs("MESH SOLVER", "ELASTICITY");
+      options.setArgs("MESH KRYLOV SOLVER", "PCG");
+      options.setArgs("MESH PRECONDITIONER", "JACOBI");
+      options.setArgs("MESH SOLVER TOLERANCE", to_string_f(1e-6));
+      options.setArgs("MESH RESIDUAL PROJECTION", "TRUE");
+      options.setArgs("MESH RESIDUAL PROJECTION VECTORS", "8");
+      options.setArgs("MESH RESIDUAL PROJECTION START", "5");
+
+      double m_residualTol;
+      if(par->extract("mesh", "residualtol", m_residualTol) ||
+         par->extract("mesh", "residualtoltolerance", m_residualTol))
+        options.setArgs("MESH SOLVER TOLERANCE", to_string_f(m_residualTol));
+
+      bool m_rproj;
+      if(par->extract("mesh", "residualproj", m_rproj) ||
+         par->extract("mesh", "residualprojection", m_rproj)) {
+        if(m_rproj)
+          options.setArgs("MESH RESIDUAL PROJECTION", "TRUE");
+        else
+          options.setArgs("MESH RESIDUAL PROJECTION", "FALSE");
+
+        int m_nProjVec;
+        if(par->extract("mesh", "residualprojectionvectors", m_nProjVec))
+          options.setArgs("MESH RESIDUAL PROJECTION VECTORS", std::to_string(m_nProjVec));
+        int m_nProjStep;
+        if(par->extract("mesh", "residualprojectionstart", m_nProjStep))
+          options.setArgs("MESH RESIDUAL PROJECTION START", std::to_string(m_nProjStep));
+      }
+
+      // zeroValue: fixed, fixedValue/mv: moves with the fluid, zeroGradient: free, sym: slides
+      string m_bcMap;
+      if(par->extract("mesh", "boundarytypemap", m_bcMap)) {
+        std::vector<std::string> sList;
+        sList = serializeString(m_bcMap);
+        bcMap::setup(sList, "mesh");
+      } else {
+        exit("Cannot find mandatory parameter MESH::boundaryTypeMap!", EXIT_FAILURE);
+      }
+    }
   }
 
+  // PROBES
+  string probesFile;
+  if(par->extract("probes", "file", probesFile))
+    options.setArgs("PROBES FILE", probesFile);
+  int probesInterval;
+  if(par->extract("probes", "interval", probesInterval))
+    options.setArgs("PROBES INTERVAL", std::to_string(probesInterval));
+  int probesBufferSize;
+  if(par->extract("probes", "buffersize", probesBufferSize))
+    options.setArgs("PROBES BUFFER SIZE", std::to_string(probesBufferSize));
+
+  // PARTICLES
+  string particlesFile;
+  if(par->extract("particles", "file", particlesFile))
+    options.setArgs("PARTICLES FILE", particlesFile);
+  int particlesWriteInterval;
+  if(par->extract("particles", "writeinterval", particlesWriteInterval))
+    options.setArgs("PARTICLES WRITE INTERVAL", std::to_string(particlesWriteInterval));
+  int particlesRKOrder;
+  if(par->extract("particles", "rkorder", particlesRKOrder))
+    options.setArgs("PARTICLES RK ORDER", std::to_string(particlesRKOrder));
+
   bool stressFormulation;
   if(par->extract("problemtype", "stressformulation", stressFormulation))
     if(stressFormulation) options.setArgs("STRESSFORMULATION", "TRUE");
@@ -299,7 +447,15 @@ setupAide parRead(void *ppar, std::string setupFile, MPI_Comm comm)
 
   int bcInPar = 1;
   if(par->sections.count("velocity")) {
+    bool v_write;
+    if(par->extract("velocity", "writetofieldfile", v_write) && !v_write)
+      options.setArgs("VELOCITY WRITE TO FIELD FILE", "FALSE");
+
     // PRESSURE
+    bool p_write;
+    if(par->extract("pressure", "writetofieldfile", p_write) && !p_write)
+      options.setArgs("PRESSURE WRITE TO FIELD FILE", "FALSE");
+
     double p_residualTol;
     if(par->extract("pressure", "residualtol", p_residualTol) ||
        par->extract("pressure", "residualtoltolerance", p_residualTol))
@@ -323,6 +479,10 @@ setupAide parRead(void *ppar, std::string setupFile, MPI_Comm comm)
         options.setArgs("PRESSURE RESIDUAL PROJECTION START", std::to_string(p_nProjStep));
     }
 
+    bool p_mixed;
+    if(par->extract("pressure", "mixedprecision", p_mixed))
+      if(p_mixed) options.setArgs("PRESSURE MIXED PRECISION", "TRUE");
+
     bool p_gproj;
     if(par->extract("pressure", "galerkincoarseoperator", p_gproj))
       if(p_gproj) options.setArgs("GALERKIN COARSE OPERATOR", "TRUE");
@@ -345,6 +505,26 @@ setupAide parRead(void *ppar, std::string setupFile, MPI_Comm comm)
     if(par->extract("pressure", "pmultigridcoarsening", p_mglevels))
       options.setArgs("PRESSURE MULTIGRID COARSENING", p_mglevels);
 
+    // moving mesh: full smoother and coarse grid refresh every n steps,
+    // Schwarz operators are rebuilt for elements that changed by more than tol
+    int p_refreshInterval;
+    if(par->extract("pressure", "preconditionerrefreshinterval", p_refreshInterval))
+      options.setArgs("PRESSURE MULTIGRID REFRESH INTERVAL", std::to_string(p_refreshInterval));
+    double p_refreshTol;
+    if(par->extract("pressure", "preconditionerrefreshtol", p_refreshTol))
+      options.setArgs("PRESSURE MULTIGRID REFRESH TOLERANCE", to_string_f(p_refreshTol));
+
+    // storage of the Schwarz FDM operators, arithmetic is unaffected
+    string p_schwarzStorage;
+    if(par->extract("pressure", "schwarzstorage", p_schwarzStorage)) {
+      if(p_schwarzStorage == "bf16")
+        options.setArgs("PRESSURE MULTIGRID SCHWARZ STORAGE", "BF16");
+      else if(p_schwarzStorage == "fp32")
+        options.setArgs("PRESSURE MULTIGRID SCHWARZ STORAGE", "FP32");
+      else
+        exit("Invalid PRESSURE::schwarzStorage, use fp32 or bf16!", EXIT_FAILURE);
+    }
+
     string p_smoother;
     if(par->extract("pressure", "smoothertype", p_smoother)) {
       if(p_smoother == "asm") {
@@ -500,8 +680,24 @@ setupAide parRead(void *ppar, std::string setupFile, MPI_Comm comm)
       if(std::strstr(vsolver.c_str(), "block")) {
         options.setArgs("VELOCITY BLOCK SOLVER", "TRUE");
       }
+      if(std::strstr(vsolver.c_str(), "chebyshev")) {
+        options.setArgs("VELOCITY KRYLOV SOLVER", "CHEBYSHEV");
+        if(std::strstr(vsolver.c_str(), "+") && !std::strstr(vsolver.c_str(), "jacobi"))
+          exit("Chebyshev solver for VELOCITY requires jacobi preconditioning!", EXIT_FAILURE);
+      }
     }
 
+    int v_chebyDegree;
+    if(par->extract("velocity", "chebyshevdegree", v_chebyDegree))
+      options.setArgs("VELOCITY CHEBYSHEV DEGREE", std::to_string(v_chebyDegree));
+    bool v_chebyResCheck;
+    if(par->extract("velocity", "chebyshevresidualcheck", v_chebyResCheck))
+      options.setArgs("VELOCITY CHEBYSHEV RESIDUAL CHECK", v_chebyResCheck ? "TRUE" : "FALSE");
+
+    bool v_mixed;
+    if(par->extract("velocity", "mixedprecision", v_mixed))
+      if(v_mixed) options.setArgs("VELOCITY MIXED PRECISION", "TRUE");
+
     double v_residualTol;
     if(par->extract("velocity", "residualtol", v_residualTol) ||
        par->extract("velocity", "residualtoltolerance", v_residualTol))
@@ -543,6 +739,10 @@ setupAide parRead(void *ppar, std::string setupFile, MPI_Comm comm)
 
     options.setArgs("SCALAR00 IS TEMPERATURE", "TRUE");
 
+    bool t_write;
+    if(par->extract("temperature", "writetofieldfile", t_write) && !t_write)
+      options.setArgs("SCALAR00 WRITE TO FIELD FILE", "FALSE");
+
     string solver;
     par->extract("temperature", "solver", solver);
     if(solver == "none") {
@@ -550,6 +750,17 @@ setupAide parRead(void *ppar, std::string setupFile, MPI_Comm comm)
     } else {
       options.setArgs("SCALAR00 INITIAL GUESS DEFAULT", "EXTRAPOLATION");
       options.setArgs("SCALAR00 PRECONDITIONER", "JACOBI");
+      if(std::strstr(solver.c_str(), "chebyshev")) {
+        options.setArgs("SCALAR00 KRYLOV SOLVER", "CHEBYSHEV");
+        if(std::strstr(solver.c_str(), "+") && !std::strstr(solver.c_str(), "jacobi"))
+          exit("Chebyshev solver for TEMPERATURE requires jacobi preconditioning!", EXIT_FAILURE);
+      }
+      int t_chebyDegree;
+      if(par->extract("temperature", "chebyshevdegree", t_chebyDegree))
+        options.setArgs("SCALAR00 CHEBYSHEV DEGREE", std::to_string(t_chebyDegree));
+      bool t_chebyResCheck;
+      if(par->extract("temperature", "chebyshevresidualcheck", t_chebyResCheck))
+        options.setArgs("SCALAR00 CHEBYSHEV RESIDUAL CHECK", t_chebyResCheck ? "TRUE" : "FALSE");
       bool t_rproj;
       if(par->extract("temperature", "residualproj", t_rproj) || 
          par->extract("temperature", "residualprojection", t_rproj)) {
@@ -620,6 +831,10 @@ setupAide parRead(void *ppar, std::string setupFile, MPI_Comm comm)
       sidPar = ss.str();
     }
 
+    bool s_write;
+    if(par->extract("scalar" + sidPar, "writetofieldfile", s_write) && !s_write)
+      options.setArgs("SCALAR" + sid + " WRITE TO FIELD FILE", "FALSE");
+
     string solver;
     par->extract("scalar" + sidPar, "solver", solver);
     if(solver == "none") {
@@ -648,6 +863,17 @@ setupAide parRead(void *ppar, std::string setupFile, MPI_Comm comm)
         options.setArgs("SCALAR" + sid + " RESIDUAL PROJECTION START", std::to_string(t_nProjStep));
     }
     options.setArgs("SCALAR" + sid + " PRECONDITIONER", "JACOBI");
+    if(std::strstr(solver.c_str(), "chebyshev")) {
+      options.setArgs("SCALAR" + sid + " KRYLOV SOLVER", "CHEBYSHEV");
+      if(std::strstr(solver.c_str(), "+") && !std::strstr(solver.c_str(), "jacobi"))
+        exit("Chebyshev solver for SCALAR" + sidPar + " requires jacobi preconditioning!", EXIT_FAILURE);
+    }
+    int s_chebyDegree;
+    if(par->extract("scalar" + sidPar, "chebyshevdegree", s_chebyDegree))
+      options.setArgs("SCALAR" + sid + " CHEBYSHEV DEGREE", std::to_string(s_chebyDegree));
+    bool s_chebyResCheck;
+    if(par->extract("scalar" + sidPar, "chebyshevresidualcheck", s_chebyResCheck))
+      options.setArgs("SCALAR" + sid + " CHEBYSHEV RESIDUAL CHECK", s_chebyResCheck ? "TRUE" : "FALSE");
 
     double s_residualTol;
     if(par->extract("scalar" + sidPar, "residualtol", s_residualTol) ||
@@ -1,4 +1,7 @@
 #include <cstdlib>
+#include <limits>
+#include <algorithm>
+#include <sys/resource.h>
 #include "platform.hpp"
 #include "nrs.hpp"
 #include "linAlg.hpp"
@@ -71,28 +74,128 @@ void memPool_t::allocate(const dlong offset, const dlong fields)
   slice18 = ptr + 18 * offset;
   slice19 = ptr + 19 * offset;
 }
-void deviceMemPool_t::allocate(memPool_t& hostMemory, const dlong offset, const dlong fields)
-{
-  o_ptr = platform->device.malloc(offset*fields*sizeof(dfloat), hostMemory.slice0);
-  slice0 = o_ptr.slice(0 * offset * sizeof(dfloat));
-  slice1 = o_ptr.slice(1 * offset * sizeof(dfloat));
-  slice2 = o_ptr.slice(2 * offset * sizeof(dfloat));
-  slice3 = o_ptr.slice(3 * offset * sizeof(dfloat));
-  slice4 = o_ptr.slice(4 * offset * sizeof(dfloat));
-  slice5 = o_ptr.slice(5 * offset * sizeof(dfloat));
-  slice6 = o_ptr.slice(6 * offset * sizeof(dfloat));
-  slice7 = o_ptr.slice(7 * offset * sizeof(dfloat));
-  slice9 = o_ptr.slice(9 * offset * sizeof(dfloat));
-  slice12 = o_ptr.slice(12 * offset * sizeof(dfloat));
-  slice15 = o_ptr.slice(15 * offset * sizeof(dfloat));
-  slice18 = o_ptr.slice(18 * offset * sizeof(dfloat));
-  slice19 = o_ptr.slice(19 * offset * sizeof(dfloat));
+void scratchArena_t::setup(const dlong _fieldOffset, const int Nfields)
+{
+  fieldOffset = _fieldOffset;
+  const char* env_val = std::getenv("NEKRS_SCRATCH_POISON");
+  if(env_val != NULL) poison = std::stoi(env_val);
+  blocks.push_back(platform->device.malloc(Nfields * fieldOffset * sizeof(dfloat)));
+}
+occa::memory scratchArena_t::acquire(const size_t Nbytes)
+{
+  const size_t align = 256;
+  const size_t size = std::max(align, ((Nbytes + align - 1) / align) * align);
+
+  size_t block = 0;
+  size_t offset = 0;
+  if(!stack.empty()) {
+    block = stack.back().block;
+    offset = stack.back().offset + stack.back().size;
+  }
+  // move on to the next block if the current one is full, buffers in use stay in place
+  while(block < blocks.size() && offset + size > blocks[block].size()) {
+    block++;
+    offset = 0;
+  }
+  if(block == blocks.size())
+    blocks.push_back(platform->device.malloc(std::max(size, blocks.back().size())));
+
+  occa::memory o_buf = blocks[block].slice(offset, size);
+  stack.push_back({block, offset, size, o_buf.ptr()});
+  inUse += size;
+  highWater = std::max(highWater, inUse);
+  return o_buf;
+}
+occa::memory scratchArena_t::acquireFields(const int Nfields)
+{
+  return acquire(Nfields * fieldOffset * sizeof(dfloat));
+}
+void scratchArena_t::release(occa::memory& o_buf)
+{
+  if(stack.empty() || stack.back().ptr != o_buf.ptr()) {
+    if(platform->comm.mpiRank == 0)
+      printf("ERROR: scratch buffers have to be released in reverse order of acquisition!\n");
+    ABORT(EXIT_FAILURE);
+  }
+
+  const entry_t entry = stack.back();
+  if(poison)
+    platform->linAlg->fill(entry.size / sizeof(dfloat), std::numeric_limits<dfloat>::quiet_NaN(), o_buf);
+  stack.pop_back();
+  inUse -= entry.size;
+
+  if(stack.empty() && blocks.size() > 1) {
+    for(auto& o_block : blocks) o_block.free();
+    blocks.clear();
+    blocks.push_back(platform->device.malloc(highWater));
+  }
+}
+size_t scratchArena_t::capacity() const
+{
+  size_t Nbytes = 0;
+  for(auto& o_block : blocks) Nbytes += o_block.size();
+  return Nbytes;
+}
+void memoryReport_t::add(const std::string& subsystem)
+{
+  if(std::find(subsystems.begin(), subsystems.end(), subsystem) == subsystems.end())
+    subsystems.push_back(subsystem);
+}
+void memoryReport_t::account(const std::string& subsystem)
+{
+  const size_t allocated = platform->device.memoryAllocated();
+  add(subsystem);
+  if(allocated > accounted) device[subsystem] += allocated - accounted;
+  accounted = allocated;
+}
+void memoryReport_t::addHost(const std::string& subsystem, const size_t Nbytes)
+{
+  add(subsystem);
+  host[subsystem] += Nbytes;
+}
+void memoryReport_t::print(MPI_Comm comm)
+{
+  account("other");
+
+  // per subsystem device/host bytes, followed by the totals and the scratch arena
+  const int Nsub = subsystems.size();
+  std::vector<double> usage(2 * (Nsub + 2), 0.0);
+  for(int i = 0; i < Nsub; i++) {
+    usage[2 * i + 0] = device[subsystems[i]];
+    usage[2 * i + 1] = host[subsystems[i]];
+  }
+  struct rusage r;
+  getrusage(RUSAGE_SELF, &r);
+  usage[2 * Nsub + 0] = platform->device.memoryAllocated();
+  usage[2 * Nsub + 1] = 1024.0 * r.ru_maxrss; // kB on Linux
+  usage[2 * Nsub + 2] = platform->scratch.capacity();
+  usage[2 * Nsub + 3] = platform->scratch.highWaterMark();
+
+  std::vector<double> usageMax(usage.size()), usageSum(usage.size());
+  MPI_Reduce(usage.data(), usageMax.data(), usage.size(), MPI_DOUBLE, MPI_MAX, 0, comm);
+  MPI_Reduce(usage.data(), usageSum.data(), usage.size(), MPI_DOUBLE, MPI_SUM, 0, comm);
+
+  int rank;
+  MPI_Comm_rank(comm, &rank);
+  if(rank != 0) return;
+
+  auto printEntry = [&](const std::string& name, int i) {
+    printf("  %-20s %10.3f %10.3f %10.3f %10.3f\n", name.c_str(),
+           usageMax[2 * i] / 1e9, usageSum[2 * i] / 1e9,
+           usageMax[2 * i + 1] / 1e9, usageSum[2 * i + 1] / 1e9);
+  };
+  printf("\nmemory usage [GB]:\n");
+  printf("  %-20s %10s %10s %10s %10s\n", "", "device max", "device sum", "host max", "host sum");
+  for(int i = 0; i < Nsub; i++) printEntry(subsystems[i], i);
+  printEntry("total (peak RSS)", Nsub);
+  printf("  scratch arena capacity %.3f GB, high-water mark %.3f GB (max over ranks)\n",
+         usageMax[2 * Nsub + 2] / 1e9, usageMax[2 * Nsub + 3] / 1e9);
+  fflush(stdout);
 }
 void
 platform_t::create_mempool(const dlong offset, const dlong fields)
 {
   mempool.allocate(offset, fields);
-  o_mempool.allocate(mempool, offset, fields);
 }
 
 occa::kernel
@@ -164,6 +267,13 @@ device_t::malloc(const dlong Nword , const dlong wordSize)
   }
   return occa::device::malloc(Nword * wordSize, _buffer);
 }
+void
+device_t::freeHostBuffer()
+{
+  if(bufferSize > 0) std::free(_buffer);
+  _buffer = nullptr;
+  bufferSize = 0;
+}
 device_t::device_t(setupAide& options, MPI_Comm comm)
 {
   // OCCA build stuff
@@ -2,6 +2,9 @@
 #define platform_hpp_
 #include <occa.hpp>
 #include <mpi.h>
+#include <vector>
+#include <map>
+#include <string>
 #include "nrssys.hpp"
 #include "timer.hpp"
 class setupAide;
@@ -12,12 +15,44 @@ struct memPool_t{
   dfloat* slice9, *slice12, *slice15, *slice18, *slice19;
   dfloat* ptr;
 };
-struct deviceMemPool_t{
-
-  void allocate(memPool_t& hostMemory, const dlong offset, const dlong fields);
-  occa::memory slice0, slice1, slice2, slice3, slice4, slice5, slice6, slice7;
-  occa::memory slice9, slice12, slice15, slice18, slice19;
-  occa::memory o_ptr;
+// device scratch space with stack-like lifetimes, buffers have to be released
+// in reverse order of acquisition. Storage grows in blocks on demand and is
+// compacted to the high-water mark once nothing is in use.
+class scratchArena_t{
+  public:
+    void setup(const dlong fieldOffset, const int Nfields);
+    occa::memory acquire(const size_t Nbytes);
+    occa::memory acquireFields(const int Nfields);
+    void release(occa::memory& o_buf);
+    size_t highWaterMark() const { return highWater; }
+    size_t capacity() const;
+    dlong fieldOffset;
+  private:
+    struct entry_t{
+      size_t block;
+      size_t offset;
+      size_t size;
+      void* ptr;
+    };
+    std::vector<occa::memory> blocks;
+    std::vector<entry_t> stack;
+    size_t inUse = 0;
+    size_t highWater = 0;
+    bool poison = false;
+};
+// device and host memory per subsystem; device usage is attributed from the
+// growth of the device allocation counter between two calls of account()
+class memoryReport_t{
+  public:
+    void account(const std::string& subsystem);
+    void addHost(const std::string& subsystem, const size_t Nbytes);
+    void print(MPI_Comm comm);
+  private:
+    void add(const std::string& subsystem);
+    std::vector<std::string> subsystems;
+    std::map<std::string, size_t> device;
+    std::map<std::string, size_t> host;
+    size_t accounted = 0;
 };
 class device_t : public occa::device{
   public:
@@ -37,6 +72,7 @@ class device_t : public occa::device{
     occa::memory malloc(const dlong Nbytes, const occa::properties& properties);
     occa::memory malloc(const dlong Nwords, const dlong wordSize, occa::memory src);
     occa::memory malloc(const dlong Nwords, const dlong wordSize);
+    void freeHostBuffer();
   private:
     dlong bufferSize;
     void* _buffer;
@@ -56,7 +92,8 @@ struct platform_t{
   comm_t comm;
   linAlg_t* linAlg;
   memPool_t mempool;
-  deviceMemPool_t o_mempool;
+  scratchArena_t scratch;
+  memoryReport_t memory;
   void create_mempool(const dlong offset, const dlong fields);
   platform_t(setupAide& _options, MPI_Comm _comm);
 
@@ -4,6 +4,7 @@
 #include "udf.hpp"
 #include "filter.hpp"
 #include "bcMap.hpp"
+#include "io.hpp"
 #include <vector>
 #include <map>
 
@@ -75,9 +76,11 @@ void nrsSetup(MPI_Comm comm, setupAide &options, nrs_t *nrs)
     ABORT(EXIT_FAILURE);;
   } 
 
+  platform->memory.account("platform");
   nrs->_mesh = createMesh(comm, N, cubN, nrs->cht, kernelInfo);
   nrs->meshV = (mesh_t*) nrs->_mesh->fluid;
   mesh_t* mesh = nrs->meshV;
+  platform->memory.account("mesh");
 
   { 
     dlong minVal = mesh->NinternalElements; 
@@ -106,16 +109,18 @@ void nrsSetup(MPI_Comm comm, setupAide &options, nrs_t *nrs)
   }
   nrs->nEXT = 3;
   if(nrs->Nsubsteps) nrs->nEXT = nrs->nBDF;
-  nrs->coeffEXT = (dfloat*) calloc(nrs->nEXT, sizeof(dfloat));
-  nrs->coeffBDF = (dfloat*) calloc(nrs->nBDF, sizeof(dfloat));
 
   nrs->nRK = 4;
+  nrs->RKform = SUBCYCLE_ERK;
+  platform->options.getArgs("SUBCYCLING TIME STAGE NUMBER", nrs->nRK);
   nrs->coeffSubEXT = (dfloat*) calloc(3, sizeof(dfloat));
 
   dfloat mue = 1;
   dfloat rho = 1;
   platform->options.getArgs("VISCOSITY", mue);
   platform->options.getArgs("DENSITY", rho);
+  nrs->mue = mue;
+  nrs->rho = rho;
 
   const dlong Nlocal = mesh->Nlocal;
 
@@ -137,23 +142,70 @@ void nrsSetup(MPI_Comm comm, setupAide &options, nrs_t *nrs)
   if(nrs->Nsubsteps) {
     int Sorder;
     platform->options.getArgs("SUBCYCLING TIME ORDER", Sorder);
-    if(Sorder == 4 && nrs->nRK == 4) { // ERK(4,4)
-      dfloat rka[4] = {0.0, 1.0 / 2.0, 1.0 / 2.0, 1.0};
-      dfloat rkb[4] = {1.0 / 6.0, 1.0 / 3.0, 1.0 / 3.0, 1.0 / 6.0};
-      dfloat rkc[4] = {0.0, 1.0 / 2.0, 1.0 / 2.0, 1.0};
-      nrs->coeffsfRK = (dfloat*) calloc(nrs->nRK, sizeof(dfloat));
-      nrs->weightsRK = (dfloat*) calloc(nrs->nRK, sizeof(dfloat));
-      nrs->nodesRK = (dfloat*) calloc(nrs->nRK, sizeof(dfloat));
-      memcpy(nrs->coeffsfRK, rka, nrs->nRK * sizeof(dfloat));
-      memcpy(nrs->weightsRK, rkb, nrs->nRK * sizeof(dfloat));
-      memcpy(nrs->nodesRK, rkc, nrs->nRK * sizeof(dfloat));
+    const std::string scheme = platform->options.getArgs("SUBCYCLING TIME INTEGRATOR");
+    // coeffsfRK/weightsRK hold the Butcher a/b (ERK), the Williamson A/B (2N)
+    // or the Shu-Osher alpha/beta (2S*) coefficients
+    std::vector<dfloat> rka, rkb, rkc;
+    if(scheme == "ERK44" && Sorder == 4 && nrs->nRK == 4) { // ERK(4,4)
+      nrs->RKform = SUBCYCLE_ERK;
+      rka = {0.0, 1.0 / 2.0, 1.0 / 2.0, 1.0};
+      rkb = {1.0 / 6.0, 1.0 / 3.0, 1.0 / 3.0, 1.0 / 6.0};
+      rkc = {0.0, 1.0 / 2.0, 1.0 / 2.0, 1.0};
+    } else if(scheme == "LSRK54" && Sorder == 4 && nrs->nRK == 5) { // Carpenter-Kennedy LSRK(5,4)
+      nrs->RKform = SUBCYCLE_LSRK_2N;
+      rka = {0.0,
+             -567301805773.0 / 1357537059087.0,
+             -2404267990393.0 / 2016746695238.0,
+             -3550918686646.0 / 2091501179385.0,
+             -1275806237668.0 / 842570457699.0};
+      rkb = {1432997174477.0 / 9575080441755.0,
+             5161836677717.0 / 13612068292357.0,
+             1720146321549.0 / 2090206949498.0,
+             3134564353537.0 / 4481467310338.0,
+             2277821191437.0 / 14882151754819.0};
+      rkc = {0.0,
+             1432997174477.0 / 9575080441755.0,
+             2526269341429.0 / 6820363962896.0,
+             2006345519317.0 / 3224310063776.0,
+             2802321613138.0 / 2924317926251.0};
+    } else if(scheme == "SSPRK33" && Sorder == 3 && nrs->nRK == 3) { // Shu-Osher SSPRK(3,3)
+      nrs->RKform = SUBCYCLE_SSPRK_2S;
+      rka = {0.0, 3.0 / 4.0, 1.0 / 3.0};
+      rkb = {1.0, 1.0 / 4.0, 2.0 / 3.0};
+      rkc = {0.0, 1.0, 1.0 / 2.0};
+    } else if(scheme == "SSPRK43" && Sorder == 3 && nrs->nRK == 4) { // Kraaijevanger SSPRK(4,3)
+      nrs->RKform = SUBCYCLE_SSPRK_2S;
+      rka = {0.0, 0.0, 2.0 / 3.0, 0.0};
+      rkb = {1.0 / 2.0, 1.0 / 2.0, 1.0 / 6.0, 1.0 / 2.0};
+      rkc = {0.0, 1.0 / 2.0, 1.0, 1.0 / 2.0};
     }else{
       if(platform->comm.mpiRank == 0) cout << "Unsupported subcycling scheme!\n";
       ABORT(1);
     }
+    if(nrs->RKform != SUBCYCLE_ERK && platform->options.compareArgs("MOVING MESH", "TRUE")) {
+      if(platform->comm.mpiRank == 0) cout << "Subcycling with moving mesh requires ERK44!\n";
+      ABORT(1);
+    }
+    nrs->coeffsfRK = (dfloat*) calloc(nrs->nRK, sizeof(dfloat));
+    nrs->weightsRK = (dfloat*) calloc(nrs->nRK, sizeof(dfloat));
+    nrs->nodesRK = (dfloat*) calloc(nrs->nRK, sizeof(dfloat));
+    memcpy(nrs->coeffsfRK, rka.data(), nrs->nRK * sizeof(dfloat));
+    memcpy(nrs->weightsRK, rkb.data(), nrs->nRK * sizeof(dfloat));
+    memcpy(nrs->nodesRK, rkc.data(), nrs->nRK * sizeof(dfloat));
     nrs->o_coeffsfRK = device.malloc(nrs->nRK * sizeof(dfloat), nrs->coeffsfRK);
     nrs->o_weightsRK = device.malloc(nrs->nRK * sizeof(dfloat), nrs->weightsRK);
+    nrs->subCycleGraph.enable(platform->options.compareArgs("LAUNCH GRAPH", "TRUE"));
   }
+  nrs->makefGraph.enable(platform->options.compareArgs("LAUNCH GRAPH", "TRUE"));
+  nrs->pressureRhsGraph.enable(platform->options.compareArgs("LAUNCH GRAPH", "TRUE"));
+  nrs->velocityRhsGraph.enable(platform->options.compareArgs("LAUNCH GRAPH", "TRUE"));
+
+  nrs->NstepCoeff = STEPCOEFF_EXTC;
+  if(nrs->Nsubsteps) nrs->NstepCoeff += 6 * nrs->nEXT * nrs->Nsubsteps * nrs->nRK;
+  nrs->stepCoeff = (dfloat*) calloc(nrs->NstepCoeff, sizeof(dfloat));
+  nrs->o_stepCoeff = device.malloc(nrs->NstepCoeff * sizeof(dfloat), nrs->stepCoeff);
+  nrs->coeffBDF = nrs->stepCoeff + STEPCOEFF_BDF;
+  nrs->coeffEXT = nrs->stepCoeff + STEPCOEFF_EXT;
 
   // setup scratch space
   const int wrkNflds = 6;
@@ -162,23 +214,35 @@ void nrsSetup(MPI_Comm comm, setupAide &options, nrs_t *nrs)
 
   const int scratchNflds = wrkNflds + ellipticWrkNflds;
   platform->create_mempool(nrs->fieldOffset, scratchNflds);
+  // grows to the high-water mark of the active configuration
+  platform->scratch.setup(nrs->fieldOffset, wrkNflds);
+  platform->memory.account("scratch");
+
+  // with lazy host mirrors the solution fields are only copied to the host
+  // for transfers to nek, arrays used just to initialize the device are skipped
+  const int lazyHostMirrors = platform->options.compareArgs("HOST MIRRORS", "LAZY");
 
   if(options.compareArgs("MOVING MESH", "TRUE")){
     const int nBDF = std::max(nrs->nBDF, nrs->nEXT);
-    platform->o_mempool.slice0.copyFrom(mesh->o_LMM, mesh->Nlocal * sizeof(dfloat));
+    occa::memory o_tmp = platform->scratch.acquireFields(1);
+    o_tmp.copyFrom(mesh->o_LMM, mesh->Nlocal * sizeof(dfloat));
     mesh->o_LMM.free();
     mesh->o_LMM = platform->device.malloc(nrs->fieldOffset * nBDF ,  sizeof(dfloat));
-    mesh->o_LMM.copyFrom(platform->o_mempool.slice0, mesh->Nlocal * sizeof(dfloat));
-    platform->o_mempool.slice0.copyFrom(mesh->o_invLMM, mesh->Nlocal * sizeof(dfloat));
+    mesh->o_LMM.copyFrom(o_tmp, mesh->Nlocal * sizeof(dfloat));
+    o_tmp.copyFrom(mesh->o_invLMM, mesh->Nlocal * sizeof(dfloat));
     mesh->o_invLMM.free();
     mesh->o_invLMM = platform->device.malloc(nrs->fieldOffset * nBDF ,  sizeof(dfloat));
-    mesh->o_invLMM.copyFrom(platform->o_mempool.slice0, mesh->Nlocal * sizeof(dfloat));
+    mesh->o_invLMM.copyFrom(o_tmp, mesh->Nlocal * sizeof(dfloat));
+    platform->scratch.release(o_tmp);
 
     const int nAB = std::max(nrs->nEXT, mesh->nAB);
     mesh->U = (dfloat*) calloc(nrs->NVfields * nrs->fieldOffset * nAB, sizeof(dfloat));
     mesh->o_U = platform->device.malloc(nrs->NVfields * nrs->fieldOffset * nAB * sizeof(dfloat), mesh->U);
+    if(!lazyHostMirrors)
+      platform->memory.addHost("flow fields", nrs->NVfields * nrs->fieldOffset * nAB * sizeof(dfloat));
+    // ring buffer with the same slots as o_relUrst
     if(nrs->Nsubsteps)
-      mesh->o_divU = platform->device.malloc(nrs->fieldOffset * nAB, sizeof(dfloat));
+      mesh->o_divU = platform->device.malloc(nrs->fieldOffset * nBDF, sizeof(dfloat));
   }
 
   {
@@ -193,13 +257,18 @@ void nrsSetup(MPI_Comm comm, setupAide &options, nrs_t *nrs)
       nrs->o_relUrst = platform->device.malloc(Nstates * nrs->NVfields * offset, sizeof(dfloat));
     else
       nrs->o_Urst = platform->device.malloc(Nstates * nrs->NVfields * offset, sizeof(dfloat));
+    nrs->UrstHead = 0;
+    nrs->NUrstLevels = Nstates;
+    nrs->UrstLevelOffset = nrs->NVfields * offset;
   }
 
   nrs->U  = (dfloat*) calloc(nrs->NVfields * std::max(nrs->nBDF, nrs->nEXT) * nrs->fieldOffset,sizeof(dfloat));
-  nrs->Ue = (dfloat*) calloc(nrs->NVfields * nrs->fieldOffset,sizeof(dfloat));
   nrs->P  = (dfloat*) calloc(nrs->fieldOffset,sizeof(dfloat));
-  nrs->BF = (dfloat*) calloc(nrs->NVfields * nrs->fieldOffset,sizeof(dfloat));
-  nrs->FU = (dfloat*) calloc(nrs->NVfields * nrs->nEXT * nrs->fieldOffset,sizeof(dfloat));
+  if(!lazyHostMirrors) {
+    nrs->Ue = (dfloat*) calloc(nrs->NVfields * nrs->fieldOffset,sizeof(dfloat));
+    nrs->BF = (dfloat*) calloc(nrs->NVfields * nrs->fieldOffset,sizeof(dfloat));
+    nrs->FU = (dfloat*) calloc(nrs->NVfields * nrs->nEXT * nrs->fieldOffset,sizeof(dfloat));
+  }
 
   nrs->o_U  = platform->device.malloc(nrs->NVfields * std::max(nrs->nBDF,nrs->nEXT) * nrs->fieldOffset * sizeof(dfloat), nrs->U);
   nrs->o_Ue = platform->device.malloc(nrs->NVfields * nrs->fieldOffset * sizeof(dfloat), nrs->Ue);
@@ -225,10 +294,19 @@ void nrsSetup(MPI_Comm comm, setupAide &options, nrs_t *nrs)
   nrs->div   = (dfloat*) calloc(nrs->fieldOffset,sizeof(dfloat));
   nrs->o_div = device.malloc(nrs->fieldOffset * sizeof(dfloat), nrs->div);
 
-  nrs->o_coeffEXT = platform->device.malloc(nrs->nEXT * sizeof(dfloat), nrs->coeffEXT);
-  nrs->o_coeffBDF = platform->device.malloc(nrs->nBDF * sizeof(dfloat), nrs->coeffBDF);
+  nrs->o_coeffEXT = nrs->o_stepCoeff.slice(STEPCOEFF_EXT * sizeof(dfloat), nrs->nEXT * sizeof(dfloat));
+  nrs->o_coeffBDF = nrs->o_stepCoeff.slice(STEPCOEFF_BDF * sizeof(dfloat), nrs->nBDF * sizeof(dfloat));
   nrs->o_coeffSubEXT = platform->device.malloc(nrs->nEXT * sizeof(dfloat), nrs->coeffEXT);
 
+  {
+    // host arrays kept for the whole run: ellipticCoeff, and unless lazy U, Ue, P, BF, FU, prop, div
+    size_t Nfields = 2;
+    if(!lazyHostMirrors)
+      Nfields += nrs->NVfields * (std::max(nrs->nBDF, nrs->nEXT) + 2 + nrs->nEXT) + 4;
+    platform->memory.addHost("flow fields", Nfields * nrs->fieldOffset * sizeof(dfloat));
+  }
+  platform->memory.account("flow fields");
+
   // define aux kernel constants
   kernelInfo["defines/" "p_eNfields"] = nrs->NVfields;
   kernelInfo["defines/" "p_NVfields"] = nrs->NVfields;
@@ -255,6 +333,7 @@ void nrsSetup(MPI_Comm comm, setupAide &options, nrs_t *nrs)
   oogs_mode oogsMode = OOGS_AUTO; 
   //if(platform->device.mode() == "Serial" || platform->device.mode() == "OpenMP") oogsMode = OOGS_DEFAULT;
   nrs->gsh = oogs::setup(mesh->ogs, nrs->NVfields, nrs->fieldOffset, ogsDfloat, NULL, oogsMode);
+  platform->memory.account("gather-scatter");
 
   linAlg_t * linAlg = platform->linAlg;
 
@@ -263,11 +342,13 @@ void nrsSetup(MPI_Comm comm, setupAide &options, nrs_t *nrs)
     dlong gNelements = mesh->Nelements;
     MPI_Allreduce(MPI_IN_PLACE, &gNelements, 1, MPI_DLONG, MPI_SUM, platform->comm.mpiComm);
     const dfloat sum2 = (dfloat)gNelements * mesh->Np;
-    linAlg->fillKernel(nrs->fieldOffset, 1.0, platform->o_mempool.slice0);
-    ogsGatherScatter(platform->o_mempool.slice0, ogsDfloat, ogsAdd, mesh->ogs);
-    linAlg->axmyKernel(Nlocal, 1.0, mesh->ogs->o_invDegree, platform->o_mempool.slice0); 
+    occa::memory o_tmp = platform->scratch.acquireFields(1);
+    linAlg->fillKernel(nrs->fieldOffset, 1.0, o_tmp);
+    ogsGatherScatter(o_tmp, ogsDfloat, ogsAdd, mesh->ogs);
+    linAlg->axmyKernel(Nlocal, 1.0, mesh->ogs->o_invDegree, o_tmp); 
     dfloat* tmp = (dfloat*) calloc(Nlocal, sizeof(dfloat));
-    platform->o_mempool.slice0.copyTo(tmp, Nlocal * sizeof(dfloat));
+    o_tmp.copyTo(tmp, Nlocal * sizeof(dfloat));
+    platform->scratch.release(o_tmp);
     dfloat sum1 = 0;
     for(int i = 0; i < Nlocal; i++) sum1 += tmp[i];
     MPI_Allreduce(MPI_IN_PLACE, &sum1, 1, MPI_DFLOAT, MPI_SUM, platform->comm.mpiComm);
@@ -315,6 +396,12 @@ void nrsSetup(MPI_Comm comm, setupAide &options, nrs_t *nrs)
       cnt++;
     }
 
+  // traction contributions only arise on outflow faces
+  nrs->velocityNeumannBC = 0;
+  for (int n = 0; n < mesh->Nelements * mesh->Nfaces; n++)
+    if (nrs->EToB[n] == 3) nrs->velocityNeumannBC = 1;
+  MPI_Allreduce(MPI_IN_PLACE, &nrs->velocityNeumannBC, 1, MPI_INT, MPI_MAX, platform->comm.mpiComm);
+
   ogsGatherScatter(nrs->VmapB, ogsInt, ogsMin, mesh->ogs);
   for (int n = 0; n < mesh->Nelements * mesh->Np; n++)
     if (nrs->VmapB[n] == largeNumber) nrs->VmapB[n] = 0;
@@ -362,10 +449,6 @@ void nrsSetup(MPI_Comm comm, setupAide &options, nrs_t *nrs)
       kernelName = "gradientVolume" + suffix;
       nrs->gradientVolumeKernel =  device.buildKernel(fileName, kernelName, kernelInfo);
 
-      kernelName = "nrswGradientVolume" + suffix;
-      nrs->wgradientVolumeKernel =
-        device.buildKernel(fileName, kernelName, kernelInfo);
-
       {
         occa::properties prop = kernelInfo;
         const int movingMesh = platform->options.compareArgs("MOVING MESH", "TRUE");
@@ -376,10 +459,17 @@ void nrsSetup(MPI_Comm comm, setupAide &options, nrs_t *nrs)
           prop["defines/" "p_SUBCYCLING"] = 1;
         else
           prop["defines/" "p_SUBCYCLING"] = 0;
+
+        int advection = 0;
+        if(platform->options.compareArgs("ADVECTION", "TRUE") && !nrs->Nsubsteps)
+          advection = platform->options.compareArgs("ADVECTION TYPE", "CUBATURE") ? 2 : 1;
+        prop["defines/" "p_ADVECTION"] = advection;
+        prop["defines/" "p_FILTER"] =
+          platform->options.compareArgs("FILTER STABILIZATION", "RELAXATION") ? 1 : 0;
           
-        fileName = oklpath + "nrs/sumMakef.okl";
-        kernelName = "sumMakef";
-        nrs->sumMakefKernel =  device.buildKernel(fileName, kernelName, prop);
+        fileName = oklpath + "nrs/makef" + suffix + ".okl";
+        kernelName = "makef" + suffix;
+        nrs->makefKernel =  device.buildKernel(fileName, kernelName, prop);
       }
 
       fileName = oklpath + "nrs/divergence" + suffix + ".okl";
@@ -426,10 +516,21 @@ void nrsSetup(MPI_Comm comm, setupAide &options, nrs_t *nrs)
       kernelName = "pressureUpdate";
       nrs->pressureUpdateKernel =  device.buildKernel(fileName, kernelName, kernelInfo);
 
-      fileName = oklpath + "nrs/velocityRhs" + suffix + ".okl";
-      kernelName = "velocityRhsTOMBO" + suffix;
-      nrs->velocityRhsKernel =
-        device.buildKernel(fileName, kernelName, kernelInfo);
+      {
+        // udf.div is not known before UDF_Setup, build both variants
+        occa::properties prop = kernelInfo;
+        prop["defines/" "p_stressForm"] =
+          platform->options.compareArgs("STRESSFORMULATION", "TRUE") ? 1 : 0;
+
+        fileName = oklpath + "nrs/velocityRhs" + suffix + ".okl";
+        kernelName = "velocityRhsTOMBO" + suffix;
+        prop["defines/" "p_divergence"] = 0;
+        nrs->velocityRhsKernel =
+          device.buildKernel(fileName, kernelName, prop);
+        prop["defines/" "p_divergence"] = 1;
+        nrs->velocityRhsDivKernel =
+          device.buildKernel(fileName, kernelName, prop);
+      }
 
       fileName = oklpath + "nrs/velocityBC" + suffix + ".okl";
       kernelName = "velocityDirichletBC" + suffix;
@@ -478,8 +579,9 @@ void nrsSetup(MPI_Comm comm, setupAide &options, nrs_t *nrs)
           device.buildKernel(fileName, kernelName, prop);
 
         fileName = oklpath + "nrs/subCycleRKUpdate" + ".okl";
-        kernelName = "subCycleLSERKUpdate";
-        if(nrs->nRK == 4) kernelName = "subCycleERKUpdate";
+        kernelName = "subCycleERKUpdate";
+        if(nrs->RKform == SUBCYCLE_LSRK_2N) kernelName = "subCycleLSERKUpdate";
+        if(nrs->RKform == SUBCYCLE_SSPRK_2S) kernelName = "subCycleSSPRKUpdate";
         nrs->subCycleRKUpdateKernel =
           platform->device.buildKernel(fileName, kernelName, prop);
         kernelName = "subCycleRK";
@@ -505,6 +607,11 @@ void nrsSetup(MPI_Comm comm, setupAide &options, nrs_t *nrs)
       nrs->filterRTKernel =
         device.buildKernel(fileName, kernelName, kernelInfo);
 
+      fileName = oklpath + "core/filter" + suffix + ".okl";
+      kernelName = "filter" + suffix;
+      nrs->filterKernel =
+        device.buildKernel(fileName, kernelName, kernelInfo);
+
       occa::properties cflProps = kernelInfo;
       cflProps["defines/ " "p_MovingMesh"] = movingMesh;
       fileName = oklpath + "nrs/cfl" + suffix + ".okl";
@@ -525,10 +632,6 @@ void nrsSetup(MPI_Comm comm, setupAide &options, nrs_t *nrs)
       nrs->setEllipticCoeffPressureKernel =
         device.buildKernel(fileName, kernelName, kernelInfo);
 
-      fileName = oklpath + "nrs/mueDiv.okl";
-      kernelName = "mueDiv";
-      nrs->mueDivKernel =
-        device.buildKernel(fileName, kernelName, kernelInfo);
   }
 
   MPI_Barrier(platform->comm.mpiComm);
@@ -536,12 +639,31 @@ void nrsSetup(MPI_Comm comm, setupAide &options, nrs_t *nrs)
 
   if(nrs->Nscalar) {
     nrs->cds = cdsSetup(nrs, platform->options, kernelInfoBC);
+    platform->memory.account("scalar fields");
+  }
+
+  if(platform->options.compareArgs("MOVING MESH", "TRUE")) {
+    mesh_t* mesh = nrs->meshV;
+    if(nrs->cht) mesh = nrs->cds->mesh[0];
+    free(mesh->coeffAB);
+    mesh->o_coeffAB.free();
+    mesh->coeffAB = nrs->stepCoeff + STEPCOEFF_AB;
+    mesh->o_coeffAB = nrs->o_stepCoeff.slice(STEPCOEFF_AB * sizeof(dfloat), 3 * sizeof(dfloat));
   }
 
   if(!buildOnly) {
     // get IC + t0 from nek
     double startTime;
     nek::copyFromNek(startTime);
+    if(platform->options.compareArgs("RESTART FROM FILE", "1") &&
+       platform->options.compareArgs("RESTART READER", "NATIVE"))
+      readRestart(nrs, startTime);
+    if(platform->options.compareArgs("RESTART FROM FILE", "1") &&
+       platform->options.compareArgs("RESTART READER", "CHECKPOINT")) {
+      int startStep;
+      readCheckpoint(nrs, startTime, startStep);
+      platform->options.setArgs("START STEP", std::to_string(startStep));
+    }
     platform->options.setArgs("START TIME", to_string_f(startTime));
 
     if(platform->comm.mpiRank == 0)  printf("calling udf_setup ... "); fflush(stdout);
@@ -585,7 +707,6 @@ void nrsSetup(MPI_Comm comm, setupAide &options, nrs_t *nrs)
       cds->solver[is]->Nfields = 1;
       cds->solver[is]->Ntotal = nrs->fieldOffset;
       cds->solver[is]->wrk = platform->mempool.slice0 + nrs->ellipticWrkOffset;
-      cds->solver[is]->o_wrk = platform->o_mempool.o_ptr.slice(nrs->ellipticWrkOffset * sizeof(dfloat));
       cds->solver[is]->mesh = mesh;
       cds->solver[is]->dim = cds->dim;
       cds->solver[is]->elementType = cds->elementType;
@@ -601,6 +722,7 @@ void nrsSetup(MPI_Comm comm, setupAide &options, nrs_t *nrs)
       cds->solver[is]->options = cds->options[is];
       ellipticSolveSetup(cds->solver[is], kernelInfoS);
     }
+    platform->memory.account("scalar solvers");
   }
 
   if (nrs->flow) {
@@ -627,9 +749,12 @@ void nrsSetup(MPI_Comm comm, setupAide &options, nrs_t *nrs)
     nrs->vOptions = options;
     nrs->vOptions.setArgs("KRYLOV SOLVER",        options.getArgs("VELOCITY KRYLOV SOLVER"));
     nrs->vOptions.setArgs("SOLVER TOLERANCE",     options.getArgs("VELOCITY SOLVER TOLERANCE"));
+    nrs->vOptions.setArgs("MIXED PRECISION",      options.getArgs("VELOCITY MIXED PRECISION"));
     nrs->vOptions.setArgs("DISCRETIZATION",       options.getArgs("VELOCITY DISCRETIZATION"));
     nrs->vOptions.setArgs("BASIS",                options.getArgs("VELOCITY BASIS"));
     nrs->vOptions.setArgs("PRECONDITIONER",       options.getArgs("VELOCITY PRECONDITIONER"));
+    nrs->vOptions.setArgs("CHEBYSHEV DEGREE",     options.getArgs("VELOCITY CHEBYSHEV DEGREE"));
+    nrs->vOptions.setArgs("CHEBYSHEV RESIDUAL CHECK", options.getArgs("VELOCITY CHEBYSHEV RESIDUAL CHECK"));
     nrs->vOptions.setArgs("RESIDUAL PROJECTION",       options.getArgs("VELOCITY RESIDUAL PROJECTION"));
     nrs->vOptions.setArgs("RESIDUAL PROJECTION VECTORS",       options.getArgs("VELOCITY RESIDUAL PROJECTION VECTORS"));
     nrs->vOptions.setArgs("RESIDUAL PROJECTION START",       options.getArgs("VELOCITY RESIDUAL PROJECTION START"));
@@ -656,7 +781,6 @@ void nrsSetup(MPI_Comm comm, setupAide &options, nrs_t *nrs)
       nrs->uvwSolver->Nfields = nrs->NVfields;
       nrs->uvwSolver->Ntotal = nrs->fieldOffset;
       nrs->uvwSolver->wrk = platform->mempool.slice0 + nrs->ellipticWrkOffset;
-      nrs->uvwSolver->o_wrk = platform->o_mempool.o_ptr.slice(nrs->ellipticWrkOffset * sizeof(dfloat));
       nrs->uvwSolver->mesh = mesh;
       nrs->uvwSolver->options = nrs->vOptions;
       nrs->uvwSolver->dim = nrs->dim;
@@ -676,7 +800,6 @@ void nrsSetup(MPI_Comm comm, setupAide &options, nrs_t *nrs)
       nrs->uSolver->Nfields = 1;
       nrs->uSolver->Ntotal = nrs->fieldOffset;
       nrs->uSolver->wrk = platform->mempool.slice0 + nrs->ellipticWrkOffset;
-      nrs->uSolver->o_wrk = platform->o_mempool.o_ptr.slice(nrs->ellipticWrkOffset * sizeof(dfloat));
       nrs->uSolver->mesh = mesh;
       nrs->uSolver->options = nrs->vOptions;
       nrs->uSolver->dim = nrs->dim;
@@ -696,7 +819,6 @@ void nrsSetup(MPI_Comm comm, setupAide &options, nrs_t *nrs)
       nrs->vSolver->Nfields = 1;
       nrs->vSolver->Ntotal = nrs->fieldOffset;
       nrs->vSolver->wrk = platform->mempool.slice0 + nrs->ellipticWrkOffset;
-      nrs->vSolver->o_wrk = platform->o_mempool.o_ptr.slice(nrs->ellipticWrkOffset * sizeof(dfloat));
       nrs->vSolver->mesh = mesh;
       nrs->vSolver->options = nrs->vOptions;
       nrs->vSolver->dim = nrs->dim;
@@ -717,7 +839,6 @@ void nrsSetup(MPI_Comm comm, setupAide &options, nrs_t *nrs)
         nrs->wSolver->Nfields = 1;
         nrs->wSolver->Ntotal = nrs->fieldOffset;
         nrs->wSolver->wrk = platform->mempool.slice0 + nrs->ellipticWrkOffset;
-        nrs->wSolver->o_wrk = platform->o_mempool.o_ptr.slice(nrs->ellipticWrkOffset * sizeof(dfloat));
         nrs->wSolver->mesh = mesh;
         nrs->wSolver->options = nrs->vOptions;
         nrs->wSolver->dim = nrs->dim;
@@ -733,6 +854,7 @@ void nrsSetup(MPI_Comm comm, setupAide &options, nrs_t *nrs)
         ellipticSolveSetup(nrs->wSolver, kernelInfoV);
       }
     }
+    platform->memory.account("velocity solver");
   } // flow
 
   if (nrs->flow) {
@@ -745,6 +867,7 @@ void nrsSetup(MPI_Comm comm, setupAide &options, nrs_t *nrs)
     nrs->pOptions = options;
     nrs->pOptions.setArgs("KRYLOV SOLVER",        options.getArgs("PRESSURE KRYLOV SOLVER"));
     nrs->pOptions.setArgs("SOLVER TOLERANCE",     options.getArgs("PRESSURE SOLVER TOLERANCE"));
+    nrs->pOptions.setArgs("MIXED PRECISION",      options.getArgs("PRESSURE MIXED PRECISION"));
     nrs->pOptions.setArgs("DISCRETIZATION",       options.getArgs("PRESSURE DISCRETIZATION"));
     nrs->pOptions.setArgs("BASIS",                options.getArgs("PRESSURE BASIS"));
     nrs->pOptions.setArgs("PRECONDITIONER",       options.getArgs("PRESSURE PRECONDITIONER"));
@@ -756,6 +879,12 @@ void nrsSetup(MPI_Comm comm, setupAide &options, nrs_t *nrs)
                           options.getArgs("PRESSURE MULTIGRID UPWARD SMOOTHER"));
     nrs->pOptions.setArgs("MULTIGRID CHEBYSHEV DEGREE",
                           options.getArgs("PRESSURE MULTIGRID CHEBYSHEV DEGREE"));
+    nrs->pOptions.setArgs("MULTIGRID REFRESH INTERVAL",
+                          options.getArgs("PRESSURE MULTIGRID REFRESH INTERVAL"));
+    nrs->pOptions.setArgs("MULTIGRID REFRESH TOLERANCE",
+                          options.getArgs("PRESSURE MULTIGRID REFRESH TOLERANCE"));
+    nrs->pOptions.setArgs("MULTIGRID SCHWARZ STORAGE",
+                          options.getArgs("PRESSURE MULTIGRID SCHWARZ STORAGE"));
     nrs->pOptions.setArgs("PARALMOND CYCLE",      options.getArgs("PRESSURE PARALMOND CYCLE"));
     nrs->pOptions.setArgs("PARALMOND SMOOTHER",   options.getArgs("PRESSURE MULTIGRID SMOOTHER"));
     nrs->pOptions.setArgs("PARALMOND PARTITION",  options.getArgs("PRESSURE PARALMOND PARTITION"));
@@ -775,7 +904,6 @@ void nrsSetup(MPI_Comm comm, setupAide &options, nrs_t *nrs)
     nrs->pSolver->Nfields = 1;
     nrs->pSolver->Ntotal = nrs->fieldOffset;
     nrs->pSolver->wrk = platform->mempool.slice0 + nrs->ellipticWrkOffset;
-    nrs->pSolver->o_wrk = platform->o_mempool.o_ptr.slice(nrs->ellipticWrkOffset * sizeof(dfloat));
     nrs->pSolver->mesh = mesh;
     nrs->pSolver->dim = nrs->dim;
     nrs->pSolver->elementType = nrs->elementType;
@@ -862,7 +990,146 @@ void nrsSetup(MPI_Comm comm, setupAide &options, nrs_t *nrs)
     nrs->pSolver->options = nrs->pOptions;
     ellipticSolveSetup(nrs->pSolver, kernelInfoP);
 
+    platform->memory.account("pressure solver");
   } // flow
+
+  if (platform->options.compareArgs("MESH SOLVER", "ELASTICITY")) {
+    if (platform->comm.mpiRank == 0) printf("================ ELLIPTIC SETUP MESH ================\n");
+
+    if (nrs->cht) {
+      if (platform->comm.mpiRank == 0) printf("ERROR: MESH::solver = elasticity not supported for conjugate heat transfer!\n");
+      ABORT(EXIT_FAILURE);
+    }
+
+    int* uvwBCType = (int*) calloc(3 * NBCType, sizeof(int));
+    for (int bID = 1; bID <= nbrBIDs; bID++) {
+      string bcTypeText(bcMap::text(bID, "mesh"));
+      if(platform->comm.mpiRank == 0) printf("bID %d -> bcType %s\n", bID, bcTypeText.c_str());
+
+      uvwBCType[bID + 0 * NBCType] = bcMap::type(bID, "x-mesh");
+      uvwBCType[bID + 1 * NBCType] = bcMap::type(bID, "y-mesh");
+      uvwBCType[bID + 2 * NBCType] = bcMap::type(bID, "z-mesh");
+    }
+
+    nrs->mOptions = options;
+    nrs->mOptions.setArgs("KRYLOV SOLVER",        options.getArgs("MESH KRYLOV SOLVER"));
+    nrs->mOptions.setArgs("SOLVER TOLERANCE",     options.getArgs("MESH SOLVER TOLERANCE"));
+    nrs->mOptions.setArgs("PRECONDITIONER",       options.getArgs("MESH PRECONDITIONER"));
+    nrs->mOptions.setArgs("MIXED PRECISION",      "FALSE");
+    nrs->mOptions.setArgs("DISCRETIZATION",       "CONTINUOUS");
+    nrs->mOptions.setArgs("BASIS",                "NODAL");
+    nrs->mOptions.setArgs("RESIDUAL PROJECTION",  options.getArgs("MESH RESIDUAL PROJECTION"));
+    nrs->mOptions.setArgs("RESIDUAL PROJECTION VECTORS",
+                          options.getArgs("MESH RESIDUAL PROJECTION VECTORS"));
+    nrs->mOptions.setArgs("RESIDUAL PROJECTION START",
+                          options.getArgs("MESH RESIDUAL PROJECTION START"));
+
+    // linear elasticity with unit shear modulus and no mass term
+    dfloat* lambda = (dfloat*) calloc(2 * nrs->fieldOffset, sizeof(dfloat));
+    for (int i = 0; i < nrs->fieldOffset; i++) lambda[i] = 1;
+
+    nrs->meshSolver = new elliptic_t();
+    nrs->meshSolver->blockSolver = 1;
+    nrs->meshSolver->stressForm = 1;
+    nrs->meshSolver->Nfields = nrs->NVfields;
+    nrs->meshSolver->Ntotal = nrs->fieldOffset;
+    nrs->meshSolver->wrk = platform->mempool.slice0 + nrs->ellipticWrkOffset;
+    nrs->meshSolver->mesh = mesh;
+    nrs->meshSolver->options = nrs->mOptions;
+    nrs->meshSolver->dim = nrs->dim;
+    nrs->meshSolver->elementType = nrs->elementType;
+    nrs->meshSolver->NBCType = NBCType;
+    nrs->meshSolver->BCType = (int*) calloc(nrs->NVfields * NBCType,sizeof(int));
+    memcpy(nrs->meshSolver->BCType,uvwBCType,nrs->NVfields * NBCType * sizeof(int));
+    nrs->meshSolver->var_coeff = 1;
+    nrs->meshSolver->lambda = lambda;
+    nrs->meshSolver->o_lambda = device.malloc(2 * nrs->fieldOffset * sizeof(dfloat), lambda);
+    nrs->meshSolver->loffset = 0;
+
+    ellipticSolveSetup(nrs->meshSolver, kernelInfoV);
+    free(uvwBCType);
+
+    // Dirichlet nodes on fixedValue boundaries move with the fluid,
+    // zeroValue takes precedence on shared edges
+    elliptic_t* solver = nrs->meshSolver;
+    std::vector<int> meshMapB(mesh->Nelements * mesh->Np, largeNumber);
+    for (int e = 0; e < mesh->Nelements; e++)
+      for (int f = 0; f < mesh->Nfaces; f++) {
+        const int bc = bcMap::id(mesh->EToB[f + e * mesh->Nfaces], "mesh");
+        if (bc > 0) {
+          for (int n = 0; n < mesh->Nfp; n++) {
+            const int fid = mesh->faceNodes[n + f * mesh->Nfp];
+            meshMapB[fid + e * mesh->Np] = mymin(bc, meshMapB[fid + e * mesh->Np]);
+          }
+        }
+      }
+    ogsGatherScatter(meshMapB.data(), ogsInt, ogsMin, mesh->ogs);
+
+    std::vector<dlong> fluidIds;
+    for (int fld = 0; fld < solver->Nfields; fld++)
+      for (dlong n = 0; n < mesh->Nelements * mesh->Np; n++)
+        if (meshMapB[n] == 2 && solver->mapB[n + fld * solver->Ntotal] == 1)
+          fluidIds.push_back(n + fld * solver->Ntotal);
+
+    nrs->NmeshFluidIds = fluidIds.size();
+    if (nrs->NmeshFluidIds)
+      nrs->o_meshFluidIds = device.malloc(nrs->NmeshFluidIds * sizeof(dlong), fluidIds.data());
+    platform->memory.account("mesh solver");
+  }
+
+  // projection spaces require the elliptic solvers
+  if(!buildOnly && platform->options.compareArgs("RESTART FROM FILE", "1") &&
+     platform->options.compareArgs("RESTART READER", "CHECKPOINT"))
+    readCheckpointProjection(nrs);
+}
+
+void nrsAllocateHostMirrors(nrs_t* nrs)
+{
+  if(nrs->U) return;
+
+  nrs->U = (dfloat*) calloc(nrs->NVfields * std::max(nrs->nBDF, nrs->nEXT) * nrs->fieldOffset, sizeof(dfloat));
+  nrs->P = (dfloat*) calloc(nrs->fieldOffset, sizeof(dfloat));
+  nrs->div = (dfloat*) calloc(nrs->fieldOffset, sizeof(dfloat));
+  if(nrs->Nscalar) {
+    cds_t* cds = nrs->cds;
+    cds->U = nrs->U;
+    cds->S = (dfloat*) calloc(std::max(cds->nBDF, cds->nEXT) * cds->fieldOffsetSum, sizeof(dfloat));
+  }
+  if(platform->options.compareArgs("MOVING MESH", "TRUE")) {
+    mesh_t* mesh = nrs->meshV;
+    if(nrs->cht) mesh = nrs->cds->mesh[0];
+    const int nAB = std::max(nrs->nEXT, mesh->nAB);
+    mesh->U = (dfloat*) calloc(nrs->NVfields * nrs->fieldOffset * nAB, sizeof(dfloat));
+  }
+}
+
+void nrsFreeHostMirrors(nrs_t* nrs)
+{
+  if(!platform->options.compareArgs("HOST MIRRORS", "LAZY") || !nrs->U) return;
+
+  free(nrs->U);
+  free(nrs->P);
+  free(nrs->div);
+  nrs->U = nullptr;
+  nrs->P = nullptr;
+  nrs->div = nullptr;
+  // material properties are only read back during setup
+  free(nrs->prop);
+  nrs->prop = nullptr;
+  if(nrs->Nscalar) {
+    cds_t* cds = nrs->cds;
+    free(cds->S);
+    free(cds->prop);
+    cds->S = nullptr;
+    cds->prop = nullptr;
+    cds->U = nullptr;
+  }
+  if(platform->options.compareArgs("MOVING MESH", "TRUE")) {
+    mesh_t* mesh = nrs->meshV;
+    if(nrs->cht) mesh = nrs->cds->mesh[0];
+    free(mesh->U);
+    mesh->U = nullptr;
+  }
 }
 
 namespace{
@@ -890,6 +1157,7 @@ cds_t* cdsSetup(nrs_t* nrs, setupAide options, occa::properties& kernelInfoBC)
   cds->o_coeffEXT  = nrs->o_coeffEXT;
   cds->o_coeffBDF  = nrs->o_coeffBDF;
   cds->o_coeffSubEXT = nrs->o_coeffSubEXT;
+  cds->o_stepCoeff = nrs->o_stepCoeff;
 
   cds->o_usrwrk = &(nrs->o_usrwrk);
 
@@ -919,18 +1187,26 @@ cds_t* cdsSetup(nrs_t* nrs, setupAide options, occa::properties& kernelInfoBC)
   cds->U     = nrs->U; // Point to INS side Velocity
   cds->S     =
     (dfloat*) calloc(std::max(cds->nBDF, cds->nEXT) * cds->fieldOffsetSum,sizeof(dfloat));
-  cds->BF    = (dfloat*) calloc(cds->fieldOffsetSum,sizeof(dfloat));
-  cds->FS    =
-    (dfloat*) calloc(cds->nBDF * cds->fieldOffsetSum,sizeof(dfloat));
+  if(!platform->options.compareArgs("HOST MIRRORS", "LAZY")) {
+    cds->BF    = (dfloat*) calloc(cds->fieldOffsetSum,sizeof(dfloat));
+    cds->FS    =
+      (dfloat*) calloc(cds->nBDF * cds->fieldOffsetSum,sizeof(dfloat));
+    // S, BF, FS and prop
+    const int Nfields = std::max(cds->nBDF, cds->nEXT) + 1 + cds->nBDF + 2;
+    platform->memory.addHost("scalar fields", Nfields * cds->fieldOffsetSum * sizeof(dfloat));
+  }
 
   cds->Nsubsteps = nrs->Nsubsteps;
   if(cds->Nsubsteps) {
     cds->nRK   = nrs->nRK;
+    cds->RKform = nrs->RKform;
     cds->coeffsfRK   = nrs->coeffsfRK;
     cds->weightsRK   = nrs->weightsRK;
     cds->nodesRK   = nrs->nodesRK;
     cds->o_coeffsfRK = nrs->o_coeffsfRK;
     cds->o_weightsRK = nrs->o_weightsRK;
+    for(int is = 0; is < cds->NSfields; is++)
+      cds->subCycleGraph[is].enable(platform->options.compareArgs("LAUNCH GRAPH", "TRUE"));
   }
 
   cds->dt  = nrs->dt;
@@ -978,6 +1254,9 @@ cds_t* cdsSetup(nrs_t* nrs, setupAide options, occa::properties& kernelInfoBC)
 
   cds->o_relUrst = nrs->o_relUrst;
   cds->o_Urst = nrs->o_Urst;
+  cds->UrstHead = nrs->UrstHead;
+  cds->NUrstLevels = nrs->NUrstLevels;
+  cds->UrstLevelOffset = nrs->UrstLevelOffset;
 
   for (int is = 0; is < cds->NSfields; is++) {
     std::stringstream ss;
@@ -996,6 +1275,13 @@ cds_t* cdsSetup(nrs_t* nrs, setupAide options, occa::properties& kernelInfoBC)
     cds->options[is] = options;
 
     cds->options[is].setArgs("KRYLOV SOLVER", options.getArgs("SCALAR SOLVER"));
+    if(options.compareArgs("SCALAR" + sid + " KRYLOV SOLVER", "CHEBYSHEV")) {
+      cds->options[is].setArgs("KRYLOV SOLVER", "CHEBYSHEV");
+      std::string degree = options.getArgs("SCALAR" + sid + " CHEBYSHEV DEGREE");
+      std::string resCheck = options.getArgs("SCALAR" + sid + " CHEBYSHEV RESIDUAL CHECK");
+      cds->options[is].setArgs("CHEBYSHEV DEGREE", degree.empty() ? "8" : degree);
+      cds->options[is].setArgs("CHEBYSHEV RESIDUAL CHECK", resCheck.empty() ? "TRUE" : resCheck);
+    }
     cds->options[is].setArgs("DISCRETIZATION", options.getArgs("SCALAR DISCRETIZATION"));
     cds->options[is].setArgs("BASIS", options.getArgs("SCALAR BASIS"));
     cds->options[is].setArgs("PRECONDITIONER", options.getArgs("SCALAR" + sid + " PRECONDITIONER"));
@@ -1140,8 +1426,9 @@ cds_t* cdsSetup(nrs_t* nrs, setupAide options, occa::properties& kernelInfoBC)
 
 
         fileName = oklpath + "cds/subCycleRKUpdate.okl";
-        kernelName = "subCycleLSERKUpdate";
-        if(cds->nRK == 4) kernelName = "subCycleERKUpdate";
+        kernelName = "subCycleERKUpdate";
+        if(cds->RKform == SUBCYCLE_LSRK_2N) kernelName = "subCycleLSERKUpdate";
+        if(cds->RKform == SUBCYCLE_SSPRK_2S) kernelName = "subCycleSSPRKUpdate";
         cds->subCycleRKUpdateKernel =  platform->device.buildKernel(fileName, kernelName, prop);
         kernelName = "subCycleRK";
         cds->subCycleRKKernel =  platform->device.buildKernel(fileName, kernelName, prop);
@@ -4,4 +4,9 @@
 #include "nrs.hpp"
 void nrsSetup(MPI_Comm comm, setupAide &options, nrs_t *nrs);
 
+// host copies of the solution fields; with HOST MIRRORS = LAZY they only
+// exist while data is transferred to/from nek
+void nrsAllocateHostMirrors(nrs_t *nrs);
+void nrsFreeHostMirrors(nrs_t *nrs);
+
 #endif
@@ -1,6 +1,9 @@
 #include <iostream>
 #include <string>
 #include <map>
+#include <set>
+#include <vector>
+#include <sstream>
 #include <algorithm>
 
 #include "timer.hpp"
@@ -29,6 +32,146 @@ inline int ifSync(){ return ifSync_; }
 
 occa::device device_;
 MPI_Comm comm_;
+
+double elapsed(const tagData& t)
+{
+  // host-only timers do not record device time
+  return (t.deviceElapsed > 0) ? t.deviceElapsed : t.hostElapsed;
+}
+
+// union of all tag names across ranks in lexicographic order
+std::vector<std::string> allTags()
+{
+  int rank, size;
+  MPI_Comm_rank(comm_, &rank);
+  MPI_Comm_size(comm_, &size);
+
+  std::string local;
+  for(auto& it : m_) local += it.first + '\n';
+  int len = local.size();
+
+  std::vector<int> counts(size), displs(size, 0);
+  MPI_Gather(&len, 1, MPI_INT, counts.data(), 1, MPI_INT, 0, comm_);
+  for(int i = 1; i < size; i++) displs[i] = displs[i - 1] + counts[i - 1];
+  std::vector<char> recv((rank == 0) ? displs[size - 1] + counts[size - 1] : 0);
+  MPI_Gatherv(local.data(), len, MPI_CHAR, recv.data(), counts.data(), displs.data(), MPI_CHAR, 0, comm_);
+
+  std::string all;
+  if(rank == 0) {
+    std::set<std::string> tags;
+    std::istringstream iss(std::string(recv.begin(), recv.end()));
+    std::string tag;
+    while(std::getline(iss, tag)) tags.insert(tag);
+    for(auto& t : tags) all += t + '\n';
+  }
+  len = all.size();
+  MPI_Bcast(&len, 1, MPI_INT, 0, comm_);
+  all.resize(len);
+  MPI_Bcast(&all[0], len, MPI_CHAR, 0, comm_);
+
+  std::vector<std::string> tags;
+  std::istringstream iss(all);
+  std::string tag;
+  while(std::getline(iss, tag)) tags.push_back(tag);
+  return tags;
+}
+
+// min/avg/max across ranks for every timed region, communication share and element counts
+void printLoadBalance(dlong Nelements)
+{
+  int rank, size;
+  MPI_Comm_rank(comm_, &rank);
+  MPI_Comm_size(comm_, &size);
+
+  const std::vector<std::string> tags = allTags();
+  const int Ntags = tags.size();
+
+  std::vector<double> t(Ntags, 0), tMin(Ntags), tMax(Ntags), tSum(Ntags);
+  std::vector<long long> cnt(Ntags, 0), cntMax(Ntags);
+  for(int i = 0; i < Ntags; i++) {
+    auto it = m_.find(tags[i]);
+    if(it == m_.end()) continue;
+    t[i] = elapsed(it->second);
+    cnt[i] = it->second.count;
+  }
+  MPI_Reduce(t.data(), tMin.data(), Ntags, MPI_DOUBLE, MPI_MIN, 0, comm_);
+  MPI_Reduce(t.data(), tMax.data(), Ntags, MPI_DOUBLE, MPI_MAX, 0, comm_);
+  MPI_Reduce(t.data(), tSum.data(), Ntags, MPI_DOUBLE, MPI_SUM, 0, comm_);
+  MPI_Reduce(cnt.data(), cntMax.data(), Ntags, MPI_LONG_LONG, MPI_MAX, 0, comm_);
+
+  // per rank: elements, solve, gather-scatter MPI and reductions
+  auto local = [&](const std::string& tag) {
+    auto it = m_.find(tag);
+    return (it == m_.end()) ? 0.0 : elapsed(it->second);
+  };
+  double perRank[4] = {(double) Nelements, local("solve"), ogsTime(/* reportHostTime */ true), local("dotp")};
+  std::vector<double> ranks(4 * size);
+  MPI_Gather(perRank, 4, MPI_DOUBLE, ranks.data(), 4, MPI_DOUBLE, 0, comm_);
+
+  std::string dumpFile;
+  platform->options.getArgs("RUNTIME STATISTICS FILE", dumpFile);
+
+  if(rank != 0) return;
+
+  auto stats = [&](int field, double& mn, double& avg, double& mx) {
+    mn = mx = ranks[field];
+    avg = 0;
+    for(int r = 0; r < size; r++) {
+      const double v = ranks[4 * r + field];
+      mn = std::min(mn, v);
+      mx = std::max(mx, v);
+      avg += v / size;
+    }
+  };
+  auto commFraction = [&](int r) {
+    const double solve = ranks[4 * r + 1];
+    return (solve > 0) ? (ranks[4 * r + 2] + ranks[4 * r + 3]) / solve : 0.0;
+  };
+
+  double eMin, eAvg, eMax;
+  stats(0, eMin, eAvg, eMax);
+  double fMin = commFraction(0), fMax = fMin, fAvg = 0;
+  for(int r = 0; r < size; r++) {
+    const double f = commFraction(r);
+    fMin = std::min(fMin, f);
+    fMax = std::max(fMax, f);
+    fAvg += f / size;
+  }
+
+  printf("load balance over %d ranks (min/avg/max, max/avg)\n\n", size);
+  if(Nelements > 0)
+    printf("  %-28s %12.0f %12.1f %12.0f %8.2f\n", "elements", eMin, eAvg, eMax, (eAvg > 0) ? eMax / eAvg : 0);
+  printf("  %-28s %12.3f %12.3f %12.3f   (gsMPI + dotp)/solve\n\n", "communication share", fMin, fAvg, fMax);
+  printf("  %-28s %12s %12s %12s %8s %10s\n", "region", "min [s]", "avg [s]", "max [s]", "max/avg", "calls");
+  for(int i = 0; i < Ntags; i++) {
+    const double avg = tSum[i] / size;
+    printf("  %-28s %12.4e %12.4e %12.4e %8.2f %10lld\n",
+           tags[i].c_str(), tMin[i], avg, tMax[i], (avg > 0) ? tMax[i] / avg : 0, cntMax[i]);
+  }
+  printf("\n");
+
+  if(dumpFile.empty()) return;
+
+  FILE* fp = fopen(dumpFile.c_str(), "w");
+  if(!fp) {
+    printf("cannot open %s for writing runtime statistics!\n", dumpFile.c_str());
+    return;
+  }
+  fprintf(fp, "{\n  \"ranks\": %d,\n", size);
+  fprintf(fp, "  \"elements\": {\"min\": %.0f, \"avg\": %.6g, \"max\": %.0f},\n", eMin, eAvg, eMax);
+  fprintf(fp, "  \"communicationShare\": {\"min\": %.6g, \"avg\": %.6g, \"max\": %.6g},\n", fMin, fAvg, fMax);
+  fprintf(fp, "  \"regions\": {\n");
+  for(int i = 0; i < Ntags; i++)
+    fprintf(fp, "    \"%s\": {\"calls\": %lld, \"min\": %.6e, \"avg\": %.6e, \"max\": %.6e}%s\n",
+            tags[i].c_str(), cntMax[i], tMin[i], tSum[i] / size, tMax[i], (i < Ntags - 1) ? "," : "");
+  fprintf(fp, "  },\n");
+  fprintf(fp, "  \"perRank\": [\n");
+  for(int r = 0; r < size; r++)
+    fprintf(fp, "    {\"elements\": %.0f, \"solve\": %.6e, \"gsMPI\": %.6e, \"dotp\": %.6e}%s\n",
+            ranks[4 * r + 0], ranks[4 * r + 1], ranks[4 * r + 2], ranks[4 * r + 3], (r < size - 1) ? "," : "");
+  fprintf(fp, "  ]\n}\n");
+  fclose(fp);
+}
 }
 
 timer_t::timer_t(MPI_Comm comm,occa::device device,int ifSync)
@@ -227,7 +370,7 @@ double timer_t::query(const std::string tag,const std::string metric)
   return NEKRS_TIMER_INVALID_METRIC;
 }
 
-void timer_t::printRunStat()
+void timer_t::printRunStat(dlong Nelements)
 {
   int rank;
   MPI_Comm_rank(comm_, &rank);
@@ -242,6 +385,7 @@ void timer_t::printRunStat()
   dEtime[6] = query("pre", "DEVICE:MAX");
   dEtime[6]+= query("post", "DEVICE:MAX");
 
+  dEtime[7] = query("meshSolve", "DEVICE:MAX");
   dEtime[8] = query("dotp", "DEVICE:MAX");
 
   dEtime[9] = query("solve", "DEVICE:MAX");
@@ -280,6 +424,9 @@ void timer_t::printRunStat()
     std::cout << "    preconditioner      " << dEtime[5] << " s\n"
               << "      coarse grid       " << hEtime[0] << " s\n";
 
+    if(dEtime[7] > 0)
+    std::cout << "  meshSolve             " << dEtime[7] << " s\n";
+
     if(dEtime[14] > 0)
     std::cout << "  scalarSolve           " << dEtime[4] << " s\n"
               << std::endl;
@@ -304,5 +451,7 @@ void timer_t::printRunStat()
 
     std::cout.unsetf ( std::ios::scientific );
   }
+
+  printLoadBalance(Nelements);
 }
 } // namespace
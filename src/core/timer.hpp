@@ -30,7 +30,7 @@ double hostElapsed(const std::string tag);
 double deviceElapsed(const std::string tag);
 int count(const std::string tag);
 double query(const std::string tag,std::string metric);
-void printRunStat();
+void printRunStat(dlong Nelements = 0);
 };
 }
 
@@ -84,7 +84,6 @@ struct elliptic_t
   int* EToB;
 
   dfloat* wrk;
-  occa::memory o_wrk;
 
   //C0-FEM mask data
   int* mapB;      // boundary flag of face nodes
@@ -100,6 +99,10 @@ struct elliptic_t
   occa::stream defaultStream;
   occa::stream dataStream;
 
+  // private communicator for the reductions of this solver, so reductions of
+  // different solvers cannot be matched against each other
+  MPI_Comm comm;
+
   occa::memory o_x;
   occa::memory o_x0;
   occa::memory o_r;
@@ -138,6 +141,26 @@ struct elliptic_t
   occa::memory o_tmpNormr;
   occa::kernel updatePCGKernel;
 
+  // Chebyshev iteration (Jacobi preconditioned)
+  dfloat chebyshevLambdaMin, chebyshevLambdaMax;
+  dfloat chebyshevCoeffSum[2]; // local sums of lambda0/lambda1 at last estimate
+  int chebyshevEstimated;
+  occa::kernel updateChebyshevKernel;
+
+  // mixed-precision solve (FP32 inner PCG + FP64 iterative refinement)
+  int mixedPrecision;
+  occa::memory o_rPfloat;
+  occa::memory o_xPfloat;
+  occa::memory o_pPfloat;
+  occa::memory o_zPfloat;
+  occa::memory o_ApPfloat;
+  occa::memory o_invDegreePfloat;
+  occa::memory o_invDiagAPfloat;
+  occa::memory o_lambdaPfloat;
+  occa::kernel updatePCGPfloatKernel;
+  occa::kernel weightedInnerProdPfloatKernel;
+  occa::kernel fillPfloatKernel;
+
   hlong NelementsGlobal;
 
   occa::kernel updateDiagonalKernel;
@@ -181,6 +204,11 @@ void ellipticEndHaloExchange(elliptic_t* elliptic,
 //Linear solvers
 int pcg(elliptic_t* elliptic, occa::memory &o_r, occa::memory &o_x,
         const dfloat tol, const int MAXIT, dfloat &res);
+int pcgMixed(elliptic_t* elliptic, occa::memory &o_r, occa::memory &o_x,
+             const dfloat tol, const int MAXIT, dfloat &res);
+int chebyshev(elliptic_t* elliptic, occa::memory &o_r, occa::memory &o_x,
+              const dfloat tol, const int MAXIT, dfloat &res);
+void ellipticEstimateEigenvalues(elliptic_t* elliptic, dfloat &lambdaMin, dfloat &lambdaMax);
 
 void ellipticOperator(elliptic_t* elliptic,
                       occa::memory &o_q,
@@ -212,6 +240,10 @@ void ellipticBuildLocalPatches(elliptic_t* elliptic, dfloat lambda, dfloat rateT
                                dlong* Npataches, dlong** patchesIndex, dfloat** patchesInvA);
 
 void ellipticMultiGridSetup(elliptic_t* elliptic, precon_t* precon);
+void ellipticMultiGridCoarseMatrix(elliptic_t* ellipticCoarse, elliptic_t* ellipticFine, dfloat lambda,
+                                   hlong* coarseGlobalStarts, dlong* nnz,
+                                   hlong** Rows, hlong** Cols, dfloat** Vals);
+void ellipticMultiGridUpdate(elliptic_t* elliptic);
 elliptic_t* ellipticBuildMultigridLevel(elliptic_t* baseElliptic, int Nc, int Nf);
 
 dfloat ellipticUpdatePCG(elliptic_t* elliptic, occa::memory &o_p, occa::memory &o_Ap, dfloat alpha,
@@ -47,7 +47,11 @@ public:
   dfloat* R;
   occa::memory o_R;
   int NpF;
-  occa::memory o_invDegree;
+  occa::memory o_invDegree; // pfloat, fine level
+
+  // level vectors (x, rhs, res) are pfloat except on the coarsest
+  // MGLevel which interfaces the dfloat coarse grid solver
+  bool isCoarsest;
 
   //smoothing params
   SmoothType stype;
@@ -66,6 +70,16 @@ public:
   bool overlap;
   occa::kernel fusedFDMKernel;
   occa::kernel postFDMKernel;
+
+  // element splits for hiding the extended mesh exchange
+  dlong NextendedGlobalElements = 0; // touching the extended halo
+  dlong NextendedLocalElements = 0;
+  dlong NinteriorElements = 0; // neither extended halo nor global gather
+  dlong NshellElements = 0; // extended halo but no global gather
+  occa::memory o_extendedGlobalElementList;
+  occa::memory o_extendedLocalElementList;
+  occa::memory o_interiorElementList;
+  occa::memory o_shellElementList;
   // Eigenvectors
   occa::memory o_Sx;
   occa::memory o_Sy;
@@ -81,6 +95,19 @@ public:
   // Eigenvalues
   occa::memory o_invL;
 
+  // host copies of the FDM operators and the element lengths they were built from
+  std::vector<pfloat> fdmSx, fdmSy, fdmSz, fdmInvL;
+  std::vector<dfloat> fdmLengths;
+
+  // coarse geometry from interpolated fine-level coordinates (moving mesh),
+  // the coarse mesh is a struct copy of the fine one so it gets its own buffers
+  occa::memory o_interpFine;
+  occa::memory o_xyz;
+  occa::memory o_geomWeights;
+  occa::memory o_geomWrk;
+  occa::kernel interpolateKernel;
+  occa::kernel geometricFactorsKernel;
+
   //jacobi data
   occa::memory o_invDiagA;
 
@@ -131,6 +158,10 @@ public:
   void smoothRichardson(occa::memory &o_r, occa::memory &o_x, bool xIsZero);
   void smoothChebyshev (occa::memory &o_r, occa::memory &o_x, bool xIsZero);
   void smoothSchwarz (occa::memory &o_r, occa::memory &o_x, bool xIsZero);
+  void setupOverlapElementLists();
+  dlong updateSchwarz(elliptic_t* pSolver, dfloat tol);
+  void updateGeometry(elliptic_t* ellipticFine);
+  void updateSmoother();
 
   void smootherJacobi    (occa::memory &o_r, occa::memory &o_Sr);
 
@@ -34,47 +34,69 @@ void MGLevel::Ax(occa::memory o_x, occa::memory o_Ax)
 
 void MGLevel::residual(occa::memory o_rhs, occa::memory o_x, occa::memory o_res)
 {
+  if(isCoarsest) {
+    if(stype != SCHWARZ) {
+      ellipticOperator(elliptic,o_x,o_res, dfloatString);
+      // subtract r = b - A*x
+      const dlong Nlocal = mesh->Np * mesh->Nelements;
+      platform->linAlg->axpbyMany(
+        Nlocal,
+        elliptic->Nfields,
+        elliptic->Ntotal,
+        1.0,
+        o_rhs,
+        -1.0,
+        o_res
+      );
+    } else {
+      o_res.copyFrom(o_rhs, Nrows*sizeof(dfloat));
+    }
+    return;
+  }
+
   if(stype != SCHWARZ) {
-    ellipticOperator(elliptic,o_x,o_res, dfloatString);
+    ellipticOperator(elliptic,o_x,o_res, pfloatString);
     // subtract r = b - A*x
-    const dlong Nlocal = mesh->Np * mesh->Nelements;
-    platform->linAlg->axpbyMany(
-      Nlocal,
-      elliptic->Nfields,
-      elliptic->Ntotal,
-      1.0,
-      o_rhs,
-      -1.0,
-      o_res
-    );
+    const pfloat one = 1.0;
+    const pfloat mone = -1.0;
+    elliptic->scaledAddPfloatKernel(Nrows, one, o_rhs, mone, o_res);
   } else {
-    o_res.copyFrom(o_rhs, Nrows*sizeof(dfloat));
+    o_res.copyFrom(o_rhs, Nrows*sizeof(pfloat));
   }
 }
 
 void MGLevel::coarsen(occa::memory o_x, occa::memory o_Rx)
 {
-  
+  // the coarsest level holds dfloat vectors, restrict into pfloat scratch first
+  occa::memory o_RxPfloat = isCoarsest ? o_rhsPfloat : o_Rx;
+
   if (options.compareArgs("DISCRETIZATION","CONTINUOUS"))
-    platform->linAlg->axmy(mesh->Nelements * NpF, 1.0, o_invDegree, o_x);
+    elliptic->dotMultiplyPfloatKernel(mesh->Nelements * NpF, o_invDegree, o_x, o_x);
 
-  elliptic->precon->coarsenKernel(mesh->Nelements, o_R, o_x, o_Rx);
+  elliptic->precon->coarsenKernel(mesh->Nelements, o_R, o_x, o_RxPfloat);
 
   if (options.compareArgs("DISCRETIZATION","CONTINUOUS")) {
-    oogs::startFinish(o_Rx, elliptic->Nfields, elliptic->Ntotal, ogsDfloat, ogsAdd, elliptic->oogs);
-    if (elliptic->Nmasked) mesh->maskKernel(elliptic->Nmasked, elliptic->o_maskIds, o_Rx);
+    oogs::startFinish(o_RxPfloat, elliptic->Nfields, elliptic->Ntotal, ogsPfloat, ogsAdd, elliptic->oogs);
+    if (elliptic->Nmasked) mesh->maskPfloatKernel(elliptic->Nmasked, elliptic->o_maskIds, o_RxPfloat);
   }
+
+  if(isCoarsest) elliptic->copyPfloatToDPfloatKernel(Nrows, o_RxPfloat, o_Rx);
 }
 
 void MGLevel::prolongate(occa::memory o_x, occa::memory o_Px)
 {
-  elliptic->precon->prolongateKernel(mesh->Nelements, o_R, o_x, o_Px);
+  occa::memory o_xC = o_x;
+  if(isCoarsest) {
+    elliptic->copyDfloatToPfloatKernel(Nrows, o_xPfloat, o_x);
+    o_xC = o_xPfloat;
+  }
+  elliptic->precon->prolongateKernel(mesh->Nelements, o_R, o_xC, o_Px);
 }
 
 void MGLevel::smooth(occa::memory o_rhs, occa::memory o_x, bool x_is_zero)
 {
   if(!x_is_zero && stype == SCHWARZ) return;
-  if(!strstr(pfloatString,dfloatString)) {
+  if(isCoarsest && !strstr(pfloatString,dfloatString)) {
     elliptic->copyDfloatToPfloatKernel(Nrows, o_xPfloat, o_x);
     elliptic->copyDfloatToPfloatKernel(Nrows, o_rhsPfloat, o_rhs);
     if (stype == RICHARDSON)
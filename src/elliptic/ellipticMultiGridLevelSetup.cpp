@@ -61,6 +61,7 @@ MGLevel::MGLevel(elliptic_t* ellipticBase, dfloat lambda_, int Nc,
 
   o_xPfloat = platform->device.malloc(Nrows ,  sizeof(pfloat));
   o_rhsPfloat = platform->device.malloc(Nrows ,  sizeof(pfloat));
+  isCoarsest = false;
 }
 
 //build a level and connect it to the previous one
@@ -94,7 +95,9 @@ MGLevel::MGLevel(elliptic_t* ellipticBase, //finest level
     weight   = elliptic->invDegree;
 
     NpF = ellipticFine->mesh->Np;
-    o_invDegree = ellipticFine->ogs->o_invDegree;
+    const dlong NlocalF = ellipticFine->mesh->Nelements * NpF;
+    o_invDegree = platform->device.malloc(NlocalF * sizeof(pfloat));
+    elliptic->copyDfloatToPfloatKernel(NlocalF, o_invDegree, ellipticFine->ogs->o_invDegree);
   }
 
   this->setupSmoother(ellipticBase);
@@ -104,6 +107,7 @@ MGLevel::MGLevel(elliptic_t* ellipticBase, //finest level
 
   o_xPfloat = platform->device.malloc(Nrows ,  sizeof(pfloat));
   o_rhsPfloat = platform->device.malloc(Nrows ,  sizeof(pfloat));
+  isCoarsest = false;
 }
 
 void MGLevel::setupSmoother(elliptic_t* ellipticBase)
@@ -255,7 +259,10 @@ void MGLevel::buildCoarsenerQuadHex(mesh_t** meshLevels, int Nf, int Nc)
   for (int i = 0; i < NqCoarse; i++)
     for (int j = 0; j < NqFine; j++)
       R[i * NqFine + j] = P[j * NqCoarse + i];
-  o_R = platform->device.malloc(NqFine * NqCoarse * sizeof(dfloat), R);
+  std::vector<pfloat> casted_R(NqFine * NqCoarse);
+  for(int i = 0; i < NqFine * NqCoarse; ++i)
+    casted_R[i] = static_cast<pfloat>(R[i]);
+  o_R = platform->device.malloc(NqFine * NqCoarse * sizeof(pfloat), casted_R.data());
 
   free(P);
   free(Ptmp);
@@ -32,6 +32,8 @@
 #include <string>
 #include <sstream>
 #include <exception>
+#include <cstring>
+#include <cstdint>
 #include "platform.hpp"
 
 struct ElementLengths
@@ -520,17 +522,15 @@ void compute_1d_matrices(
   free(b);
 }
 
-void gen_operators(FDMOperators* op, ElementLengths* lengths, elliptic_t* elliptic)
+void gen_element_operators(dfloat* opSx,
+                           dfloat* opSy,
+                           dfloat* opSz,
+                           dfloat* opD,
+                           ElementLengths* lengths,
+                           const dlong e,
+                           elliptic_t* elliptic)
 {
   const int Nq_e = elliptic->mesh->Nq + 2;
-  const int Np_e = Nq_e * Nq_e * Nq_e;
-  const dlong Nelements = elliptic->mesh->Nelements;
-  op->Sx = (dfloat*) calloc(Nq_e * Nq_e * Nelements,sizeof(dfloat));
-  op->Sy = (dfloat*) calloc(Nq_e * Nq_e * Nelements,sizeof(dfloat));
-  op->Sz = (dfloat*) calloc(Nq_e * Nq_e * Nelements,sizeof(dfloat));
-  op->D = (dfloat*) calloc(Np_e * Nelements,sizeof(dfloat));
-
-#define df(a,b) (op->D[((a) + (b) * Np_e)])
   const double eps = 1e-5;
   dfloat* lr = (dfloat*) calloc(Nq_e,sizeof(dfloat));
   dfloat* ls = (dfloat*) calloc(Nq_e,sizeof(dfloat));
@@ -538,65 +538,62 @@ void gen_operators(FDMOperators* op, ElementLengths* lengths, elliptic_t* ellipt
   dfloat* Sx = (dfloat*) calloc(Nq_e * Nq_e,sizeof(dfloat));
   dfloat* Sy = (dfloat*) calloc(Nq_e * Nq_e,sizeof(dfloat));
   dfloat* Sz = (dfloat*) calloc(Nq_e * Nq_e,sizeof(dfloat));
-  for(dlong e = 0; e < Nelements; ++e) {
-    int lbr = -1, rbr = -1, lbs = -1, rbs = -1, lbt = -1, rbt = -1;
-    compute_element_boundary_conditions(&lbr,&rbr,&lbs,&rbs,&lbt,&rbt,e,elliptic);
-    compute_1d_matrices(Sx,
-                        lr,
-                        lbr,
-                        rbr,
-                        lengths->length_left_x[e],
-                        lengths->length_middle_x[e],
-                        lengths->length_right_x[e],
-                        e,
-                        elliptic,
-                        "r",
-                        Nq_e);
-    compute_1d_matrices(Sy,
-                        ls,
-                        lbs,
-                        rbs,
-                        lengths->length_left_y[e],
-                        lengths->length_middle_y[e],
-                        lengths->length_right_y[e],
-                        e,
-                        elliptic,
-                        "s",
-                        Nq_e);
-    compute_1d_matrices(Sz,
-                        lt,
-                        lbt,
-                        rbt,
-                        lengths->length_left_z[e],
-                        lengths->length_middle_z[e],
-                        lengths->length_right_z[e],
-                        e,
-                        elliptic,
-                        "t",
-                        Nq_e);
-    // store the transposes
-    for(int i = 0; i < Nq_e; ++i)
-      for(int j = 0; j < Nq_e; ++j) {
-        const int elem_offset = Nq_e * Nq_e * e;
-        const int ij = i + j * Nq_e;
-        const int ji = j + i * Nq_e;
-        op->Sx[elem_offset + ij] = Sx[ji];
-        op->Sy[elem_offset + ij] = Sy[ji];
-        op->Sz[elem_offset + ij] = Sz[ji];
+
+  int lbr = -1, rbr = -1, lbs = -1, rbs = -1, lbt = -1, rbt = -1;
+  compute_element_boundary_conditions(&lbr,&rbr,&lbs,&rbs,&lbt,&rbt,e,elliptic);
+  compute_1d_matrices(Sx,
+                      lr,
+                      lbr,
+                      rbr,
+                      lengths->length_left_x[e],
+                      lengths->length_middle_x[e],
+                      lengths->length_right_x[e],
+                      e,
+                      elliptic,
+                      "r",
+                      Nq_e);
+  compute_1d_matrices(Sy,
+                      ls,
+                      lbs,
+                      rbs,
+                      lengths->length_left_y[e],
+                      lengths->length_middle_y[e],
+                      lengths->length_right_y[e],
+                      e,
+                      elliptic,
+                      "s",
+                      Nq_e);
+  compute_1d_matrices(Sz,
+                      lt,
+                      lbt,
+                      rbt,
+                      lengths->length_left_z[e],
+                      lengths->length_middle_z[e],
+                      lengths->length_right_z[e],
+                      e,
+                      elliptic,
+                      "t",
+                      Nq_e);
+  // store the transposes
+  for(int i = 0; i < Nq_e; ++i)
+    for(int j = 0; j < Nq_e; ++j) {
+      const int ij = i + j * Nq_e;
+      const int ji = j + i * Nq_e;
+      opSx[ij] = Sx[ji];
+      opSy[ij] = Sy[ji];
+      opSz[ij] = Sz[ji];
+    }
+  unsigned l = 0;
+  for(int k = 0; k < Nq_e; ++k)
+    for(int j = 0; j < Nq_e; ++j)
+      for(int i = 0; i < Nq_e; ++i) {
+        const double diag = lr[i] + ls[j] + lt[k];
+        if(diag > eps)
+          opD[l] = 1.0 / diag;
+        else
+          opD[l] = 0.0;
+        l += 1;
       }
-    unsigned l = 0;
-    for(int k = 0; k < Nq_e; ++k)
-      for(int j = 0; j < Nq_e; ++j)
-        for(int i = 0; i < Nq_e; ++i) {
-          const double diag = lr[i] + ls[j] + lt[k];
-          if(diag > eps)
-            df(l,e) = 1.0 / diag;
-          else
-            df(l,e) = 0.0;
-          l += 1;
-        }
-  }
-#undef df
   free(lr);
   free(ls);
   free(lt);
@@ -605,6 +602,54 @@ void gen_operators(FDMOperators* op, ElementLengths* lengths, elliptic_t* ellipt
   free(Sz);
 }
 
+void gen_operators(FDMOperators* op, ElementLengths* lengths, elliptic_t* elliptic)
+{
+  const int Nq_e = elliptic->mesh->Nq + 2;
+  const int Np_e = Nq_e * Nq_e * Nq_e;
+  const dlong Nelements = elliptic->mesh->Nelements;
+  op->Sx = (dfloat*) calloc(Nq_e * Nq_e * Nelements,sizeof(dfloat));
+  op->Sy = (dfloat*) calloc(Nq_e * Nq_e * Nelements,sizeof(dfloat));
+  op->Sz = (dfloat*) calloc(Nq_e * Nq_e * Nelements,sizeof(dfloat));
+  op->D = (dfloat*) calloc(Np_e * Nelements,sizeof(dfloat));
+
+  for(dlong e = 0; e < Nelements; ++e)
+    gen_element_operators(op->Sx + Nq_e * Nq_e * e,
+                          op->Sy + Nq_e * Nq_e * e,
+                          op->Sz + Nq_e * Nq_e * e,
+                          op->D + Np_e * e,
+                          lengths,
+                          e,
+                          elliptic);
+}
+
+void free_element_lengths(ElementLengths* lengths)
+{
+  free(lengths->length_left_x);
+  free(lengths->length_left_y);
+  free(lengths->length_left_z);
+  free(lengths->length_middle_x);
+  free(lengths->length_middle_y);
+  free(lengths->length_middle_z);
+  free(lengths->length_right_x);
+  free(lengths->length_right_y);
+  free(lengths->length_right_z);
+  free(lengths);
+}
+
+// the nine lengths an element's FDM operator depends on
+void element_lengths(ElementLengths* lengths, const dlong e, dfloat* l)
+{
+  l[0] = lengths->length_left_x[e];
+  l[1] = lengths->length_middle_x[e];
+  l[2] = lengths->length_right_x[e];
+  l[3] = lengths->length_left_y[e];
+  l[4] = lengths->length_middle_y[e];
+  l[5] = lengths->length_right_y[e];
+  l[6] = lengths->length_left_z[e];
+  l[7] = lengths->length_middle_z[e];
+  l[8] = lengths->length_right_z[e];
+}
+
 mesh_t* create_extended_mesh(elliptic_t* elliptic, hlong* maskedGlobalIds)
 {
 
@@ -686,6 +731,31 @@ mesh_t* create_extended_mesh(elliptic_t* elliptic, hlong* maskedGlobalIds)
 }
 
 // convenience function
+// bfloat16: round-to-nearest-even upper half of the float, subnormals flushed to zero
+unsigned short float_to_bf16(const float f)
+{
+  uint32_t u;
+  memcpy(&u, &f, sizeof(u));
+  if((u & 0x7f800000) == 0) return (u >> 16) & 0x8000;
+  u += 0x7fff + ((u >> 16) & 1);
+  return u >> 16;
+}
+
+// upload FDM operator storage, allocating on first use
+void upload_fdm(occa::memory &o_op, const std::vector<pfloat> &op, const bool bf16)
+{
+  if(bf16) {
+    std::vector<unsigned short> opBF16(op.size());
+    for(size_t i = 0; i < op.size(); ++i)
+      opBF16[i] = float_to_bf16(static_cast<float>(op[i]));
+    if(!o_op.size()) o_op = platform->device.malloc(opBF16.size() * sizeof(unsigned short));
+    o_op.copyFrom(opBF16.data(), opBF16.size() * sizeof(unsigned short));
+  } else {
+    if(!o_op.size()) o_op = platform->device.malloc(op.size() * sizeof(pfloat));
+    o_op.copyFrom(op.data(), op.size() * sizeof(pfloat));
+  }
+}
+
 void to_reg(pfloat* arr1,
             pfloat* arr2,
             mesh_t* mesh)
@@ -792,9 +862,7 @@ void MGLevel::build(
   }
 
   const dlong Nelements = elliptic->mesh->Nelements;
-  const int N = elliptic->mesh->Nq;
   const int Nq = elliptic->mesh->Nq;
-  const int Np = elliptic->mesh->Np;
 
   overlap = false;
   const bool serial = (platform->device.mode() == "Serial" || platform->device.mode() == "OpenMP");
@@ -818,61 +886,56 @@ void MGLevel::build(
 
   ogs = (void*) elliptic->oogs;
 
+  if(overlap) setupOverlapElementLists();
+
   /** create the element lengths, using the most refined level **/
   ElementLengths* lengths = (ElementLengths*) calloc(1,sizeof(ElementLengths));
   compute_element_lengths(lengths, pSolver);
 
-  pfloat* casted_Sx = (pfloat*) calloc(Nq_e * Nq_e * Nelements, sizeof(pfloat));
-  pfloat* casted_Sy = (pfloat*) calloc(Nq_e * Nq_e * Nelements, sizeof(pfloat));
-  pfloat* casted_Sz = (pfloat*) calloc(Nq_e * Nq_e * Nelements, sizeof(pfloat));
-  pfloat* casted_D = (pfloat*) calloc(Np_e * Nelements, sizeof(pfloat));
-  pfloat* casted_wts = (pfloat*) calloc(N * N * N * Nelements, sizeof(pfloat));
+  // keep host copies around for partial rebuilds on moving meshes
+  fdmSx.resize(Nq_e * Nq_e * Nelements);
+  fdmSy.resize(Nq_e * Nq_e * Nelements);
+  fdmSz.resize(Nq_e * Nq_e * Nelements);
+  fdmInvL.resize(Np_e * Nelements);
+  fdmLengths.resize(9 * Nelements);
 
   FDMOperators* op = (FDMOperators*) calloc(1, sizeof(FDMOperators));
   gen_operators(op, lengths, elliptic);
   for(dlong i = 0; i < Nq_e * Nq_e * Nelements; ++i) {
-    casted_Sx[i] = static_cast < pfloat > (op->Sx[i]);
-    casted_Sy[i] = static_cast < pfloat > (op->Sy[i]);
-    casted_Sz[i] = static_cast < pfloat > (op->Sz[i]);
+    fdmSx[i] = static_cast < pfloat > (op->Sx[i]);
+    fdmSy[i] = static_cast < pfloat > (op->Sy[i]);
+    fdmSz[i] = static_cast < pfloat > (op->Sz[i]);
   }
   for(dlong i = 0; i < Np_e * Nelements; ++i)
-    casted_D[i] = static_cast < pfloat > (op->D[i]);
+    fdmInvL[i] = static_cast < pfloat > (op->D[i]);
+  for(dlong e = 0; e < Nelements; ++e)
+    element_lengths(lengths, e, fdmLengths.data() + 9 * e);
   free(op->Sx);
   free(op->Sy);
   free(op->Sz);
   free(op->D);
   free(op);
-  free(lengths->length_left_x);
-  free(lengths->length_left_y);
-  free(lengths->length_left_z);
-  free(lengths->length_middle_x);
-  free(lengths->length_middle_y);
-  free(lengths->length_middle_z);
-  free(lengths->length_right_x);
-  free(lengths->length_right_y);
-  free(lengths->length_right_z);
-  free(lengths);
-
-  const dlong weightSize = Np * Nelements;
-  o_Sx = platform->device.malloc  (Nq_e * Nq_e * Nelements * sizeof(pfloat));
-  o_Sy = platform->device.malloc  (Nq_e * Nq_e * Nelements * sizeof(pfloat));
-  o_Sz = platform->device.malloc  (Nq_e * Nq_e * Nelements * sizeof(pfloat));
-  o_invL = platform->device.malloc  (Nlocal_e * sizeof(pfloat));
+  free_element_lengths(lengths);
+
+  const bool bf16 = options.compareArgs("MULTIGRID SCHWARZ STORAGE", "BF16");
+  upload_fdm(o_Sx, fdmSx, bf16);
+  upload_fdm(o_Sy, fdmSy, bf16);
+  upload_fdm(o_Sz, fdmSz, bf16);
+  upload_fdm(o_invL, fdmInvL, bf16);
+  // host copies are only needed to refresh the FDM operators of a moving mesh
+  if(!platform->options.compareArgs("MOVING MESH", "TRUE")) {
+    std::vector<pfloat>().swap(fdmSx);
+    std::vector<pfloat>().swap(fdmSy);
+    std::vector<pfloat>().swap(fdmSz);
+    std::vector<pfloat>().swap(fdmInvL);
+    std::vector<dfloat>().swap(fdmLengths);
+  }
   o_work1 = platform->device.malloc  (Nlocal_e * sizeof(pfloat));
   if(!options.compareArgs("MULTIGRID SMOOTHER","RAS"))
     o_work2 = platform->device.malloc  (Nlocal_e * sizeof(pfloat));
-  o_Sx.copyFrom(casted_Sx, Nq_e * Nq_e * Nelements * sizeof(pfloat));
-  o_Sy.copyFrom(casted_Sy, Nq_e * Nq_e * Nelements * sizeof(pfloat));
-  o_Sz.copyFrom(casted_Sz, Nq_e * Nq_e * Nelements * sizeof(pfloat));
-  o_invL.copyFrom(casted_D, Nlocal_e * sizeof(pfloat));
 
   generate_weights();
 
-  free(casted_Sx);
-  free(casted_Sy);
-  free(casted_Sz);
-  free(casted_D);
-
   string install_dir;
   install_dir.assign(getenv("NEKRS_INSTALL_DIR"));
   const string oklpath = install_dir + "/okl/elliptic/";
@@ -884,6 +947,7 @@ void MGLevel::build(
       properties["defines/p_Nq_e"] = Nq_e;
       properties["defines/p_restrict"] = 0;
       properties["defines/p_overlap"] = (int) overlap;
+      properties["defines/p_fdmBF16"] = (int) bf16;
       if(options.compareArgs("MULTIGRID SMOOTHER","RAS"))
         properties["defines/p_restrict"] = 1;
 
@@ -898,45 +962,159 @@ void MGLevel::build(
   }
 }
 
+dlong MGLevel::updateSchwarz(elliptic_t* pSolver, dfloat tol)
+{
+  const dlong Nelements = elliptic->mesh->Nelements;
+  const int Nq_e = elliptic->mesh->Nq + 2;
+  const int Np_e = Nq_e * Nq_e * Nq_e;
+
+  ElementLengths* lengths = (ElementLengths*) calloc(1,sizeof(ElementLengths));
+  compute_element_lengths(lengths, pSolver);
+
+  std::vector<dfloat> Sx(Nq_e * Nq_e), Sy(Nq_e * Nq_e), Sz(Nq_e * Nq_e), D(Np_e);
+  dlong Nupdated = 0;
+  for(dlong e = 0; e < Nelements; ++e) {
+    dfloat l[9];
+    element_lengths(lengths, e, l);
+
+    dfloat change = 0;
+    for(int i = 0; i < 9; ++i) {
+      const dfloat lOld = fdmLengths[9 * e + i];
+      change = std::max(change, std::abs(l[i] - lOld) / std::abs(lOld));
+    }
+    if(change <= tol) continue;
+
+    gen_element_operators(Sx.data(), Sy.data(), Sz.data(), D.data(), lengths, e, elliptic);
+    for(int i = 0; i < Nq_e * Nq_e; ++i) {
+      fdmSx[Nq_e * Nq_e * e + i] = static_cast < pfloat > (Sx[i]);
+      fdmSy[Nq_e * Nq_e * e + i] = static_cast < pfloat > (Sy[i]);
+      fdmSz[Nq_e * Nq_e * e + i] = static_cast < pfloat > (Sz[i]);
+    }
+    for(int i = 0; i < Np_e; ++i)
+      fdmInvL[Np_e * e + i] = static_cast < pfloat > (D[i]);
+    for(int i = 0; i < 9; ++i)
+      fdmLengths[9 * e + i] = l[i];
+    Nupdated++;
+  }
+  free_element_lengths(lengths);
+
+  if(Nupdated) {
+    const bool bf16 = options.compareArgs("MULTIGRID SCHWARZ STORAGE", "BF16");
+    upload_fdm(o_Sx, fdmSx, bf16);
+    upload_fdm(o_Sy, fdmSy, bf16);
+    upload_fdm(o_Sz, fdmSz, bf16);
+    upload_fdm(o_invL, fdmInvL, bf16);
+  }
+
+  return Nupdated;
+}
+
+void MGLevel::setupOverlapElementLists()
+{
+  const dlong Nelements = mesh->Nelements;
+  const int Np_e = (mesh->Nq + 2) * (mesh->Nq + 2) * (mesh->Nq + 2);
+  ogs_t* ogsExt = ((oogs_t*) extendedOgs)->ogs;
+
+  // flag elements having nodes on the extended mesh halo
+  std::vector<int> isExtendedHalo(Nelements, 0);
+  if(ogsExt->NhaloGather)
+    for(dlong n = 0; n < ogsExt->haloGatherOffsets[ogsExt->NhaloGather]; ++n)
+      isExtendedHalo[ogsExt->haloGatherIds[n] / Np_e] = 1;
+
+  std::vector<int> isGlobal(Nelements, 0);
+  for(dlong n = 0; n < mesh->NglobalGatherElements; ++n)
+    isGlobal[mesh->globalGatherElementList[n]] = 1;
+
+  std::vector<dlong> extendedGlobal, extendedLocal, interior, shell;
+  for(dlong e = 0; e < Nelements; ++e) {
+    if(isExtendedHalo[e]) extendedGlobal.push_back(e);
+    else extendedLocal.push_back(e);
+
+    if(isGlobal[e]) continue;
+    if(isExtendedHalo[e]) shell.push_back(e);
+    else interior.push_back(e);
+  }
+
+  auto upload = [](const std::vector<dlong>& list, occa::memory& o_list, dlong& N)
+  {
+    N = list.size();
+    if(N) o_list = platform->device.malloc(N * sizeof(dlong), list.data());
+  };
+  upload(extendedGlobal, o_extendedGlobalElementList, NextendedGlobalElements);
+  upload(extendedLocal, o_extendedLocalElementList, NextendedLocalElements);
+  upload(interior, o_interiorElementList, NinteriorElements);
+  upload(shell, o_shellElementList, NshellElements);
+}
+
 void MGLevel::smoothSchwarz(occa::memory& o_u, occa::memory& o_Su, bool xIsZero)
 {
   const char* ogsDataTypeString =
     (strstr(ogsPfloat,"float") && options.compareArgs("ENABLE FLOATCOMMHALF GS SUPPORT","TRUE")) ?
     ogsFloatCommHalf : ogsPfloat;
   const dlong Nelements = elliptic->mesh->Nelements;
-  preFDMKernel(Nelements, o_u, o_work1);
+  const bool RAS = options.compareArgs("MULTIGRID SMOOTHER","RAS");
 
-  oogs::startFinish(o_work1, 1, 0, ogsDataTypeString, ogsAdd, (oogs_t*) extendedOgs);
+  if(!overlap){
+    preFDMKernel(Nelements,NextendedGlobalElements,o_extendedGlobalElementList,o_u,o_work1);
+    oogs::startFinish(o_work1, 1, 0, ogsDataTypeString, ogsAdd, (oogs_t*) extendedOgs);
 
-  if(options.compareArgs("MULTIGRID SMOOTHER","RAS")) {
-    if(!overlap){
+    if(RAS) {
       fusedFDMKernel(Nelements,mesh->NglobalGatherElements,mesh->o_globalGatherElementList,
                      o_Su,o_Sx,o_Sy,o_Sz,o_invL,elliptic->o_invDegree,o_work1);
-    } else if(overlap && mesh->NglobalGatherElements){
+      oogs::startFinish(o_Su, 1, 0, ogsDataTypeString, ogsAdd, (oogs_t*) ogs);
+    } else {
       fusedFDMKernel(Nelements,mesh->NglobalGatherElements,mesh->o_globalGatherElementList,
-                     o_Su,o_Sx,o_Sy,o_Sz,o_invL,elliptic->o_invDegree,o_work1);
+                     o_work2,o_Sx,o_Sy,o_Sz,o_invL,o_work1);
+      oogs::startFinish(o_work2, 1, 0, ogsDataTypeString, ogsAdd, (oogs_t*) extendedOgs);
+      postFDMKernel(Nelements,o_work1,o_work2,o_Su, o_wts);
+      oogs::startFinish(o_Su, 1, 0, ogsDataTypeString, ogsAdd, (oogs_t*) ogs);
     }
+    return;
+  }
+
+  // elements touching the extended halo go first, the remaining ones
+  // are processed while the extended exchange is in flight
+  if(NextendedGlobalElements)
+    preFDMKernel(Nelements,NextendedGlobalElements,o_extendedGlobalElementList,o_u,o_work1);
+
+  oogs::start(o_work1, 1, 0, ogsDataTypeString, ogsAdd, (oogs_t*) extendedOgs);
+
+  if(NextendedLocalElements)
+    preFDMKernel(Nelements,NextendedLocalElements,o_extendedLocalElementList,o_u,o_work1);
+
+  if(RAS) {
+    auto interiorFDM = [&]()
+    {
+      if(NinteriorElements)
+        fusedFDMKernel(Nelements,NinteriorElements,o_interiorElementList,
+                       o_Su,o_Sx,o_Sy,o_Sz,o_invL,elliptic->o_invDegree,o_work1);
+    };
+    oogs::finish(o_work1, 1, 0, ogsDataTypeString, ogsAdd, (oogs_t*) extendedOgs, interiorFDM);
+
+    if(mesh->NglobalGatherElements)
+      fusedFDMKernel(Nelements,mesh->NglobalGatherElements,mesh->o_globalGatherElementList,
+                     o_Su,o_Sx,o_Sy,o_Sz,o_invL,elliptic->o_invDegree,o_work1);
 
     oogs::start(o_Su, 1, 0, ogsDataTypeString, ogsAdd, (oogs_t*) ogs);
 
-    if(overlap && mesh->NlocalGatherElements)
-      fusedFDMKernel(Nelements,mesh->NlocalGatherElements,mesh->o_localGatherElementList,
+    if(NshellElements)
+      fusedFDMKernel(Nelements,NshellElements,o_shellElementList,
                      o_Su,o_Sx,o_Sy,o_Sz,o_invL,elliptic->o_invDegree,o_work1);
 
     oogs::finish(o_Su, 1, 0, ogsDataTypeString, ogsAdd, (oogs_t*) ogs);
   } else {
-    if(!overlap){
-      fusedFDMKernel(Nelements,mesh->NglobalGatherElements,mesh->o_globalGatherElementList,
-                     o_work2,o_Sx,o_Sy,o_Sz,o_invL,o_work1);
-    } else if(overlap && mesh->NglobalGatherElements){
-      fusedFDMKernel(Nelements,mesh->NglobalGatherElements,mesh->o_globalGatherElementList,
+    oogs::finish(o_work1, 1, 0, ogsDataTypeString, ogsAdd, (oogs_t*) extendedOgs);
+
+    // the solves writing to the extended halo feed the second exchange,
+    // the local ones run while it is in flight
+    if(NextendedGlobalElements)
+      fusedFDMKernel(Nelements,NextendedGlobalElements,o_extendedGlobalElementList,
                      o_work2,o_Sx,o_Sy,o_Sz,o_invL,o_work1);
-    }
 
     oogs::start(o_work2, 1, 0, ogsDataTypeString, ogsAdd, (oogs_t*) extendedOgs);
 
-    if(overlap && mesh->NlocalGatherElements)
-      fusedFDMKernel(Nelements,mesh->NlocalGatherElements,mesh->o_localGatherElementList,
+    if(NextendedLocalElements)
+      fusedFDMKernel(Nelements,NextendedLocalElements,o_extendedLocalElementList,
                      o_work2,o_Sx,o_Sy,o_Sz,o_invL,o_work1);
 
     oogs::finish(o_work2, 1, 0, ogsDataTypeString, ogsAdd, (oogs_t*) extendedOgs);
@@ -27,6 +27,33 @@
 #include "elliptic.h"
 #include "platform.hpp"
 
+// assemble the degree 1 operator in COO format (globally indexed, row sorted)
+void ellipticMultiGridCoarseMatrix(elliptic_t* ellipticCoarse, elliptic_t* ellipticFine, dfloat lambda,
+                                   hlong* coarseGlobalStarts, dlong* nnz,
+                                   hlong** Rows, hlong** Cols, dfloat** Vals)
+{
+  nonZero_t* coarseA;
+  ogs_t* coarseogs;
+
+  if(ellipticFine->options.compareArgs("GALERKIN COARSE OPERATOR","TRUE"))
+    ellipticBuildContinuousGalerkinHex3D(ellipticCoarse,ellipticFine,lambda,&coarseA,nnz,
+                                         &coarseogs,coarseGlobalStarts);
+  else
+    ellipticBuildContinuous(ellipticCoarse, &coarseA, nnz,&coarseogs,
+                            coarseGlobalStarts);
+
+  *Rows = (hlong*) calloc(*nnz, sizeof(hlong));
+  *Cols = (hlong*) calloc(*nnz, sizeof(hlong));
+  *Vals = (dfloat*) calloc(*nnz,sizeof(dfloat));
+
+  for (dlong i = 0; i < *nnz; i++) {
+    (*Rows)[i] = coarseA[i].row;
+    (*Cols)[i] = coarseA[i].col;
+    (*Vals)[i] = coarseA[i].val;
+  }
+  free(coarseA);
+}
+
 void ellipticMultiGridSetup(elliptic_t* elliptic_, precon_t* precon)
 {
   
@@ -74,6 +101,13 @@ void ellipticMultiGridSetup(elliptic_t* elliptic_, precon_t* precon)
   precon->parAlmond = parAlmond::Init(platform->device, platform->comm.mpiComm, options);
   parAlmond::multigridLevel** levels = precon->parAlmond->levels;
 
+  if (sizeof(pfloat) != sizeof(dfloat) &&
+      (precon->parAlmond->exact || precon->parAlmond->ctype != parAlmond::VCYCLE)) {
+    if(platform->comm.mpiRank == 0)
+      printf("ERROR: pMG levels are %s, only VCYCLE is supported!\n", pfloatString);
+    ABORT(EXIT_FAILURE);
+  }
+
   oogs_mode oogsMode = OOGS_AUTO;
   //if(platform->device.mode() == "Serial" || platform->device.mode() == "OpenMP") oogsMode = OOGS_DEFAULT;
 
@@ -134,9 +168,7 @@ void ellipticMultiGridSetup(elliptic_t* elliptic_, precon_t* precon)
   }
 
   /* build degree 1 problem and pass to AMG */
-  nonZero_t* coarseA;
   dlong nnzCoarseA;
-  ogs_t* coarseogs;
 
   //set up the base level
   elliptic_t* ellipticCoarse;
@@ -168,23 +200,11 @@ void ellipticMultiGridSetup(elliptic_t* elliptic_, precon_t* precon)
 
   hlong* coarseGlobalStarts = (hlong*) calloc(platform->comm.mpiCommSize + 1, sizeof(hlong));
 
-  if(options.compareArgs("GALERKIN COARSE OPERATOR","TRUE"))
-    ellipticBuildContinuousGalerkinHex3D(ellipticCoarse,elliptic,lambda,&coarseA,&nnzCoarseA,
-                                         &coarseogs,coarseGlobalStarts);
-  else
-    ellipticBuildContinuous(ellipticCoarse, &coarseA, &nnzCoarseA,&coarseogs,
-                            coarseGlobalStarts);
-
-  hlong* Rows = (hlong*) calloc(nnzCoarseA, sizeof(hlong));
-  hlong* Cols = (hlong*) calloc(nnzCoarseA, sizeof(hlong));
-  dfloat* Vals = (dfloat*) calloc(nnzCoarseA,sizeof(dfloat));
-
-  for (dlong i = 0; i < nnzCoarseA; i++) {
-    Rows[i] = coarseA[i].row;
-    Cols[i] = coarseA[i].col;
-    Vals[i] = coarseA[i].val;
-  }
-  free(coarseA);
+  hlong* Rows;
+  hlong* Cols;
+  dfloat* Vals;
+  ellipticMultiGridCoarseMatrix(ellipticCoarse, elliptic, lambda, coarseGlobalStarts,
+                                &nnzCoarseA, &Rows, &Cols, &Vals);
 
   // build amg starting at level N=1
   parAlmond::AMGSetup(precon->parAlmond,
@@ -219,9 +239,16 @@ void ellipticMultiGridSetup(elliptic_t* elliptic_, precon_t* precon)
     levels[numMGLevels - 1] = new MGLevel(ellipticCoarse, lambda, Nmin, options,
                                           precon->parAlmond->ktype, platform->comm.mpiComm);
   }
+  ((MGLevel*) levels[numMGLevels - 1])->isCoarsest = true;
   MGLevelAllocateStorage((MGLevel*) levels[numMGLevels - 1], numMGLevels - 1,
                          precon->parAlmond->ctype);
 
+  // pfloat entry/exit of the V-cycle
+  if (Nmax > Nmin) {
+    precon->o_rPfloat = platform->device.malloc(levels[0]->Nrows * sizeof(pfloat));
+    precon->o_zPfloat = platform->device.malloc(levels[0]->Ncols * sizeof(pfloat));
+  }
+
   //tell parAlmond to gather when going to the next level
   if (options.compareArgs("DISCRETIZATION","CONTINUOUS")) {
     if (precon->parAlmond->numLevels > numMGLevels) {
@@ -303,13 +330,16 @@ void MGLevelAllocateStorage(MGLevel* level, int k, parAlmond::CycleType ctype)
     MGLevel::smootherResidualBytes = Nbytes;
   }
 
+  // the hierarchy runs in pfloat, only the coarsest level talks to the coarse solver in dfloat
+  const size_t wordSize = level->isCoarsest ? sizeof(dfloat) : sizeof(pfloat);
+
   if (k) level->x    = (dfloat*) calloc(level->Ncols,sizeof(dfloat));
   if (k) level->rhs  = (dfloat*) calloc(level->Nrows,sizeof(dfloat));
-  if (k) level->o_x   = platform->device.malloc(level->Ncols * sizeof(dfloat),level->x);
-  if (k) level->o_rhs = platform->device.malloc(level->Nrows * sizeof(dfloat),level->rhs);
+  if (k) level->o_x   = platform->device.malloc(level->Ncols * wordSize,level->x);
+  if (k) level->o_rhs = platform->device.malloc(level->Nrows * wordSize,level->rhs);
 
   level->res  = (dfloat*) calloc(level->Ncols,sizeof(dfloat));
-  level->o_res = platform->device.malloc(level->Ncols * sizeof(dfloat),level->res);
+  level->o_res = platform->device.malloc(level->Ncols * wordSize,level->res);
 
   //kcycle vectors
   if (ctype == parAlmond::KCYCLE) {
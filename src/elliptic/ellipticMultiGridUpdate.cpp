@@ -0,0 +1,209 @@
+/*
+
+   The MIT License (MIT)
+
+   Copyright (c) 2017 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software and associated documentation files (the "Software"), to deal
+   in the Software without restriction, including without limitation the rights
+   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+   copies of the Software, and to permit persons to whom the Software is
+   furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in all
+   copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+   SOFTWARE.
+
+ */
+
+#include "elliptic.h"
+#include "platform.hpp"
+
+namespace {
+int Nsteps = 0;
+int NiterSum = 0;
+hlong NupdatedFDM = 0;
+}
+
+// recompute the geometric factors of a coarse level from the fine-level coordinates
+void MGLevel::updateGeometry(elliptic_t* ellipticFine)
+{
+  mesh_t* meshF = ellipticFine->mesh;
+
+  if(mesh != meshF) {
+    const dlong Nlocal = mesh->Nelements * mesh->Np;
+
+    if(!geometricFactorsKernel.isInitialized()) {
+      std::vector<dfloat> I(mesh->Nq * meshF->Nq);
+      InterpolationMatrix1D(meshF->N, meshF->Nq, meshF->gllz, mesh->Nq, mesh->gllz, I.data());
+      o_interpFine = platform->device.malloc(I.size() * sizeof(dfloat), I.data());
+
+      o_xyz = platform->device.malloc(3 * Nlocal * sizeof(dfloat));
+      o_geomWeights = platform->device.malloc(mesh->Nq * sizeof(dfloat), mesh->gllw);
+      o_geomWrk = platform->device.malloc(2 * Nlocal * sizeof(dfloat));
+
+      std::string install_dir;
+      install_dir.assign(getenv("NEKRS_INSTALL_DIR"));
+      const std::string oklpath = install_dir + "/okl/mesh/";
+
+      occa::properties kernelInfo = platform->kernelInfo;
+      kernelInfo["defines/p_NqIn"] = meshF->Nq;
+      kernelInfo["defines/p_NqOut"] = mesh->Nq;
+      kernelInfo["defines/p_NqMax"] = std::max(meshF->Nq, mesh->Nq);
+      kernelInfo["defines/p_NpIn"] = meshF->Np;
+      kernelInfo["defines/p_NpOut"] = mesh->Np;
+      interpolateKernel = platform->device.buildKernel(oklpath + "interpolateHex3D.okl",
+                                                       "interpolateHex3D", kernelInfo);
+
+      // no cubature on the coarse levels, the cubature block is skipped (ifcub = 0)
+      kernelInfo = ellipticKernelInfo(mesh);
+      kernelInfo["defines/" "p_IJWID"] = IJWID;
+      kernelInfo["defines/" "p_cubNq"] = mesh->Nq;
+      kernelInfo["defines/" "p_cubNp"] = mesh->Np;
+      geometricFactorsKernel = platform->device.buildKernel(oklpath + "geometricFactorsHex3D.okl",
+                                                            "geometricFactorsHex3D", kernelInfo);
+    }
+
+    const size_t offset = Nlocal * sizeof(dfloat);
+    interpolateKernel(mesh->Nelements, o_interpFine, meshF->o_x, o_xyz);
+    interpolateKernel(mesh->Nelements, o_interpFine, meshF->o_y, o_xyz + offset);
+    interpolateKernel(mesh->Nelements, o_interpFine, meshF->o_z, o_xyz + 2 * offset);
+
+    geometricFactorsKernel(mesh->Nelements,
+                           0,
+                           mesh->o_D,
+                           o_geomWeights,
+                           o_xyz,
+                           o_xyz + offset,
+                           o_xyz + 2 * offset,
+                           mesh->o_D,
+                           o_geomWeights,
+                           o_geomWrk,
+                           mesh->o_vgeo,
+                           mesh->o_ggeo,
+                           mesh->o_vgeo,
+                           o_geomWrk + offset);
+  }
+
+  if(!strstr(pfloatString,dfloatString))
+    elliptic->copyDfloatToPfloatKernel(mesh->Nelements * mesh->Np * mesh->Nggeo,
+                                       mesh->o_ggeoPfloat,
+                                       mesh->o_ggeo);
+}
+
+// rebuild Jacobi diagonal and eigenvalue bounds, mirrors setupSmoother
+void MGLevel::updateSmoother()
+{
+  // host geometry is used by the assembled diagonal and the coarse grid operator
+  mesh->o_ggeo.copyTo(mesh->ggeo, mesh->Nelements * mesh->Np * mesh->Nggeo * sizeof(dfloat));
+
+  if (degree == 1) return;
+
+  const dlong Nlocal = mesh->Np * mesh->Nelements;
+  std::vector<pfloat> casted_invDiagA(Nlocal, 0.0);
+  if(o_invDiagA.size()) {
+    dfloat* invDiagA;
+    ellipticBuildJacobi(elliptic,&invDiagA);
+    for(dlong i = 0; i < Nlocal; ++i)
+      casted_invDiagA[i] = static_cast<pfloat>(invDiagA[i]);
+    o_invDiagA.copyFrom(casted_invDiagA.data(), Nlocal * sizeof(pfloat));
+    free(invDiagA);
+  }
+
+  if(stype == CHEBYSHEV) {
+    dfloat rho = this->maxEigSmoothAx();
+    lambda1 = 1.1 * rho;
+    lambda0 = rho / 10.;
+  } else if(stype == RICHARDSON) {
+    dfloat rho = this->maxEigSmoothAx();
+    lambda0 = (4. / 3.) / rho;
+    for (dlong n = 0; n < Nlocal; n++)
+      casted_invDiagA[n] *= static_cast<pfloat>(lambda0);
+    o_invDiagA.copyFrom(casted_invDiagA.data(), Nlocal * sizeof(pfloat));
+  }
+}
+
+// refresh the p-multigrid hierarchy after the mesh has moved
+void ellipticMultiGridUpdate(elliptic_t* elliptic)
+{
+  if(!elliptic->options.compareArgs("PRECONDITIONER", "MULTIGRID")) return;
+
+  platform->timer.tic("preconditioner refresh", 1);
+  const double tStart = MPI_Wtime();
+
+  int refreshInterval = 0;
+  elliptic->options.getArgs("MULTIGRID REFRESH INTERVAL", refreshInterval);
+  dfloat tol = 0.05;
+  elliptic->options.getArgs("MULTIGRID REFRESH TOLERANCE", tol);
+
+  parAlmond::solver_t* M = elliptic->precon->parAlmond;
+  MGLevel* fineLevel = (MGLevel*) M->levels[0];
+  elliptic_t* ellipticFine = fineLevel->elliptic;
+  mesh_t* meshF = ellipticFine->mesh;
+
+  Nsteps++;
+  NiterSum += elliptic->Niter;
+
+  // Schwarz element lengths are computed from the host coordinates
+  bool schwarz = false;
+  for(int lev = 0; lev < M->numLevels; lev++) {
+    MGLevel* level = (MGLevel*) M->levels[lev];
+    schwarz |= level->degree != 1 && level->o_invL.size() > 0;
+  }
+  if(schwarz) {
+    const size_t Nbytes = meshF->Nelements * meshF->Np * sizeof(dfloat);
+    meshF->o_x.copyTo(meshF->x, Nbytes);
+    meshF->o_y.copyTo(meshF->y, Nbytes);
+    meshF->o_z.copyTo(meshF->z, Nbytes);
+  }
+
+  for(int lev = 0; lev < M->numLevels; lev++) {
+    MGLevel* level = (MGLevel*) M->levels[lev];
+    level->updateGeometry(ellipticFine);
+    if(level->degree != 1 && level->o_invL.size() > 0)
+      NupdatedFDM += level->updateSchwarz(ellipticFine, tol);
+  }
+
+  const bool refresh = refreshInterval > 0 && Nsteps % refreshInterval == 0;
+  if(refresh) {
+    for(int lev = 0; lev < M->numLevels; lev++)
+      ((MGLevel*) M->levels[lev])->updateSmoother();
+
+    MGLevel* coarseLevel = (MGLevel*) M->levels[M->numLevels - 1];
+    hlong* coarseGlobalStarts = (hlong*) calloc(platform->comm.mpiCommSize + 1, sizeof(hlong));
+    dlong nnz;
+    hlong* Rows;
+    hlong* Cols;
+    dfloat* Vals;
+    ellipticMultiGridCoarseMatrix(coarseLevel->elliptic, ellipticFine, coarseLevel->lambda,
+                                  coarseGlobalStarts, &nnz, &Rows, &Cols, &Vals);
+    const dlong Nrows = (dlong) (coarseGlobalStarts[platform->comm.mpiRank + 1] -
+                                 coarseGlobalStarts[platform->comm.mpiRank]);
+    M->coarseLevel->setup(Nrows, coarseGlobalStarts, nnz, Rows, Cols, Vals, ellipticFine->allNeumann);
+    free(Rows);
+    free(Cols);
+    free(Vals);
+    free(coarseGlobalStarts);
+  }
+
+  platform->timer.toc("preconditioner refresh");
+
+  if(refresh) {
+    const double elapsed = MPI_Wtime() - tStart;
+    MPI_Allreduce(MPI_IN_PLACE, &NupdatedFDM, 1, MPI_HLONG, MPI_SUM, platform->comm.mpiComm);
+    if(platform->comm.mpiRank == 0)
+      printf("multigrid refresh: %lld FDM element updates, avg. iterations since last refresh %.1f, %gs\n",
+             (long long) NupdatedFDM, (double) NiterSum / Nsteps, elapsed);
+    Nsteps = 0;
+    NiterSum = 0;
+    NupdatedFDM = 0;
+  }
+}
@@ -50,8 +50,9 @@ void ellipticAx(elliptic_t* elliptic,
     bool valid = true;
     valid &= continuous;
     if(!strstr(precision, dfloatString)) {
-      valid &= !elliptic->var_coeff;
-      valid &= !elliptic->blockSolver;
+      // the mixed-precision solver provides FP32 variable coefficient / block kernels
+      valid &= !elliptic->var_coeff || elliptic->mixedPrecision;
+      valid &= !elliptic->blockSolver || (elliptic->mixedPrecision && !elliptic->stressForm);
       if(!serial) {
         valid &= mapType == 0;
         valid &= integrationType == 0;
@@ -73,33 +74,38 @@ void ellipticAx(elliptic_t* elliptic,
     }
   }
 
+  const bool pfloatPrecision = !strstr(precision, dfloatString);
+  occa::memory &o_ggeoVar = pfloatPrecision ? mesh->o_ggeoPfloat : mesh->o_ggeo;
+  occa::memory &o_DVar = pfloatPrecision ? mesh->o_DPfloat : mesh->o_D;
+  occa::memory &o_DTVar = pfloatPrecision ? mesh->o_DTPfloat : mesh->o_DT;
+  occa::memory &o_lambda = pfloatPrecision ? elliptic->o_lambdaPfloat : elliptic->o_lambda;
+
   if(serial) {
+    occa::kernel &AxKernel = pfloatPrecision ? elliptic->AxPfloatKernel : elliptic->AxKernel;
     if(continuous) {
       if(elliptic->var_coeff) {
         if(elliptic->blockSolver) {
-          occa::memory & o_geom_factors = elliptic->stressForm ? mesh->o_vgeo : mesh->o_ggeo;
           if(!elliptic->stressForm)
-            elliptic->AxKernel(mesh->Nelements, elliptic->Ntotal, elliptic->loffset, o_geom_factors,
-                               mesh->o_D, mesh->o_DT, elliptic->o_lambda,
-                               o_q, o_Aq);
+            AxKernel(mesh->Nelements, elliptic->Ntotal, elliptic->loffset, o_ggeoVar,
+                     o_DVar, o_DTVar, o_lambda,
+                     o_q, o_Aq);
           else
-            elliptic->AxStressKernel(mesh->Nelements, elliptic->Ntotal, elliptic->loffset, o_geom_factors,
+            elliptic->AxStressKernel(mesh->Nelements, elliptic->Ntotal, elliptic->loffset, mesh->o_vgeo,
                                      mesh->o_D, mesh->o_DT, elliptic->o_lambda,
                                      o_q, o_Aq);
         }else {
-          elliptic->AxKernel(mesh->Nelements, elliptic->Ntotal, mesh->o_ggeo, mesh->o_D,
-                             mesh->o_DT, elliptic->o_lambda, o_q, o_Aq);
+          AxKernel(mesh->Nelements, elliptic->Ntotal, o_ggeoVar, o_DVar,
+                   o_DTVar, o_lambda, o_q, o_Aq);
         }
       }else{
         const dfloat lambda = elliptic->lambda[0];
         if(elliptic->blockSolver) {
-          occa::memory & o_geom_factors = elliptic->stressForm ? mesh->o_vgeo : mesh->o_ggeo;
           if(!elliptic->stressForm)
-            elliptic->AxKernel(mesh->Nelements, elliptic->Ntotal, elliptic->loffset, o_geom_factors,
-                               mesh->o_D, mesh->o_DT, elliptic->o_lambda,
-                               o_q, o_Aq);
+            AxKernel(mesh->Nelements, elliptic->Ntotal, elliptic->loffset, o_ggeoVar,
+                     o_DVar, o_DTVar, o_lambda,
+                     o_q, o_Aq);
           else
-            elliptic->AxStressKernel(mesh->Nelements, elliptic->Ntotal, elliptic->loffset, o_geom_factors,
+            elliptic->AxStressKernel(mesh->Nelements, elliptic->Ntotal, elliptic->loffset, mesh->o_vgeo,
                                      mesh->o_D, mesh->o_DT, elliptic->o_lambda,
                                      o_q, o_Aq);
         }else {
@@ -126,39 +132,39 @@ void ellipticAx(elliptic_t* elliptic,
         if(mapType == 0) {
           if(elliptic->var_coeff) {
             if(elliptic->blockSolver) {
-              occa::memory & o_geom_factors = elliptic->stressForm ? mesh->o_vgeo : mesh->o_ggeo;
+              occa::memory & o_geom_factors = elliptic->stressForm ? mesh->o_vgeo : o_ggeoVar;
               partialAxKernel(NelementsList,
                               elliptic->Ntotal,
                               elliptic->loffset,
                               o_elementsList,
                               o_geom_factors,
-                              mesh->o_D,
-                              mesh->o_DT,
-                              elliptic->o_lambda,
+                              o_DVar,
+                              o_DTVar,
+                              o_lambda,
                               o_q,
                               o_Aq);
             }else {
               partialAxKernel(NelementsList,
                               elliptic->Ntotal,
                               o_elementsList,
-                              mesh->o_ggeo,
-                              mesh->o_D,
-                              mesh->o_DT,
-                              elliptic->o_lambda,
+                              o_ggeoVar,
+                              o_DVar,
+                              o_DTVar,
+                              o_lambda,
                               o_q,
                               o_Aq);
             }
           }else{
             if(elliptic->blockSolver) {
-              occa::memory & o_geom_factors = elliptic->stressForm ? mesh->o_vgeo : mesh->o_ggeo;
+              occa::memory & o_geom_factors = elliptic->stressForm ? mesh->o_vgeo : o_ggeoVar;
               partialAxKernel(NelementsList,
                               elliptic->Ntotal,
                               elliptic->loffset,
                               o_elementsList,
                               o_geom_factors,
-                              mesh->o_D,
-                              mesh->o_DT,
-                              elliptic->o_lambda,
+                              o_DVar,
+                              o_DTVar,
+                              o_lambda,
                               o_q,
                               o_Aq);
             }else {
@@ -49,6 +49,10 @@ struct precon_t
   occa::memory o_Gz;
   occa::memory o_Sr;
 
+  // pfloat multigrid input/output (finest level)
+  occa::memory o_rPfloat;
+  occa::memory o_zPfloat;
+
   occa::memory o_vmapPP;
   occa::memory o_faceNodesP;
 
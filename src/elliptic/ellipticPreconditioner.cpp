@@ -51,7 +51,14 @@ void ellipticPreconditioner(elliptic_t* elliptic, occa::memory &o_r, occa::memor
     );
   }else if (options.compareArgs("PRECONDITIONER", "MULTIGRID")) {
     platform->timer.tic("mg preconditioner", 1);
-    parAlmond::Precon(precon->parAlmond, o_z, o_r);
+    if(precon->o_rPfloat.size()) {
+      // V-cycle runs in pfloat, convert at fine level entry/exit only
+      elliptic->copyDfloatToPfloatKernel(Nlocal, precon->o_rPfloat, o_r);
+      parAlmond::Precon(precon->parAlmond, precon->o_zPfloat, precon->o_rPfloat);
+      elliptic->copyPfloatToDPfloatKernel(Nlocal, precon->o_zPfloat, o_z);
+    } else {
+      parAlmond::Precon(precon->parAlmond, o_z, o_r);
+    }
     platform->timer.toc("mg preconditioner");
   }else {
     if(platform->comm.mpiRank == 0) printf("ERRROR: Unknown preconditioner\n");
@@ -54,7 +54,7 @@ void ResidualProjection::updateProjectionSpace()
     o_invDegree,
     o_xx,
     o_bb,
-    platform->comm.mpiComm,
+    comm,
     alpha,
     Nfields * (numVecsProjection-1) * fieldOffset
   );
@@ -98,7 +98,7 @@ void ResidualProjection::computePreProjection(occa::memory& o_r)
     o_invDegree,
     o_xx,
     o_r,
-    platform->comm.mpiComm,
+    comm,
     alpha,
     Nfields * 0 * fieldOffset
   );
@@ -153,7 +153,8 @@ ResidualProjection::ResidualProjection(elliptic_t& elliptic,
   Nfields(elliptic.Nfields),
   o_invDegree(elliptic.mesh->ogs->o_invDegree),
   o_rtmp(elliptic.o_rtmp),
-  o_Ap(elliptic.o_Ap)
+  o_Ap(elliptic.o_Ap),
+  comm(elliptic.comm)
 {
   platform_t* platform = platform_t::getInstance();
   timestep = 0;
@@ -201,4 +202,16 @@ void ResidualProjection::post(occa::memory& o_x)
   if(timestep < numTimeSteps)
     return;
   computePostProjection(o_x);
-}
\ No newline at end of file
+}
+
+void ResidualProjection::getState(dlong& _numVecsProjection, dlong& _timestep) const
+{
+  _numVecsProjection = numVecsProjection;
+  _timestep = timestep;
+}
+
+void ResidualProjection::setState(const dlong _numVecsProjection, const dlong _timestep)
+{
+  numVecsProjection = mymin(_numVecsProjection, maxNumVecsProjection);
+  timestep = _timestep;
+}
@@ -39,6 +39,12 @@ public:
                      const dlong _numTimeSteps = 5);
   void pre(occa::memory& o_r);
   void post(occa::memory& o_x);
+
+  // state needed to continue with the current space after a restart
+  void getState(dlong& _numVecsProjection, dlong& _timestep) const;
+  void setState(const dlong _numVecsProjection, const dlong _timestep);
+  occa::memory& basisX() { return o_xx; }
+  occa::memory& basisB() { return o_bb; }
 private:
   void computePreProjection(occa::memory& o_r);
   void computePostProjection(occa::memory& o_x);
@@ -57,6 +63,7 @@ private:
   occa::memory& o_invDegree;
   occa::memory& o_rtmp;
   occa::memory& o_Ap;
+  MPI_Comm comm;
 
   occa::kernel scalarMultiplyKernel;
   occa::kernel multiScaledAddwOffsetKernel;
@@ -49,7 +49,7 @@ void ellipticSolve(elliptic_t* elliptic, occa::memory &o_r, occa::memory &o_x)
         elliptic->Ntotal,
         elliptic->o_invDegree,
         o_r,
-        platform->comm.mpiComm
+        elliptic->comm
       )
       * sqrt(elliptic->resNormFactor); 
     if(platform->comm.mpiRank == 0) printf("RHS norm: %.15e\n", rhsNorm);
@@ -84,7 +84,7 @@ void ellipticSolve(elliptic_t* elliptic, occa::memory &o_r, occa::memory &o_x)
         elliptic->Ntotal,
         elliptic->o_invDegree,
         o_r,
-        platform->comm.mpiComm
+        elliptic->comm
       )
       * sqrt(elliptic->resNormFactor); 
     if(std::isnan(elliptic->res00Norm)) {
@@ -102,7 +102,7 @@ void ellipticSolve(elliptic_t* elliptic, occa::memory &o_r, occa::memory &o_x)
       elliptic->Ntotal /* offset */,
       elliptic->o_invDegree,
       o_r,
-      platform->comm.mpiComm
+      elliptic->comm
     )
     * sqrt(elliptic->resNormFactor); 
   if(std::isnan(elliptic->res0Norm)) {
@@ -112,7 +112,12 @@ void ellipticSolve(elliptic_t* elliptic, occa::memory &o_r, occa::memory &o_x)
 
   if(!options.compareArgs("KRYLOV SOLVER", "NONBLOCKING")) {
     elliptic->resNorm = elliptic->res0Norm;
-    elliptic->Niter = pcg (elliptic, o_r, o_x, tol, maxIter, elliptic->resNorm);
+    if(options.compareArgs("KRYLOV SOLVER", "CHEBYSHEV"))
+      elliptic->Niter = chebyshev(elliptic, o_r, o_x, tol, maxIter, elliptic->resNorm);
+    else if(elliptic->mixedPrecision)
+      elliptic->Niter = pcgMixed(elliptic, o_r, o_x, tol, maxIter, elliptic->resNorm);
+    else
+      elliptic->Niter = pcg (elliptic, o_r, o_x, tol, maxIter, elliptic->resNorm);
   }else{
     if(platform->comm.mpiRank == 0) printf("NONBLOCKING Krylov solvers currently not supported!");
     ABORT(EXIT_FAILURE);
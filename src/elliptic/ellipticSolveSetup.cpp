@@ -39,6 +39,8 @@ void ellipticSolveSetup(elliptic_t* elliptic, occa::properties kernelInfo)
   MPI_Barrier(platform->comm.mpiComm);
   const double tStart = MPI_Wtime();
 
+  MPI_Comm_dup(platform->comm.mpiComm, &elliptic->comm);
+
   const dlong Nlocal = mesh->Np * mesh->Nelements;
   elliptic->resNormFactor = 1 / (elliptic->Nfields * mesh->volume);
 
@@ -88,6 +90,24 @@ void ellipticSolveSetup(elliptic_t* elliptic, occa::properties kernelInfo)
 
   elliptic->o_x0 = platform->device.malloc(elliptic->Ntotal * elliptic->Nfields ,  sizeof(dfloat));
 
+  elliptic->mixedPrecision = options.compareArgs("MIXED PRECISION", "TRUE");
+  if(elliptic->mixedPrecision) {
+    if(elliptic->stressForm) {
+      if(platform->comm.mpiRank == 0)
+        printf("ERROR: Mixed precision solver does not support stress formulation!\n");
+      ABORT(EXIT_FAILURE);
+    }
+    const dlong Nbytes = elliptic->Ntotal * elliptic->Nfields * sizeof(pfloat);
+    elliptic->o_rPfloat  = platform->device.malloc(Nbytes);
+    elliptic->o_xPfloat  = platform->device.malloc(Nbytes);
+    elliptic->o_pPfloat  = platform->device.malloc(Nbytes);
+    elliptic->o_zPfloat  = platform->device.malloc(Nbytes);
+    elliptic->o_ApPfloat = platform->device.malloc(Nbytes);
+    if(elliptic->o_lambda.size())
+      elliptic->o_lambdaPfloat =
+        platform->device.malloc((elliptic->o_lambda.size() / sizeof(dfloat)) * sizeof(pfloat));
+  }
+
   dlong Nblocks = (Nlocal + BLOCKSIZE - 1) / BLOCKSIZE;
   elliptic->tmpNormr = (dfloat*) calloc(Nblocks,sizeof(dfloat));
   elliptic->o_tmpNormr = platform->device.malloc(Nblocks * sizeof(dfloat),
@@ -160,6 +180,16 @@ void ellipticSolveSetup(elliptic_t* elliptic, occa::properties kernelInfo)
   if(platform->comm.mpiRank == 0)
     printf("allNeumann = %d \n", elliptic->allNeumann);
 
+  elliptic->chebyshevEstimated = 0;
+  if(options.compareArgs("KRYLOV SOLVER", "CHEBYSHEV")) {
+    if(elliptic->mixedPrecision || elliptic->allNeumann ||
+       !options.compareArgs("PRECONDITIONER", "JACOBI")) {
+      if(platform->comm.mpiRank == 0)
+        printf("ERROR: Chebyshev solver requires Jacobi preconditioner, FP64 and a non-singular operator!\n");
+      ABORT(EXIT_FAILURE);
+    }
+  }
+
   //copy boundary flags
   elliptic->o_EToB = platform->device.malloc(
     mesh->Nelements * mesh->Nfaces * elliptic->Nfields * sizeof(int),
@@ -326,6 +356,8 @@ void ellipticSolveSetup(elliptic_t* elliptic, occa::properties kernelInfo)
   occa::properties dfloatKernelInfoNoOKL = kernelInfoNoOKL;
   dfloatKernelInfoNoOKL["defines/" "pfloat"] = dfloatString;
   if(serial) AxKernelInfo = dfloatKernelInfoNoOKL;
+  occa::properties AxPfloatKernelInfo = floatKernelInfo;
+  if(serial) AxPfloatKernelInfo["okl/enabled"] = false;
 
   {
       const string oklpath = install_dir + "/okl/elliptic/";
@@ -379,6 +411,8 @@ void ellipticSolveSetup(elliptic_t* elliptic, occa::properties kernelInfo)
       }
       // Keep other kernel around
       elliptic->AxKernel = platform->device.buildKernel(filename,kernelName,AxKernelInfo);
+      if(elliptic->mixedPrecision)
+        elliptic->AxPfloatKernel = platform->device.buildKernel(filename,kernelName,AxPfloatKernelInfo);
 
       if(!serial) {
         if(elliptic->elementType != HEXAHEDRA) {
@@ -414,6 +448,9 @@ void ellipticSolveSetup(elliptic_t* elliptic, occa::properties kernelInfo)
         }
         elliptic->partialAxKernel = platform->device.buildKernel(filename,kernelName,AxKernelInfo);
         elliptic->partialAxKernel2 = platform->device.buildKernel(filename,kernelName,AxKernelInfo);
+        if(elliptic->mixedPrecision)
+          elliptic->partialAxPfloatKernel =
+            platform->device.buildKernel(filename,kernelName,AxPfloatKernelInfo);
       }
 
       // combined PCG update and r.r kernel
@@ -429,6 +466,40 @@ void ellipticSolveSetup(elliptic_t* elliptic, occa::properties kernelInfo)
                                    "ellipticBlockUpdatePCG", dfloatKernelInfo);
       }
 
+      if(options.compareArgs("KRYLOV SOLVER", "CHEBYSHEV")) {
+        filename = oklpath + "ellipticUpdateChebyshev.okl";
+        elliptic->updateChebyshevKernel =
+          platform->device.buildKernel(filename,
+                                   "ellipticBlockUpdateChebyshev", dfloatKernelInfo);
+      }
+
+      if(elliptic->mixedPrecision) {
+        // FP32 vectors, FP64 accumulation of r.r
+        if(serial) {
+          filename = oklpath + "ellipticSerialUpdatePCG.c";
+          elliptic->updatePCGPfloatKernel =
+            platform->device.buildKernel(filename,
+                                     "ellipticUpdatePCG", kernelInfoNoOKL);
+        } else {
+          filename = oklpath + "ellipticUpdatePCG.okl";
+          elliptic->updatePCGPfloatKernel =
+            platform->device.buildKernel(filename,
+                                     "ellipticBlockUpdatePCG", kernelInfo);
+        }
+
+        const string linAlgPath = install_dir + "/okl/linAlg/";
+        occa::properties floatKernelInfoNoOKL = floatKernelInfo;
+        if(serial) floatKernelInfoNoOKL["okl/enabled"] = false;
+        filename = linAlgPath + (serial ? "linAlgWeightedInnerProd.c" : "linAlgWeightedInnerProd.okl");
+        elliptic->weightedInnerProdPfloatKernel =
+          platform->device.buildKernel(filename,
+                                   "weightedInnerProdMany", floatKernelInfoNoOKL);
+        filename = linAlgPath + "linAlgFill.okl";
+        elliptic->fillPfloatKernel =
+          platform->device.buildKernel(filename,
+                                   "fill", floatKernelInfo);
+      }
+
       if(!elliptic->blockSolver) {
         if(serial){
           filename = oklpath + "ellipticPreconCoarsen" + suffix + ".c";
@@ -474,6 +545,26 @@ void ellipticSolveSetup(elliptic_t* elliptic, occa::properties kernelInfo)
 
   elliptic->precon->preconBytes = usedBytes;
 
+  if(elliptic->mixedPrecision) {
+    const dlong N = elliptic->Ntotal * elliptic->Nfields;
+    if(mesh->o_ggeoPfloat.size() == 0) {
+      mesh->o_ggeoPfloat = platform->device.malloc(mesh->Nelements * mesh->Np * mesh->Nggeo ,  sizeof(pfloat));
+      mesh->o_DPfloat = platform->device.malloc(mesh->Nq * mesh->Nq ,  sizeof(pfloat));
+      mesh->o_DTPfloat = platform->device.malloc(mesh->Nq * mesh->Nq ,  sizeof(pfloat));
+      elliptic->copyDfloatToPfloatKernel(mesh->Nelements * mesh->Np * mesh->Nggeo,
+                                         mesh->o_ggeoPfloat,
+                                         mesh->o_ggeo);
+      elliptic->copyDfloatToPfloatKernel(mesh->Nq * mesh->Nq, mesh->o_DPfloat, mesh->o_D);
+      elliptic->copyDfloatToPfloatKernel(mesh->Nq * mesh->Nq, mesh->o_DTPfloat, mesh->o_DT);
+    }
+    elliptic->o_invDegreePfloat = platform->device.malloc(elliptic->Ntotal * sizeof(pfloat));
+    elliptic->copyDfloatToPfloatKernel(Nlocal, elliptic->o_invDegreePfloat, elliptic->o_invDegree);
+    if(options.compareArgs("PRECONDITIONER", "JACOBI")) {
+      elliptic->o_invDiagAPfloat = platform->device.malloc(N * sizeof(pfloat));
+      elliptic->copyDfloatToPfloatKernel(N, elliptic->o_invDiagAPfloat, elliptic->precon->o_invDiagA);
+    }
+  }
+
   if(options.compareArgs("RESIDUAL PROJECTION","TRUE")) {
     dlong nVecsProject = 8;
     options.getArgs("RESIDUAL PROJECTION VECTORS", nVecsProject);
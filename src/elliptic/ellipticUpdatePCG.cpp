@@ -60,7 +60,7 @@ dfloat ellipticUpdatePCG(elliptic_t* elliptic,
     for(int n = 0; n < Nblock; ++n)
       rdotr1 += elliptic->tmpNormr[n];
   }
-  MPI_Allreduce(MPI_IN_PLACE, &rdotr1, 1, MPI_DFLOAT, MPI_SUM, platform->comm.mpiComm);
+  MPI_Allreduce(MPI_IN_PLACE, &rdotr1, 1, MPI_DFLOAT, MPI_SUM, elliptic->comm);
 #ifdef ELLIPTIC_ENABLE_TIMER
     platform->timer.toc("dotp");
 #endif
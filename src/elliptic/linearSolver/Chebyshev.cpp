@@ -0,0 +1,246 @@
+/*
+
+   The MIT License (MIT)
+
+   Copyright (c) 2017 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software and associated documentation files (the "Software"), to deal
+   in the Software without restriction, including without limitation the rights
+   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+   copies of the Software, and to permit persons to whom the Software is
+   furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in all
+   copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+   SOFTWARE.
+
+ */
+
+// Jacobi-preconditioned Chebyshev iteration. The spectrum bounds of
+// diag(A)^{-1} A are estimated once by a short Lanczos (PCG) run and refreshed
+// whenever the Helmholtz coefficients change, so the iteration itself needs no
+// inner products apart from the (optional) periodic residual check.
+
+#include <vector>
+
+#include "elliptic.h"
+#include "timer.hpp"
+#include "linAlg.hpp"
+
+namespace {
+
+constexpr int lanczosIterations = 16;
+constexpr dfloat coeffChangeTol = 0.05;
+
+void coeffSums(elliptic_t* elliptic, dfloat* sums)
+{
+  mesh_t* mesh = elliptic->mesh;
+  sums[0] = 0;
+  sums[1] = 0;
+  for(int fld = 0; fld < elliptic->Nfields; fld++) {
+    if(elliptic->var_coeff) {
+      sums[0] += platform->linAlg->sum(mesh->Nlocal, elliptic->o_lambda, MPI_COMM_NULL,
+                                       fld * elliptic->loffset);
+      sums[1] += platform->linAlg->sum(mesh->Nlocal, elliptic->o_lambda, MPI_COMM_NULL,
+                                       elliptic->Ntotal + fld * elliptic->loffset);
+    } else {
+      sums[0] += elliptic->lambda[fld];
+    }
+  }
+}
+
+bool coeffChanged(elliptic_t* elliptic)
+{
+  dfloat sums[2];
+  coeffSums(elliptic, sums);
+
+  dfloat change = 0;
+  for(int i = 0; i < 2; i++) {
+    const dfloat ref = std::abs(elliptic->chebyshevCoeffSum[i]);
+    const dfloat diff = std::abs(sums[i] - elliptic->chebyshevCoeffSum[i]);
+    change = std::max(change, (ref > 0) ? diff / ref : diff);
+  }
+  MPI_Allreduce(MPI_IN_PLACE, &change, 1, MPI_DFLOAT, MPI_MAX, elliptic->comm);
+
+  return change > coeffChangeTol;
+}
+
+}
+
+void ellipticEstimateEigenvalues(elliptic_t* elliptic, dfloat &lambdaMin, dfloat &lambdaMax)
+{
+  mesh_t* mesh = elliptic->mesh;
+  const dlong Nlocal = mesh->Nlocal;
+  const dlong Nfields = elliptic->Nfields;
+  const dlong Ntotal = elliptic->Ntotal;
+
+  occa::memory &o_p  = elliptic->o_p;
+  occa::memory &o_z  = elliptic->o_z;
+  occa::memory &o_Ap = elliptic->o_Ap;
+  occa::memory &o_weight = elliptic->o_invDegree;
+  // solver owned, the estimate may run on the stream of an overlapping solve
+  occa::memory &o_r = elliptic->o_rtmp;
+
+  // random (assembled) start vector
+  std::vector<dfloat> r(Nfields * Ntotal, 0.0);
+  srand48(1234 + platform->comm.mpiRank);
+  for(int fld = 0; fld < Nfields; fld++)
+    for(dlong n = 0; n < Nlocal; n++)
+      r[n + fld * Ntotal] = drand48();
+  o_r.copyFrom(r.data(), Nfields * Ntotal * sizeof(dfloat));
+  oogs::startFinish(o_r, Nfields, Ntotal, ogsDfloat, ogsAdd, elliptic->oogs);
+  if(elliptic->Nmasked) mesh->maskKernel(elliptic->Nmasked, elliptic->o_maskIds, o_r);
+
+  platform->linAlg->fill(Nfields * Ntotal, 0.0, o_p);
+
+  // PCG coefficients define the Lanczos tridiagonal matrix
+  std::vector<dfloat> alpha, beta;
+  dfloat rdotz0 = 0;
+  dfloat rdotz = 0;
+  for(int it = 0; it < lanczosIterations; it++) {
+    ellipticPreconditioner(elliptic, o_r, o_z);
+    const dfloat rdotzOld = rdotz;
+    rdotz = platform->linAlg->weightedInnerProdMany(
+      Nlocal, Nfields, Ntotal, o_weight, o_r, o_z, elliptic->comm);
+    if(it == 0) rdotz0 = rdotz;
+    if(rdotz <= 1e-24 * rdotz0) break;
+
+    const dfloat b = (it > 0) ? rdotz / rdotzOld : 0;
+    platform->linAlg->axpbyMany(Nlocal, Nfields, Ntotal, 1.0, o_z, b, o_p);
+
+    ellipticOperator(elliptic, o_p, o_Ap, dfloatString);
+    const dfloat pAp = platform->linAlg->weightedInnerProdMany(
+      Nlocal, Nfields, Ntotal, o_weight, o_p, o_Ap, elliptic->comm);
+    const dfloat a = rdotz / pAp;
+
+    alpha.push_back(a);
+    beta.push_back(b);
+    platform->linAlg->axpbyMany(Nlocal, Nfields, Ntotal, -a, o_Ap, 1.0, o_r);
+  }
+
+  const int m = alpha.size();
+  if(m == 0) {
+    if(platform->comm.mpiRank == 0)
+      printf("ERROR: Chebyshev eigenvalue estimation failed!\n");
+    ABORT(EXIT_FAILURE);
+  }
+
+  std::vector<dfloat> T(m * m, 0.0);
+  for(int j = 0; j < m; j++) {
+    T[j * m + j] = 1 / alpha[j];
+    if(j > 0) {
+      T[j * m + j] += beta[j] / alpha[j - 1];
+      const dfloat offDiag = sqrt(beta[j]) / alpha[j - 1];
+      T[j * m + j - 1] = offDiag;
+      T[(j - 1) * m + j] = offDiag;
+    }
+  }
+
+  std::vector<dfloat> VR(m * m), WR(m), WI(m);
+  matrixEig(m, T.data(), VR.data(), WR.data(), WI.data());
+
+  dfloat ritzMin = WR[0];
+  dfloat ritzMax = WR[0];
+  for(int j = 1; j < m; j++) {
+    ritzMin = std::min(ritzMin, WR[j]);
+    ritzMax = std::max(ritzMax, WR[j]);
+  }
+
+  // Ritz values lie inside the spectrum; safeguard the upper bound only as
+  // Chebyshev still converges (just slower) for modes below lambdaMin
+  lambdaMin = ritzMin;
+  lambdaMax = 1.1 * ritzMax;
+}
+
+int chebyshev(elliptic_t* elliptic, occa::memory &o_r, occa::memory &o_x,
+              const dfloat tol, const int MAXIT, dfloat &res)
+{
+  mesh_t* mesh = elliptic->mesh;
+  setupAide options = elliptic->options;
+
+  const int verbose = options.compareArgs("VERBOSE", "TRUE");
+  const int fixedIterationCountFlag = options.compareArgs("FIXED ITERATION COUNT", "TRUE");
+  const int residualCheck = options.compareArgs("CHEBYSHEV RESIDUAL CHECK", "TRUE");
+  int degree = 8;
+  options.getArgs("CHEBYSHEV DEGREE", degree);
+
+  if(!elliptic->chebyshevEstimated || coeffChanged(elliptic)) {
+    platform->timer.tic("chebyshev eigenvalue estimate", 1);
+    ellipticEstimateEigenvalues(elliptic, elliptic->chebyshevLambdaMin, elliptic->chebyshevLambdaMax);
+    coeffSums(elliptic, elliptic->chebyshevCoeffSum);
+    elliptic->chebyshevEstimated = 1;
+    platform->timer.toc("chebyshev eigenvalue estimate");
+    if(platform->comm.mpiRank == 0 && verbose)
+      printf("Chebyshev: eigenvalue bounds [%g, %g]\n",
+             elliptic->chebyshevLambdaMin, elliptic->chebyshevLambdaMax);
+  }
+
+  const dfloat lambdaMin = elliptic->chebyshevLambdaMin;
+  const dfloat lambdaMax = elliptic->chebyshevLambdaMax;
+  const dfloat theta = 0.5 * (lambdaMax + lambdaMin);
+  const dfloat delta = 0.5 * (lambdaMax - lambdaMin);
+  const dfloat sigma = theta / delta;
+
+  occa::memory &o_d  = elliptic->o_p;
+  occa::memory &o_Ad = elliptic->o_Ap;
+  occa::memory &o_invDiagA = elliptic->precon->o_invDiagA;
+
+  if(platform->comm.mpiRank == 0 && verbose)
+    printf("Chebyshev: initial res norm %.15e WE NEED TO GET TO %e \n", res, tol);
+
+  // d = M^{-1} r / theta
+  platform->linAlg->axmyzMany(mesh->Nlocal, elliptic->Nfields, elliptic->Ntotal,
+                              1.0 / theta, o_r, o_invDiagA, o_d);
+
+  const int maxIter = residualCheck ? MAXIT : std::min(degree, MAXIT);
+  const dfloat res0 = res;
+  dfloat rho = 1 / sigma;
+  int iter;
+  for(iter = 1; iter <= maxIter; ++iter) {
+    ellipticOperator(elliptic, o_d, o_Ad, dfloatString);
+
+    const dfloat rhoNew = 1 / (2 * sigma - rho);
+    const dfloat c1 = rhoNew * rho;
+    const dfloat c2 = 2 * rhoNew / delta;
+    rho = rhoNew;
+
+    //  x <= x + d
+    //  r <= r - A*d
+    //  d <= c1*d + c2*M^{-1}*r
+    elliptic->updateChebyshevKernel(mesh->Nlocal, elliptic->Ntotal, c1, c2,
+                                    o_invDiagA, o_Ad, o_d, o_x, o_r);
+
+    if(residualCheck && (iter % degree == 0 || iter == maxIter)) {
+      res = platform->linAlg->weightedNorm2Many(
+        mesh->Nlocal,
+        elliptic->Nfields,
+        elliptic->Ntotal,
+        elliptic->o_invDegree,
+        o_r,
+        elliptic->comm) * sqrt(elliptic->resNormFactor);
+
+      if (verbose && (platform->comm.mpiRank == 0))
+        printf("it %d r norm %.15e\n", iter, res);
+
+      if(res <= tol && !fixedIterationCountFlag) break;
+    }
+  }
+  if(iter > maxIter) iter = maxIter;
+
+  if(!residualCheck) {
+    // a-priori error reduction of a degree-k Chebyshev polynomial
+    const dfloat kappa = lambdaMax / lambdaMin;
+    const dfloat c = (sqrt(kappa) + 1) / (sqrt(kappa) - 1);
+    res = res0 * 2 / (pow(c, iter) + pow(c, -iter));
+  }
+
+  return iter;
+}
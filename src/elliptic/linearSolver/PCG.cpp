@@ -64,7 +64,7 @@ int pcg(elliptic_t* elliptic, occa::memory &o_r, occa::memory &o_x,
       o_weight,
       o_r,
       o_z,
-      platform->comm.mpiComm);
+      elliptic->comm);
 
     //printf("norm rdotz1: %.15e\n", rdotz1);
 
@@ -79,7 +79,7 @@ int pcg(elliptic_t* elliptic, occa::memory &o_r, occa::memory &o_x,
           o_weight,
           o_z,
           o_Ap,
-          platform->comm.mpiComm);
+          elliptic->comm);
         beta = -alpha * zdotAp/rdotz2;
         //printf("norm zdotAp: %.15e\n", zdotAp);
       }
@@ -102,7 +102,7 @@ int pcg(elliptic_t* elliptic, occa::memory &o_r, occa::memory &o_x,
       o_weight,
       o_p,
       o_Ap,
-      platform->comm.mpiComm);
+      elliptic->comm);
     alpha = rdotz1 / pAp;
 
     //printf("norm pAp: %.15e\n", pAp);
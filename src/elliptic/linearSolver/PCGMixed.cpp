@@ -0,0 +1,244 @@
+/*
+
+   The MIT License (MIT)
+
+   Copyright (c) 2017 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software and associated documentation files (the "Software"), to deal
+   in the Software without restriction, including without limitation the rights
+   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+   copies of the Software, and to permit persons to whom the Software is
+   furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in all
+   copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+   SOFTWARE.
+
+ */
+
+// Mixed-precision PCG: the Krylov iteration (operator, vectors, gather-scatter)
+// runs in pfloat on a correction equation A d = r, while the solution update
+// and the true residual r <- r - A d are carried out in dfloat (iterative refinement).
+
+#include "elliptic.h"
+#include "timer.hpp"
+#include "linAlg.hpp"
+
+namespace {
+
+// required reduction of the FP64 residual per refinement step
+constexpr dfloat innerRelTol = 1e-3;
+// a refinement step has to reduce the FP64 residual at least by this factor
+constexpr dfloat stagnationFactor = 0.5;
+constexpr int maxRefinementSteps = 10;
+
+dfloat weightedInnerProdPfloat(elliptic_t* elliptic, occa::memory &o_a, occa::memory &o_b)
+{
+  mesh_t* mesh = elliptic->mesh;
+  const int serial = platform->device.mode() == "Serial" || platform->device.mode() == "OpenMP";
+
+  platform->timer.tic("dotp",1);
+  const dlong Nblock = (mesh->Nlocal + BLOCKSIZE - 1) / BLOCKSIZE;
+  elliptic->weightedInnerProdPfloatKernel(Nblock,
+                                          mesh->Nlocal,
+                                          elliptic->Nfields,
+                                          elliptic->Ntotal,
+                                          elliptic->o_invDegreePfloat,
+                                          o_a,
+                                          o_b,
+                                          elliptic->o_tmpNormr);
+
+  // block partial sums are pfloat, accumulate them in dfloat
+  pfloat* tmp = (pfloat*) elliptic->tmpNormr;
+  const dlong Nread = serial ? 1 : Nblock;
+  elliptic->o_tmpNormr.copyTo(tmp, Nread * sizeof(pfloat));
+  dfloat dot = 0;
+  for(dlong n = 0; n < Nread; ++n)
+    dot += tmp[n];
+
+  MPI_Allreduce(MPI_IN_PLACE, &dot, 1, MPI_DFLOAT, MPI_SUM, elliptic->comm);
+  platform->timer.toc("dotp");
+
+  return dot;
+}
+
+dfloat updatePCGPfloat(elliptic_t* elliptic, const dfloat alpha)
+{
+  mesh_t* mesh = elliptic->mesh;
+  const int serial = platform->device.mode() == "Serial" || platform->device.mode() == "OpenMP";
+
+  elliptic->updatePCGPfloatKernel(mesh->Nlocal,
+                                  elliptic->Ntotal,
+                                  elliptic->o_invDegreePfloat,
+                                  elliptic->o_pPfloat,
+                                  elliptic->o_ApPfloat,
+                                  alpha,
+                                  elliptic->o_xPfloat,
+                                  elliptic->o_rPfloat,
+                                  elliptic->o_tmpNormr);
+
+  dfloat rdotr = 0;
+  if(serial) {
+    rdotr = *((dfloat *) elliptic->o_tmpNormr.ptr());
+  } else {
+    const dlong Nblock = (mesh->Nlocal + BLOCKSIZE - 1) / BLOCKSIZE;
+    elliptic->o_tmpNormr.copyTo(elliptic->tmpNormr, Nblock * sizeof(dfloat));
+    for(int n = 0; n < Nblock; ++n)
+      rdotr += elliptic->tmpNormr[n];
+  }
+  MPI_Allreduce(MPI_IN_PLACE, &rdotr, 1, MPI_DFLOAT, MPI_SUM, elliptic->comm);
+
+  return rdotr;
+}
+
+void preconditionerPfloat(elliptic_t* elliptic)
+{
+  const dlong N = elliptic->Nfields * elliptic->Ntotal;
+
+  if(elliptic->options.compareArgs("PRECONDITIONER", "JACOBI") && !elliptic->allNeumann) {
+    elliptic->dotMultiplyPfloatKernel(N, elliptic->o_invDiagAPfloat, elliptic->o_rPfloat, elliptic->o_zPfloat);
+    return;
+  }
+
+  // the V-cycle is pfloat native, skip the dfloat round trip
+  if(elliptic->options.compareArgs("PRECONDITIONER", "MULTIGRID") && !elliptic->allNeumann &&
+     elliptic->precon->o_rPfloat.size()) {
+    platform->timer.tic("mg preconditioner", 1);
+    parAlmond::Precon(elliptic->precon->parAlmond, elliptic->o_zPfloat, elliptic->o_rPfloat);
+    platform->timer.toc("mg preconditioner");
+    return;
+  }
+
+  elliptic->copyPfloatToDPfloatKernel(N, elliptic->o_rPfloat, elliptic->o_p);
+  ellipticPreconditioner(elliptic, elliptic->o_p, elliptic->o_z);
+  elliptic->copyDfloatToPfloatKernel(N, elliptic->o_zPfloat, elliptic->o_z);
+}
+
+// solves A d = r in pfloat, d is returned in o_xPfloat
+int pcgPfloat(elliptic_t* elliptic, const dfloat tol, const int MAXIT, dfloat &rdotr)
+{
+  setupAide &options = elliptic->options;
+
+  const int flexible = options.compareArgs("KRYLOV SOLVER", "FLEXIBLE");
+  const int verbose = options.compareArgs("VERBOSE", "TRUE");
+  const dlong N = elliptic->Nfields * elliptic->Ntotal;
+
+  occa::memory &o_r  = elliptic->o_rPfloat;
+  occa::memory &o_p  = elliptic->o_pPfloat;
+  occa::memory &o_z  = elliptic->o_zPfloat;
+  occa::memory &o_Ap = elliptic->o_ApPfloat;
+
+  elliptic->fillPfloatKernel(N, (pfloat) 0.0, elliptic->o_xPfloat);
+  elliptic->fillPfloatKernel(N, (pfloat) 0.0, o_p);
+
+  dfloat rdotz1 = 0;
+  dfloat alpha = 0;
+
+  int iter;
+  for(iter = 1; iter <= MAXIT; ++iter) {
+    preconditionerPfloat(elliptic);
+
+    const dfloat rdotz2 = rdotz1;
+    rdotz1 = weightedInnerProdPfloat(elliptic, o_r, o_z);
+
+    dfloat beta = 0;
+    if(iter > 1) {
+      beta = rdotz1/rdotz2;
+      if(flexible) {
+        const dfloat zdotAp = weightedInnerProdPfloat(elliptic, o_z, o_Ap);
+        beta = -alpha * zdotAp/rdotz2;
+      }
+    }
+
+    // p <= z + beta*p
+    elliptic->scaledAddPfloatKernel(N, (pfloat) 1.0, o_z, (pfloat) beta, o_p);
+
+    ellipticOperator(elliptic, o_p, o_Ap, pfloatString);
+    const dfloat pAp = weightedInnerProdPfloat(elliptic, o_p, o_Ap);
+    alpha = rdotz1 / pAp;
+
+    rdotr = sqrt(updatePCGPfloat(elliptic, alpha) * elliptic->resNormFactor);
+
+    if (verbose && (platform->comm.mpiRank == 0))
+      printf("it %d r norm (%s) %.15e\n", iter, pfloatString, rdotr);
+
+    if(rdotr <= tol || std::isnan(rdotr)) break;
+  }
+
+  return mymin(iter, MAXIT);
+}
+
+}
+
+int pcgMixed(elliptic_t* elliptic, occa::memory &o_r, occa::memory &o_x,
+             const dfloat tol, const int MAXIT, dfloat &rdotr)
+{
+  mesh_t* mesh = elliptic->mesh;
+  setupAide &options = elliptic->options;
+
+  const int verbose = options.compareArgs("VERBOSE", "TRUE");
+  const dlong N = elliptic->Nfields * elliptic->Ntotal;
+
+  // coefficients may have changed since the last solve
+  if(elliptic->o_lambdaPfloat.size())
+    elliptic->copyDfloatToPfloatKernel((dlong) (elliptic->o_lambda.size() / sizeof(dfloat)),
+                                       elliptic->o_lambdaPfloat,
+                                       elliptic->o_lambda);
+  if(elliptic->o_invDiagAPfloat.size())
+    elliptic->copyDfloatToPfloatKernel(N, elliptic->o_invDiagAPfloat, elliptic->precon->o_invDiagA);
+
+  if(platform->comm.mpiRank == 0 && verbose)
+    printf("CG (mixed): initial res norm %.15e WE NEED TO GET TO %e \n", rdotr, tol);
+
+  int Niter = 0;
+  for(int step = 1; step <= maxRefinementSteps; ++step) {
+    elliptic->copyDfloatToPfloatKernel(N, elliptic->o_rPfloat, o_r);
+
+    const dfloat innerTol = mymax(tol, innerRelTol * rdotr);
+    dfloat innerRes = rdotr;
+    Niter += pcgPfloat(elliptic, innerTol, MAXIT - Niter, innerRes);
+
+    const dfloat rdotrPrev = rdotr;
+    if(!std::isnan(innerRes)) {
+      // x <= x + d
+      // r <= r - A*d
+      elliptic->copyPfloatToDPfloatKernel(N, elliptic->o_xPfloat, elliptic->o_z);
+      platform->linAlg->axpbyMany(mesh->Nlocal, elliptic->Nfields, elliptic->Ntotal,
+                                  1.0, elliptic->o_z, 1.0, o_x);
+      ellipticOperator(elliptic, elliptic->o_z, elliptic->o_Ap, dfloatString);
+      platform->linAlg->axpbyMany(mesh->Nlocal, elliptic->Nfields, elliptic->Ntotal,
+                                  -1.0, elliptic->o_Ap, 1.0, o_r);
+
+      rdotr = platform->linAlg->weightedNorm2Many(mesh->Nlocal,
+                                                  elliptic->Nfields,
+                                                  elliptic->Ntotal,
+                                                  elliptic->o_invDegree,
+                                                  o_r,
+                                                  elliptic->comm)
+              * sqrt(elliptic->resNormFactor);
+
+      if (verbose && (platform->comm.mpiRank == 0))
+        printf("refinement step %d r norm %.15e\n", step, rdotr);
+    }
+
+    if(rdotr <= tol || Niter >= MAXIT) break;
+
+    // safeguard: continue in full precision if the pfloat solve breaks down or stagnates
+    if(std::isnan(innerRes) || rdotr > stagnationFactor * rdotrPrev || step == maxRefinementSteps) {
+      if(platform->comm.mpiRank == 0)
+        printf("mixed precision refinement stalled (res norm %.6e), continue in %s\n", rdotr, dfloatString);
+      Niter += pcg(elliptic, o_r, o_x, tol, MAXIT - Niter, rdotr);
+      break;
+    }
+  }
+
+  return Niter;
+}
@@ -96,6 +96,13 @@ void coarseSolver::setup(
     options.getArgs("BOOMERAMG STRONG THRESHOLD", settings[8]);
     options.getArgs("BOOMERAMG NONGALERKIN TOLERANCE" , settings[9]);
 
+    // re-setup (e.g. moving mesh), release the previous hierarchy first
+    if(crsh) {
+      hypre_free(crsh);
+      free(xLocal);
+      free(rhsLocal);
+    }
+
     crsh = hypre_setup(Nrows,
                        globalRowStarts[rank],
                        nnz,
@@ -0,0 +1,399 @@
+#include <vector>
+#include <string>
+#include <cstdio>
+#include <cstring>
+#include <numeric>
+
+#include "nrs.hpp"
+#include "platform.hpp"
+#include "elliptic.h"
+#include "ellipticResidualProjection.h"
+#include "io.hpp"
+
+// full-state checkpoint including all BDF/EXT history levels, a restart continues at full temporal order
+// every rank writes its device buffers as one contiguous block through MPI-IO,
+// reading it back requires the same number of ranks and the same case setup
+
+namespace {
+
+constexpr char magic[8] = {'#', 'n', 'r', 's', 'c', 'h', 'k', 'p'};
+constexpr int version = 1;
+constexpr int Nints = 8;
+constexpr int Nreals = 8;
+constexpr MPI_Offset headerBytes = sizeof(magic) + Nints * sizeof(int) + Nreals * sizeof(double);
+
+struct chkpHeader_t
+{
+  int Nranks;
+  int tstep;
+  int Nbuffers;
+  int Ncounters;
+  int UrstHead;
+  double time;
+  double dt[3];
+  double p0th[3];
+  double dp0thdt;
+  std::vector<long long> counters;
+  std::vector<long long> sizes; // [Nranks][Nbuffers]
+};
+
+// MPI-IO counts are int, buffers are transferred in 1 MiB blocks plus a remainder,
+// every rank makes the same two collective calls
+constexpr size_t blockBytes = 1 << 20;
+
+void readAll(MPI_File fh, MPI_Offset offset, char* buf, size_t Nbytes)
+{
+  MPI_Datatype block;
+  MPI_Type_contiguous(blockBytes, MPI_BYTE, &block);
+  MPI_Type_commit(&block);
+  const size_t Nblocks = Nbytes / blockBytes;
+  const size_t Nfull = Nblocks * blockBytes;
+  MPI_File_read_at_all(fh, offset, buf, (int) Nblocks, block, MPI_STATUS_IGNORE);
+  MPI_File_read_at_all(fh, offset + Nfull, buf + Nfull, (int) (Nbytes - Nfull), MPI_BYTE, MPI_STATUS_IGNORE);
+  MPI_Type_free(&block);
+}
+
+void writeAll(MPI_File fh, MPI_Offset offset, const char* buf, size_t Nbytes)
+{
+  MPI_Datatype block;
+  MPI_Type_contiguous(blockBytes, MPI_BYTE, &block);
+  MPI_Type_commit(&block);
+  const size_t Nblocks = Nbytes / blockBytes;
+  const size_t Nfull = Nblocks * blockBytes;
+  MPI_File_write_at_all(fh, offset, buf, (int) Nblocks, block, MPI_STATUS_IGNORE);
+  MPI_File_write_at_all(fh, offset + Nfull, buf + Nfull, (int) (Nbytes - Nfull), MPI_BYTE, MPI_STATUS_IGNORE);
+  MPI_Type_free(&block);
+}
+
+MPI_Offset dataOffset(const chkpHeader_t& h)
+{
+  return headerBytes + (MPI_Offset) (h.Ncounters + h.Nranks * h.Nbuffers) * sizeof(long long);
+}
+
+std::vector<mesh_t*> movingMeshes(nrs_t* nrs)
+{
+  std::vector<mesh_t*> meshes;
+  if(!platform->options.compareArgs("MOVING MESH", "TRUE")) return meshes;
+  meshes.push_back(nrs->meshV);
+  if(nrs->cht) meshes.push_back(nrs->cds->mesh[0]);
+  return meshes;
+}
+
+// solution and all time history levels, order defines the file layout
+std::vector<occa::memory> stateBuffers(nrs_t* nrs)
+{
+  std::vector<occa::memory> buffers = {nrs->o_U, nrs->o_P};
+
+  if(nrs->flow) buffers.push_back(nrs->o_FU);
+  if(nrs->Nsubsteps) {
+    if(nrs->o_Urst.size()) buffers.push_back(nrs->o_Urst);
+    if(nrs->o_relUrst.size()) buffers.push_back(nrs->o_relUrst);
+  }
+
+  if(nrs->Nscalar) {
+    buffers.push_back(nrs->cds->o_S);
+    buffers.push_back(nrs->cds->o_FS);
+  }
+
+  for(auto& mesh : movingMeshes(nrs)) {
+    buffers.push_back(mesh->o_x);
+    buffers.push_back(mesh->o_y);
+    buffers.push_back(mesh->o_z);
+    buffers.push_back(mesh->o_U);
+    buffers.push_back(mesh->o_LMM);
+    buffers.push_back(mesh->o_invLMM);
+    if(mesh->o_divU.size()) buffers.push_back(mesh->o_divU);
+  }
+
+  return buffers;
+}
+
+std::vector<elliptic_t*> projectionSolvers(nrs_t* nrs)
+{
+  std::vector<elliptic_t*> solvers;
+  auto add = [&](elliptic_t* solver)
+  {
+    if(solver && solver->options.compareArgs("RESIDUAL PROJECTION", "TRUE"))
+      solvers.push_back(solver);
+  };
+
+  if(nrs->flow) {
+    add(nrs->pSolver);
+    if(nrs->uvwSolver) {
+      add(nrs->uvwSolver);
+    } else {
+      add(nrs->uSolver);
+      add(nrs->vSolver);
+      add(nrs->wSolver);
+    }
+  }
+
+  if(nrs->Nscalar) {
+    cds_t* cds = nrs->cds;
+    for(int is = 0; is < cds->NSfields; is++)
+      if(cds->compute[is]) add(cds->solver[is]);
+  }
+
+  return solvers;
+}
+
+std::vector<occa::memory> projectionBuffers(const std::vector<elliptic_t*>& solvers)
+{
+  std::vector<occa::memory> buffers;
+  for(auto& solver : solvers) {
+    buffers.push_back(solver->residualProjection->basisX());
+    buffers.push_back(solver->residualProjection->basisB());
+  }
+  return buffers;
+}
+
+MPI_File openFile(const std::string& fileName)
+{
+  MPI_File fh;
+  const int err = MPI_File_open(platform->comm.mpiComm, fileName.c_str(), MPI_MODE_RDONLY, MPI_INFO_NULL, &fh);
+  if(err != MPI_SUCCESS) {
+    if(platform->comm.mpiRank == 0) printf("\nERROR: cannot open checkpoint file %s!\n", fileName.c_str());
+    ABORT(EXIT_FAILURE);
+  }
+  return fh;
+}
+
+chkpHeader_t readHeader(MPI_File fh)
+{
+  MPI_Comm comm = platform->comm.mpiComm;
+
+  char tag[sizeof(magic)];
+  int ints[Nints];
+  double reals[Nreals];
+  if(platform->comm.mpiRank == 0) {
+    MPI_File_read_at(fh, 0, tag, sizeof(tag), MPI_BYTE, MPI_STATUS_IGNORE);
+    MPI_File_read_at(fh, sizeof(magic), ints, Nints, MPI_INT, MPI_STATUS_IGNORE);
+    MPI_File_read_at(fh, sizeof(magic) + Nints * sizeof(int), reals, Nreals, MPI_DOUBLE, MPI_STATUS_IGNORE);
+  }
+  MPI_Bcast(tag, sizeof(tag), MPI_BYTE, 0, comm);
+  MPI_Bcast(ints, Nints, MPI_INT, 0, comm);
+  MPI_Bcast(reals, Nreals, MPI_DOUBLE, 0, comm);
+
+  if(memcmp(tag, magic, sizeof(magic)) || ints[0] != version) {
+    if(platform->comm.mpiRank == 0) printf("\nERROR: invalid checkpoint file!\n");
+    ABORT(EXIT_FAILURE);
+  }
+
+  chkpHeader_t h;
+  h.Nranks = ints[1];
+  h.tstep = ints[2];
+  h.Nbuffers = ints[3];
+  h.Ncounters = ints[4];
+  h.UrstHead = ints[5];
+  h.time = reals[0];
+  for(int i = 0; i < 3; i++) h.dt[i] = reals[1 + i];
+  for(int i = 0; i < 3; i++) h.p0th[i] = reals[4 + i];
+  h.dp0thdt = reals[7];
+
+  if(h.Nranks != platform->comm.mpiCommSize) {
+    if(platform->comm.mpiRank == 0)
+      printf("\nERROR: checkpoint was written by %d ranks but running on %d!\n",
+             h.Nranks, platform->comm.mpiCommSize);
+    ABORT(EXIT_FAILURE);
+  }
+
+  h.counters.resize(h.Ncounters);
+  h.sizes.resize(h.Nranks * h.Nbuffers);
+  if(platform->comm.mpiRank == 0) {
+    MPI_File_read_at(fh, headerBytes, h.counters.data(), h.Ncounters, MPI_LONG_LONG, MPI_STATUS_IGNORE);
+    MPI_File_read_at(fh, headerBytes + h.Ncounters * sizeof(long long),
+                     h.sizes.data(), h.sizes.size(), MPI_LONG_LONG, MPI_STATUS_IGNORE);
+  }
+  MPI_Bcast(h.counters.data(), h.Ncounters, MPI_LONG_LONG, 0, comm);
+  MPI_Bcast(h.sizes.data(), h.sizes.size(), MPI_LONG_LONG, 0, comm);
+
+  return h;
+}
+
+// reads buffers [first, first + buffers.size()) of the local block
+void readBuffers(MPI_File fh, const chkpHeader_t& h, int first, std::vector<occa::memory>& buffers)
+{
+  const int rank = platform->comm.mpiRank;
+  const long long* sizes = h.sizes.data() + rank * h.Nbuffers;
+
+  int err = first + (int) buffers.size() > h.Nbuffers;
+  for(int i = 0; i < (int) buffers.size() && !err; i++)
+    if(sizes[first + i] != (long long) buffers[i].size()) err = 1;
+  MPI_Allreduce(MPI_IN_PLACE, &err, 1, MPI_INT, MPI_MAX, platform->comm.mpiComm);
+  if(err) {
+    if(rank == 0) printf("\nERROR: checkpoint does not match the current setup!\n");
+    ABORT(EXIT_FAILURE);
+  }
+
+  MPI_Offset offset = dataOffset(h);
+  offset += std::accumulate(h.sizes.begin(), h.sizes.begin() + rank * h.Nbuffers, 0LL);
+  offset += std::accumulate(sizes, sizes + first, 0LL);
+
+  for(auto& o_buf : buffers) {
+    std::vector<char> buf(o_buf.size());
+    readAll(fh, offset, buf.data(), buf.size());
+    if(buf.size()) o_buf.copyFrom(buf.data(), buf.size());
+    offset += buf.size();
+  }
+}
+
+}
+
+void writeCheckpoint(nrs_t* nrs, dfloat time, int tstep)
+{
+  const double tStart = MPI_Wtime();
+  MPI_Comm comm = platform->comm.mpiComm;
+  const int rank = platform->comm.mpiRank;
+  const int size = platform->comm.mpiCommSize;
+
+  std::vector<occa::memory> buffers = stateBuffers(nrs);
+  std::vector<long long> counters;
+  if(platform->options.compareArgs("CHECKPOINT PROJECTION", "TRUE")) {
+    const std::vector<elliptic_t*> solvers = projectionSolvers(nrs);
+    for(auto& solver : solvers) {
+      dlong numVecs, step;
+      solver->residualProjection->getState(numVecs, step);
+      counters.push_back(numVecs);
+      counters.push_back(step);
+    }
+    std::vector<occa::memory> bases = projectionBuffers(solvers);
+    buffers.insert(buffers.end(), bases.begin(), bases.end());
+  }
+
+  chkpHeader_t h;
+  h.Nranks = size;
+  h.Nbuffers = buffers.size();
+  h.Ncounters = counters.size();
+
+  std::vector<long long> sizes(h.Nbuffers);
+  for(int i = 0; i < h.Nbuffers; i++) sizes[i] = buffers[i].size();
+  h.sizes.resize(rank == 0 ? size * h.Nbuffers : 0);
+  MPI_Gather(sizes.data(), h.Nbuffers, MPI_LONG_LONG, h.sizes.data(), h.Nbuffers, MPI_LONG_LONG, 0, comm);
+
+  const long long blockBytes = std::accumulate(sizes.begin(), sizes.end(), 0LL);
+  long long blockOffset = 0;
+  MPI_Exscan(&blockBytes, &blockOffset, 1, MPI_LONG_LONG, MPI_SUM, comm);
+  if(rank == 0) blockOffset = 0;
+
+  std::string casename;
+  platform->options.getArgs("CASENAME", casename);
+  const std::string fileName = casename + ".chkp";
+  // write to a temporary file first to keep the previous checkpoint intact in case of a failure
+  const std::string tmpName = fileName + ".tmp";
+
+  if(rank == 0) printf("writing checkpoint %s ... ", fileName.c_str());
+  fflush(stdout);
+
+  MPI_File fh;
+  const int err = MPI_File_open(comm, tmpName.c_str(), MPI_MODE_CREATE | MPI_MODE_WRONLY, MPI_INFO_NULL, &fh);
+  if(err != MPI_SUCCESS) {
+    if(rank == 0) printf("\nERROR: cannot open checkpoint file %s!\n", tmpName.c_str());
+    ABORT(EXIT_FAILURE);
+  }
+  MPI_File_set_size(fh, 0);
+
+  if(rank == 0) {
+    const int ints[Nints] = {version, size, tstep, h.Nbuffers, h.Ncounters, nrs->UrstHead, 0, 0};
+    const double reals[Nreals] = {time, nrs->dt[0], nrs->dt[1], nrs->dt[2],
+                                  nrs->p0th[0], nrs->p0th[1], nrs->p0th[2], nrs->dp0thdt};
+    MPI_Offset offset = 0;
+    MPI_File_write_at(fh, offset, magic, sizeof(magic), MPI_BYTE, MPI_STATUS_IGNORE);
+    offset += sizeof(magic);
+    MPI_File_write_at(fh, offset, ints, Nints, MPI_INT, MPI_STATUS_IGNORE);
+    offset += Nints * sizeof(int);
+    MPI_File_write_at(fh, offset, reals, Nreals, MPI_DOUBLE, MPI_STATUS_IGNORE);
+    offset += Nreals * sizeof(double);
+    MPI_File_write_at(fh, offset, counters.data(), h.Ncounters, MPI_LONG_LONG, MPI_STATUS_IGNORE);
+    offset += h.Ncounters * sizeof(long long);
+    MPI_File_write_at(fh, offset, h.sizes.data(), h.sizes.size(), MPI_LONG_LONG, MPI_STATUS_IGNORE);
+  }
+
+  MPI_Offset offset = dataOffset(h) + blockOffset;
+  for(auto& o_buf : buffers) {
+    std::vector<char> buf(o_buf.size());
+    if(buf.size()) o_buf.copyTo(buf.data(), buf.size());
+    writeAll(fh, offset, buf.data(), buf.size());
+    offset += buf.size();
+  }
+
+  MPI_File_close(&fh);
+  if(rank == 0) std::rename(tmpName.c_str(), fileName.c_str());
+  MPI_Barrier(comm);
+
+  if(rank == 0) printf("done (%gs)\n", MPI_Wtime() - tStart);
+  fflush(stdout);
+}
+
+void readCheckpoint(nrs_t* nrs, dfloat &time, int &tstep)
+{
+  const double tStart = MPI_Wtime();
+
+  std::string fileName;
+  platform->options.getArgs("RESTART FILE NAME", fileName);
+  if(platform->comm.mpiRank == 0) printf("reading checkpoint %s ... ", fileName.c_str());
+  fflush(stdout);
+
+  MPI_File fh = openFile(fileName);
+  const chkpHeader_t h = readHeader(fh);
+
+  std::vector<occa::memory> buffers = stateBuffers(nrs);
+  readBuffers(fh, h, 0, buffers);
+  MPI_File_close(&fh);
+
+  // geometric factors follow from the restored coordinates
+  for(auto& mesh : movingMeshes(nrs)) {
+    mesh->update();
+    mesh->o_x.copyTo(mesh->x, mesh->Nlocal * sizeof(dfloat));
+    mesh->o_y.copyTo(mesh->y, mesh->Nlocal * sizeof(dfloat));
+    mesh->o_z.copyTo(mesh->z, mesh->Nlocal * sizeof(dfloat));
+  }
+
+  // keep host copies in sync
+  nrs->o_U.copyTo(nrs->U, nrs->NVfields * nrs->fieldOffset * sizeof(dfloat));
+  nrs->o_P.copyTo(nrs->P, nrs->fieldOffset * sizeof(dfloat));
+  if(nrs->Nscalar) nrs->cds->o_S.copyTo(nrs->cds->S, nrs->cds->fieldOffsetSum * sizeof(dfloat));
+
+  // dt[0] is taken from the setup, dt[1:2] are the previous step sizes
+  nrs->dt[1] = h.dt[1];
+  nrs->dt[2] = h.dt[2];
+  for(int i = 0; i < 3; i++) nrs->p0th[i] = h.p0th[i];
+  nrs->dp0thdt = h.dp0thdt;
+  // ring buffer position of the o_Urst time levels
+  nrs->UrstHead = h.UrstHead;
+
+  time = h.time;
+  tstep = h.tstep;
+
+  if(platform->comm.mpiRank == 0) printf("done (%gs, step=%d)\n", MPI_Wtime() - tStart, tstep);
+  fflush(stdout);
+}
+
+void readCheckpointProjection(nrs_t* nrs)
+{
+  std::string fileName;
+  platform->options.getArgs("RESTART FILE NAME", fileName);
+
+  MPI_File fh = openFile(fileName);
+  const chkpHeader_t h = readHeader(fh);
+
+  if(h.Ncounters == 0) {
+    MPI_File_close(&fh);
+    return;
+  }
+
+  const int NstateBuffers = stateBuffers(nrs).size();
+  const std::vector<elliptic_t*> solvers = projectionSolvers(nrs);
+  if(h.Ncounters != 2 * (int) solvers.size() || h.Nbuffers != NstateBuffers + h.Ncounters) {
+    if(platform->comm.mpiRank == 0)
+      printf("residual projection setup has changed, skip restoring projection spaces\n");
+    MPI_File_close(&fh);
+    return;
+  }
+
+  std::vector<occa::memory> buffers = projectionBuffers(solvers);
+  readBuffers(fh, h, NstateBuffers, buffers);
+  MPI_File_close(&fh);
+
+  for(int i = 0; i < (int) solvers.size(); i++)
+    solvers[i]->residualProjection->setState(h.counters[2 * i], h.counters[2 * i + 1]);
+}
@@ -4,6 +4,10 @@ void copyFile(const char *srcName, const char* destName);
 bool isFileEmpty(const char *file);
 bool isFileNewer(const char *file1, const char* file2);
 bool fileExists(const char *file);
+void readRestart(nrs_t *nrs, dfloat &time);
+void writeCheckpoint(nrs_t *nrs, dfloat time, int tstep);
+void readCheckpoint(nrs_t *nrs, dfloat &time, int &tstep);
+void readCheckpointProjection(nrs_t *nrs);
 void writeFld(nrs_t *nrs, dfloat t);
 void writeFld(nrs_t *nrs, dfloat t, int FP64);
 void writeFld(const char* suffix, dfloat t, int coords, int FP64,
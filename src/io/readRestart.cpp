@@ -0,0 +1,393 @@
+#include <vector>
+#include <string>
+#include <sstream>
+#include <algorithm>
+#include <numeric>
+
+#include "nrs.hpp"
+#include "platform.hpp"
+#include "nekInterfaceAdapter.hpp"
+#include "io.hpp"
+
+// native reader for nek5000 field files (single file per output step)
+// every rank reads its own elements through MPI-IO, p-interpolation runs on the device
+
+namespace {
+
+constexpr int headerBytes = 132;
+constexpr float endianTag = 6.54321f;
+
+struct fldHeader_t
+{
+  int wdsize;
+  int Nq;
+  int NelementsFile;
+  int NelementsGlobal;
+  int Nfiles;
+  int step;
+  double time;
+  bool hasX, hasU, hasP, hasT;
+  int NS;
+};
+
+fldHeader_t parseHeader(const char* buf)
+{
+  fldHeader_t h;
+  std::string tag, rdcode;
+  int Ny, Nz, fid;
+  std::istringstream iss(std::string(buf, headerBytes));
+  iss >> tag >> h.wdsize >> h.Nq >> Ny >> Nz >> h.NelementsFile >> h.NelementsGlobal
+      >> h.time >> h.step >> fid >> h.Nfiles >> rdcode;
+
+  if(tag != "#std" || iss.fail()) {
+    if(platform->comm.mpiRank == 0) printf("ERROR: invalid header in restart file!\n");
+    ABORT(EXIT_FAILURE);
+  }
+
+  h.hasX = h.hasU = h.hasP = h.hasT = false;
+  h.NS = 0;
+  for(size_t i = 0; i < rdcode.size(); i++) {
+    if(rdcode[i] == 'X') h.hasX = true;
+    if(rdcode[i] == 'U') h.hasU = true;
+    if(rdcode[i] == 'P') h.hasP = true;
+    if(rdcode[i] == 'T') h.hasT = true;
+    if(rdcode[i] == 'S') {
+      h.NS = std::stoi(rdcode.substr(i + 1, 2));
+      i += 2;
+    }
+  }
+
+  return h;
+}
+
+void byteSwap(char* word, int wdsize)
+{
+  std::reverse(word, word + wdsize);
+}
+
+// reads a field (Ncomp components) for the given local elements
+// returns component major data [Ncomp][Nelements][Np]
+std::vector<dfloat> readField(MPI_File fh, MPI_Offset offset, const fldHeader_t& h, bool swap, int Ncomp,
+                              const std::vector<dlong>& filePos, const std::vector<dlong>& order)
+{
+  const dlong Nelements = filePos.size();
+  const int Np = h.Nq * h.Nq * h.Nq;
+  const int blockBytes = Ncomp * Np * h.wdsize;
+
+  std::vector<MPI_Aint> displacements(Nelements);
+  for(dlong i = 0; i < Nelements; i++)
+    displacements[i] = (MPI_Aint) filePos[order[i]] * blockBytes;
+
+  MPI_Datatype fileType;
+  MPI_Type_create_hindexed_block(Nelements, blockBytes, displacements.data(), MPI_BYTE, &fileType);
+  MPI_Type_commit(&fileType);
+
+  std::vector<char> buf((size_t) Nelements * blockBytes);
+  MPI_File_set_view(fh, offset, MPI_BYTE, fileType, "native", MPI_INFO_NULL);
+  MPI_File_read_all(fh, buf.data(), Nelements * blockBytes, MPI_BYTE, MPI_STATUS_IGNORE);
+  MPI_Type_free(&fileType);
+
+  std::vector<dfloat> field((size_t) Ncomp * Nelements * Np);
+  for(dlong i = 0; i < Nelements; i++) {
+    const dlong e = order[i];
+    for(int c = 0; c < Ncomp; c++)
+      for(int n = 0; n < Np; n++) {
+        char* word = buf.data() + (size_t) i * blockBytes + (c * Np + n) * h.wdsize;
+        if(swap) byteSwap(word, h.wdsize);
+        const dfloat val = (h.wdsize == 4) ? *((float*) word) : *((double*) word);
+        field[((size_t) c * Nelements + e) * Np + n] = val;
+      }
+  }
+
+  return field;
+}
+
+// all-to-all exchange of variable sized blocks, recvCounts is set on return
+template<typename T>
+std::vector<T> exchange(const std::vector<T>& send, const std::vector<int>& sendCounts,
+                        std::vector<int>& recvCounts, MPI_Datatype type, MPI_Comm comm)
+{
+  const int size = sendCounts.size();
+  recvCounts.resize(size);
+  MPI_Alltoall(sendCounts.data(), 1, MPI_INT, recvCounts.data(), 1, MPI_INT, comm);
+
+  std::vector<int> sendOffsets(size, 0), recvOffsets(size, 0);
+  for(int r = 1; r < size; r++) {
+    sendOffsets[r] = sendOffsets[r - 1] + sendCounts[r - 1];
+    recvOffsets[r] = recvOffsets[r - 1] + recvCounts[r - 1];
+  }
+  std::vector<T> recv(recvOffsets[size - 1] + recvCounts[size - 1]);
+  MPI_Alltoallv(send.data(), sendCounts.data(), sendOffsets.data(), type,
+                recv.data(), recvCounts.data(), recvOffsets.data(), type, comm);
+  return recv;
+}
+
+// file positions of the given (0-based) global element ids, -1 if not found
+// every rank reads a slice of the element id map, the (id, position) pairs and
+// the lookups meet on a directory rank owning a block of the global ids, so no
+// rank holds more than its own elements and a 1/size share of the map
+std::vector<dlong> elementPositions(MPI_File fh, const fldHeader_t& h, bool swap,
+                                   const std::vector<hlong>& ids)
+{
+  MPI_Comm comm = platform->comm.mpiComm;
+  const int rank = platform->comm.mpiRank;
+  const int size = platform->comm.mpiCommSize;
+  const hlong NelementsGlobal = h.NelementsGlobal;
+
+  auto directory = [&](hlong id) { return (int) ((id * size) / NelementsGlobal); };
+  const hlong idStart = ((hlong) rank * NelementsGlobal + size - 1) / size;
+  const hlong idEnd = ((hlong) (rank + 1) * NelementsGlobal + size - 1) / size;
+
+  const hlong first = (hlong) h.NelementsFile * rank / size;
+  const hlong last = (hlong) h.NelementsFile * (rank + 1) / size;
+  std::vector<int> fileIds(last - first);
+  MPI_File_read_at_all(fh, headerBytes + sizeof(float) + first * sizeof(int), fileIds.data(),
+                       fileIds.size(), MPI_INT, MPI_STATUS_IGNORE);
+  if(swap)
+    for(auto& id : fileIds) byteSwap((char*) &id, sizeof(int));
+
+  // (id, position) pairs to their directory rank
+  std::vector<dlong> positions(idEnd - idStart, -1);
+  {
+    std::vector<int> sendCounts(size, 0), recvCounts;
+    for(auto& id : fileIds) sendCounts[directory(id - 1)] += 2;
+    std::vector<int> offsets(size, 0);
+    for(int r = 1; r < size; r++) offsets[r] = offsets[r - 1] + sendCounts[r - 1];
+    std::vector<hlong> pairs(2 * fileIds.size());
+    for(size_t p = 0; p < fileIds.size(); p++) {
+      const hlong id = fileIds[p] - 1;
+      int& n = offsets[directory(id)];
+      pairs[n++] = id;
+      pairs[n++] = first + p;
+    }
+    auto recv = exchange(pairs, sendCounts, recvCounts, MPI_HLONG, comm);
+    for(size_t n = 0; n < recv.size(); n += 2)
+      positions[recv[n] - idStart] = recv[n + 1];
+  }
+
+  // look up the local ids on their directory ranks
+  std::vector<int> sendCounts(size, 0), recvCounts, replyCounts;
+  for(auto& id : ids) sendCounts[directory(id)]++;
+  std::vector<int> offsets(size, 0);
+  for(int r = 1; r < size; r++) offsets[r] = offsets[r - 1] + sendCounts[r - 1];
+  std::vector<hlong> request(ids.size());
+  std::vector<size_t> slot(ids.size());
+  for(size_t e = 0; e < ids.size(); e++) {
+    slot[e] = offsets[directory(ids[e])]++;
+    request[slot[e]] = ids[e];
+  }
+  auto lookups = exchange(request, sendCounts, recvCounts, MPI_HLONG, comm);
+
+  std::vector<dlong> answers(lookups.size());
+  for(size_t n = 0; n < lookups.size(); n++)
+    answers[n] = positions[lookups[n] - idStart];
+  auto reply = exchange(answers, recvCounts, replyCounts, MPI_DLONG, comm);
+
+  std::vector<dlong> filePos(ids.size());
+  for(size_t e = 0; e < ids.size(); e++) filePos[e] = reply[slot[e]];
+  return filePos;
+}
+
+}
+
+void readRestart(nrs_t* nrs, dfloat &time)
+{
+  mesh_t* mesh = nrs->_mesh;
+  mesh_t* meshV = nrs->meshV;
+
+  MPI_Barrier(platform->comm.mpiComm);
+  const double tStart = MPI_Wtime();
+
+  std::string restartOptions;
+  platform->options.getArgs("RESTART FILE NAME", restartOptions);
+  std::string fileName = restartOptions.substr(0, restartOptions.find('+'));
+
+  if(platform->comm.mpiRank == 0) printf("reading restart file %s ... ", fileName.c_str());
+  fflush(stdout);
+
+  if(platform->options.compareArgs("MOVING MESH", "TRUE")) {
+    if(platform->comm.mpiRank == 0) printf("\nERROR: native restart reader does not support moving meshes!\n");
+    ABORT(EXIT_FAILURE);
+  }
+
+  // field selection (default: all fields in the file)
+  bool readU = true, readP = true, readT = true, readS = true;
+  bool timeOverride = false;
+  double timeSet = 0;
+  {
+    std::vector<std::string> list;
+    std::istringstream iss(restartOptions);
+    std::string token;
+    std::getline(iss, token, '+');
+    while(std::getline(iss, token, '+')) {
+      std::transform(token.begin(), token.end(), token.begin(), ::toupper);
+      list.push_back(token);
+    }
+
+    bool selected = false;
+    for(auto& s : list)
+      if(s == "U" || s == "P" || s == "T" || s == "S") selected = true;
+    if(selected) {
+      readU = std::find(list.begin(), list.end(), "U") != list.end();
+      readP = std::find(list.begin(), list.end(), "P") != list.end();
+      readT = std::find(list.begin(), list.end(), "T") != list.end();
+      readS = std::find(list.begin(), list.end(), "S") != list.end();
+    }
+    for(auto& s : list) {
+      if(s.find("TIME=") == 0) {
+        timeOverride = true;
+        timeSet = std::stod(s.substr(5));
+      } else if(s == "INT") {
+        if(platform->comm.mpiRank == 0) printf("\nERROR: native restart reader does not support +int!\n");
+        ABORT(EXIT_FAILURE);
+      }
+    }
+  }
+
+  MPI_File fh;
+  int err = MPI_File_open(platform->comm.mpiComm, fileName.c_str(), MPI_MODE_RDONLY, MPI_INFO_NULL, &fh);
+  if(err != MPI_SUCCESS) {
+    if(platform->comm.mpiRank == 0) printf("\nERROR: cannot open restart file %s!\n", fileName.c_str());
+    ABORT(EXIT_FAILURE);
+  }
+
+  char header[headerBytes + sizeof(float)];
+  if(platform->comm.mpiRank == 0)
+    MPI_File_read_at(fh, 0, header, sizeof(header), MPI_BYTE, MPI_STATUS_IGNORE);
+  MPI_Bcast(header, sizeof(header), MPI_BYTE, 0, platform->comm.mpiComm);
+
+  const fldHeader_t h = parseHeader(header);
+
+  bool swap = false;
+  {
+    float tag;
+    memcpy(&tag, header + headerBytes, sizeof(float));
+    if(std::abs(tag - endianTag) > 1e-5) {
+      byteSwap((char*) &tag, sizeof(float));
+      swap = true;
+      if(std::abs(tag - endianTag) > 1e-5) {
+        if(platform->comm.mpiRank == 0) printf("\nERROR: cannot detect endianness of restart file!\n");
+        ABORT(EXIT_FAILURE);
+      }
+    }
+  }
+
+  if(h.Nfiles != 1 || h.NelementsFile != h.NelementsGlobal) {
+    if(platform->comm.mpiRank == 0) printf("\nERROR: native restart reader supports single file output only!\n");
+    ABORT(EXIT_FAILURE);
+  }
+
+  // map local elements to their position in the file
+  std::vector<hlong> globalIds(mesh->Nelements);
+  for(dlong e = 0; e < mesh->Nelements; e++) {
+    globalIds[e] = nek::lglel(e);
+    if(globalIds[e] >= h.NelementsGlobal) {
+      printf("\nERROR: element %d not found in restart file!\n", nek::lglel(e));
+      ABORT(EXIT_FAILURE);
+    }
+  }
+  std::vector<dlong> filePos = elementPositions(fh, h, swap, globalIds);
+  for(dlong e = 0; e < mesh->Nelements; e++) {
+    if(filePos[e] < 0) {
+      printf("\nERROR: element %d not found in restart file!\n", nek::lglel(e));
+      ABORT(EXIT_FAILURE);
+    }
+  }
+
+  // MPI-IO file views require monotonically increasing displacements
+  std::vector<dlong> order(mesh->Nelements);
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(), [&](dlong a, dlong b) { return filePos[a] < filePos[b]; });
+
+  // p-interpolation operator from file to simulation polynomial order
+  const int NqIn = h.Nq;
+  const int NpIn = NqIn * NqIn * NqIn;
+  const bool interpolate = (NqIn != mesh->Nq);
+  occa::kernel interpolateKernel;
+  occa::memory o_I;
+  if(interpolate) {
+    std::vector<dfloat> rIn(NqIn);
+    std::vector<dfloat> I(mesh->Nq * NqIn);
+    JacobiGLL(NqIn - 1, rIn.data());
+    InterpolationMatrix1D(NqIn - 1, NqIn, rIn.data(), mesh->Nq, mesh->gllz, I.data());
+    o_I = platform->device.malloc(I.size() * sizeof(dfloat), I.data());
+
+    std::string install_dir;
+    install_dir.assign(getenv("NEKRS_INSTALL_DIR"));
+    occa::properties kernelInfo = platform->kernelInfo;
+    kernelInfo["defines/p_NqIn"] = NqIn;
+    kernelInfo["defines/p_NqOut"] = mesh->Nq;
+    kernelInfo["defines/p_NqMax"] = std::max(NqIn, mesh->Nq);
+    kernelInfo["defines/p_NpIn"] = NpIn;
+    kernelInfo["defines/p_NpOut"] = mesh->Np;
+    interpolateKernel = platform->device.buildKernel(install_dir + "/okl/mesh/interpolateHex3D.okl",
+                                                     "interpolateHex3D", kernelInfo);
+  }
+
+  occa::memory o_in = platform->device.malloc((size_t) nrs->NVfields * mesh->Nelements * NpIn * sizeof(dfloat));
+
+  // copies/interpolates component c of the host field into o_out
+  auto toDevice = [&](const std::vector<dfloat>& field, int c, dlong Nelements, occa::memory o_out)
+  {
+    const size_t offset = (size_t) c * mesh->Nelements * NpIn;
+    o_in.copyFrom(field.data() + offset, Nelements * NpIn * sizeof(dfloat));
+    if(interpolate)
+      interpolateKernel(Nelements, o_I, o_in, o_out);
+    else
+      o_out.copyFrom(o_in, Nelements * NpIn * sizeof(dfloat));
+  };
+
+  MPI_Offset offset = headerBytes + sizeof(float) + (MPI_Offset) h.NelementsFile * sizeof(int);
+  const MPI_Offset scalarBytes = (MPI_Offset) h.NelementsFile * NpIn * h.wdsize;
+
+  if(h.hasX) offset += nrs->dim * scalarBytes;
+
+  if(h.hasU) {
+    if(readU) {
+      auto U = readField(fh, offset, h, swap, nrs->NVfields, filePos, order);
+      for(int c = 0; c < nrs->NVfields; c++)
+        toDevice(U, c, meshV->Nelements, nrs->o_U.slice(c * nrs->fieldOffset * sizeof(dfloat)));
+    }
+    offset += nrs->NVfields * scalarBytes;
+  }
+
+  if(h.hasP) {
+    if(readP) {
+      auto P = readField(fh, offset, h, swap, 1, filePos, order);
+      toDevice(P, 0, meshV->Nelements, nrs->o_P);
+    }
+    offset += scalarBytes;
+  }
+
+  cds_t* cds = nrs->cds;
+  if(h.hasT) {
+    if(readT && nrs->Nscalar) {
+      auto T = readField(fh, offset, h, swap, 1, filePos, order);
+      toDevice(T, 0, cds->mesh[0]->Nelements, cds->o_S.slice(cds->fieldOffsetScan[0] * sizeof(dfloat)));
+    }
+    offset += scalarBytes;
+  }
+
+  for(int is = 0; is < h.NS; is++) {
+    if(readS && is + 1 < nrs->Nscalar) {
+      auto S = readField(fh, offset, h, swap, 1, filePos, order);
+      toDevice(S, 0, cds->meshV->Nelements,
+               cds->o_S.slice(cds->fieldOffsetScan[is + 1] * sizeof(dfloat)));
+    }
+    offset += scalarBytes;
+  }
+
+  MPI_File_close(&fh);
+  o_in.free();
+
+  // keep host copies in sync
+  nrs->o_U.copyTo(nrs->U, nrs->NVfields * nrs->fieldOffset * sizeof(dfloat));
+  nrs->o_P.copyTo(nrs->P, nrs->fieldOffset * sizeof(dfloat));
+  if(nrs->Nscalar) cds->o_S.copyTo(cds->S, cds->fieldOffsetSum * sizeof(dfloat));
+
+  time = timeOverride ? timeSet : h.time;
+
+  MPI_Barrier(platform->comm.mpiComm);
+  if(platform->comm.mpiRank == 0) printf("done (%gs, N=%d)\n", MPI_Wtime() - tStart, NqIn - 1);
+  fflush(stdout);
+}
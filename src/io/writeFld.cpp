@@ -1,26 +1,103 @@
 #include "nrs.hpp"
 #include "nekInterfaceAdapter.hpp"
+#include "filter.hpp"
+
+namespace {
+bool firstOutput = true;
+int Nout = 0;
+occa::memory o_truncationMT;
+
+void setup(nrs_t* nrs)
+{
+  mesh_t* mesh = nrs->meshV;
+  platform->options.getArgs("SOLUTION OUTPUT MODES", Nout);
+  if(Nout <= 0 || Nout >= mesh->Nq) {
+    Nout = 0;
+    return;
+  }
+
+  dfloat* A = filterModalTruncation(mesh, Nout);
+  o_truncationMT = platform->device.malloc(mesh->Nq * mesh->Nq * sizeof(dfloat), A);
+  free(A);
+
+  if(platform->comm.mpiRank == 0)
+    printf("field output truncated to %d modes and written on %d^3 uniform points per element\n",
+           Nout, Nout);
+}
+
+// low-pass in the Legendre basis of each element, the result is exactly
+// represented on Nout points per direction
+occa::memory truncate(nrs_t* nrs, mesh_t* mesh, int Nfields, occa::memory o_in, occa::memory o_out)
+{
+  const dlong fieldOffset = nrs->fieldOffset;
+  nrs->filterKernel(mesh->Nelements, Nfields, fieldOffset, o_truncationMT, o_in, o_out);
+  return o_out;
+}
+}
 
 void writeFld(const char* suffix, dfloat t, int coords, int FP64,
               void* o_u, void* o_p, void* o_s,
               int NSfields)
 {
-  nek::outfld(suffix, t, coords, FP64, o_u, o_p, o_s, NSfields); 
+  nek::outfld(suffix, t, coords, FP64, o_u, o_p, o_s, NSfields);
 }
 
-void writeFld(nrs_t *nrs, dfloat t, int FP64) 
+void writeFld(nrs_t *nrs, dfloat t, int FP64)
 {
+  if(firstOutput) setup(nrs);
+
+  // geometry is in the first file of a series, following files only need it if the mesh moves
   int coords = 1;
+  if(!firstOutput &&
+     platform->options.compareArgs("SOLUTION OUTPUT COORDINATES", "ONCE") &&
+     !platform->options.compareArgs("MOVING MESH", "TRUE"))
+    coords = 0;
+  firstOutput = false;
+
+  occa::memory o_u, o_p, o_s;
+  if(!platform->options.compareArgs("VELOCITY WRITE TO FIELD FILE", "FALSE"))
+    o_u = nrs->o_U;
+  if(!platform->options.compareArgs("PRESSURE WRITE TO FIELD FILE", "FALSE"))
+    o_p = nrs->o_P;
+
   int Nscalar = 0;
-  occa::memory o_s;
+  std::vector<int> writeS(nrs->Nscalar + 1, 0);
   if(nrs->Nscalar) {
     o_s = nrs->cds->o_S;
     Nscalar = nrs->Nscalar;
+    for(int is = 0; is < Nscalar; is++) {
+      std::stringstream ss;
+      ss << std::setfill('0') << std::setw(2) << is;
+      writeS[is] = !platform->options.compareArgs("SCALAR" + ss.str() + " WRITE TO FIELD FILE", "FALSE");
+    }
   }
-  nek::outfld("   ", t, coords, FP64, &nrs->o_U, &nrs->o_P, &o_s, Nscalar); 
+
+  occa::memory o_fld;
+  if(Nout) {
+    // velocity, pressure and scalars
+    o_fld = platform->scratch.acquireFields(nrs->NVfields + 1 + nrs->Nscalar);
+    const dlong offset = nrs->fieldOffset;
+    if(o_u.ptr())
+      o_u = truncate(nrs, nrs->meshV, nrs->NVfields, o_u, o_fld);
+    if(o_p.ptr())
+      o_p = truncate(nrs, nrs->meshV, 1, o_p, o_fld + nrs->NVfields * offset * sizeof(dfloat));
+    if(o_s.ptr()) {
+      occa::memory o_sOut = o_fld + (nrs->NVfields + 1) * offset * sizeof(dfloat);
+      for(int is = 0; is < Nscalar; is++) {
+        if(!writeS[is]) continue;
+        mesh_t* mesh = (is) ? nrs->meshV : nrs->cds->mesh[0];
+        truncate(nrs, mesh, 1, o_s + is * offset * sizeof(dfloat), o_sOut + is * offset * sizeof(dfloat));
+      }
+      o_s = o_sOut;
+    }
+  }
+
+  nek::outfld("   ", t, coords, FP64, &o_u, &o_p, &o_s, Nscalar, writeS.data(), Nout);
+
+  if(Nout) platform->scratch.release(o_fld);
 }
 
-void writeFld(nrs_t *nrs, dfloat t) 
+void writeFld(nrs_t *nrs, dfloat t)
 {
-  writeFld(nrs, t, 0); 
+  writeFld(nrs, t, 0);
 }
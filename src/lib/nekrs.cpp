@@ -9,6 +9,8 @@
 #include "platform.hpp"
 #include "nrssys.hpp"
 #include "linAlg.hpp"
+#include "probes.hpp"
+#include "particles.hpp"
 
 // extern variable from nrssys.hpp
 platform_t* platform;
@@ -32,6 +34,13 @@ double startTime(void)
   return val;
 }
 
+int startStep(void)
+{
+  int val = 0;
+  platform->options.getArgs("START STEP", val);
+  return val;
+}
+
 void setup(MPI_Comm comm_in, int buildOnly, int commSizeTarget,
            int ciMode, string cacheDir, string _setupFile,
            string _backend, string _deviceID)
@@ -109,36 +118,53 @@ void setup(MPI_Comm comm_in, int buildOnly, int commSizeTarget,
 
   nrsSetup(comm, options, nrs);
 
-  nrs->o_U.copyFrom(nrs->U);
+  // only the current level, a checkpoint restart has put the lagged levels on the device already
+  nrs->o_U.copyFrom(nrs->U, nrs->NVfields * nrs->fieldOffset * sizeof(dfloat));
   nrs->o_P.copyFrom(nrs->P);
   nrs->o_prop.copyFrom(nrs->prop);
   if(nrs->Nscalar) {
-    nrs->cds->o_S.copyFrom(nrs->cds->S);
+    nrs->cds->o_S.copyFrom(nrs->cds->S, nrs->cds->fieldOffsetSum * sizeof(dfloat));
     nrs->cds->o_prop.copyFrom(nrs->cds->prop);
   }
 
   if(udf.properties) {
-    occa::memory o_S = platform->o_mempool.slice0;
-    occa::memory o_SProp = platform->o_mempool.slice0;
+    occa::memory o_dummy = platform->scratch.acquireFields(1);
+    occa::memory o_S = o_dummy;
+    occa::memory o_SProp = o_dummy;
     if(nrs->Nscalar) {
       o_S = nrs->cds->o_S;
       o_SProp = nrs->cds->o_prop;
     }
     udf.properties(nrs, startTime(), nrs->o_U, o_S,
                    nrs->o_prop, o_SProp);
+    platform->scratch.release(o_dummy);
     nrs->o_prop.copyTo(nrs->prop);
     if(nrs->Nscalar) nrs->cds->o_prop.copyTo(nrs->cds->prop);
   }
 
-  nek::ocopyToNek(startTime(), 0);
+  nek::ocopyToNek(startTime(), startStep());
+
+  string probesFile;
+  options.getArgs("PROBES FILE", probesFile);
+  if(!probesFile.empty()) probes::setup(nrs, probesFile);
+
+  string particlesFile;
+  options.getArgs("PARTICLES FILE", particlesFile);
+  if(!particlesFile.empty()) particles::setup(nrs, particlesFile);
+
+  // host mirrors were released by the transfer to nek, drop the zero buffer for device allocations too
+  if(options.compareArgs("HOST MIRRORS", "LAZY"))
+    platform->device.freeHostBuffer();
 
   platform->timer.toc("setup");
   const double setupTime = platform->timer.query("setup", "DEVICE:MAX");
   if(rank == 0) {
     cout << "\nsettings:\n" << endl << options << endl;
     cout << "device memory usage: " << platform->device.memoryAllocated()/1e9 << " GB" << endl;
-    cout << "initialization took " << setupTime << " s" << endl;
   }
+  platform->memory.print(comm);
+  if(rank == 0)
+    cout << "initialization took " << setupTime << " s" << endl;
   fflush(stdout);
 
   platform->timer.reset();
@@ -148,6 +174,8 @@ void setup(MPI_Comm comm_in, int buildOnly, int commSizeTarget,
 void runStep(double time, double dt, int tstep)
 {
   runStep(nrs, time, dt, tstep);
+  probes::run(time + dt, tstep);
+  particles::run(time, dt, tstep);
 }
 
 void copyFromNek(double time, int tstep)
@@ -218,6 +246,18 @@ void outfld(double time)
   lastOutputTime = time;
 }
 
+int checkpointInterval(void)
+{
+  int val = 0;
+  platform->options.getArgs("CHECKPOINT INTERVAL", val);
+  return val;
+}
+
+void checkpoint(double time, int tstep)
+{
+  writeCheckpoint(nrs, time, tstep);
+}
+
 double endTime(void)
 {
   double endTime = -1;
@@ -242,7 +282,7 @@ int lastStep(double time, int tstep, double elapsedTime)
      const double eps = 1e-12;
      nrs->lastStep = fabs((time+nrs->dt[0]) - endTime()) < eps || (time+nrs->dt[0]) > endTime();
   } else {
-    nrs->lastStep = tstep == numSteps();
+    nrs->lastStep = tstep - startStep() == numSteps();
   }
 
   return nrs->lastStep;
@@ -263,7 +303,8 @@ void* nrsPtr(void)
 void printRuntimeStatistics()
 {
   platform_t* platform = platform_t::getInstance(options, comm);
-  platform->timer.printRunStat();
+  mesh_t* mesh = (nrs->cht) ? nrs->cds->mesh[0] : nrs->meshV;
+  platform->timer.printRunStat(mesh->Nelements);
 }
 } // namespace
 
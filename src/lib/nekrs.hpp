@@ -14,6 +14,7 @@ void runStep(double time, double dt, int tstep);
 void copyFromNek(double time, int tstep);
 void udfExecuteStep(double time, int tstep, int isOutputStep);
 void outfld(double time);
+void checkpoint(double time, int tstep);
 int outputStep(double time, int tStep);
 void outputStep(int val);
 void nekUserchk(void);
@@ -21,10 +22,12 @@ void printRuntimeStatistics(void);
 double writeInterval(void);
 double dt(void);
 double startTime(void);
+int startStep(void);
 double endTime(void);
 int numSteps(void);
 int lastStep(double time, int tstep, double elapsedTime);
 int writeControlRunTime(void);
+int checkpointInterval(void);
 
 void* nrsPtr(void);
 void* nekPtr(const char* id);
@@ -1,6 +1,7 @@
 #include "nrs.hpp"
 #include "udf.hpp"
 #include "linAlg.hpp"
+#include <limits>
 
 namespace tombo
 {
@@ -8,9 +9,12 @@ occa::memory pressureSolve(nrs_t* nrs, dfloat time, int stage)
 {
   mesh_t* mesh = nrs->meshV;
   
+  occa::memory o_Pnew = platform->scratch.acquireFields(1);
 
   //enforce Dirichlet BCs
-  platform->linAlg->fill((1+nrs->NVfields)*nrs->fieldOffset, std::numeric_limits<dfloat>::min(), platform->o_mempool.slice6);
+  occa::memory o_PBC = platform->scratch.acquireFields(1+nrs->NVfields);
+  occa::memory o_UBC = o_PBC.slice(nrs->fieldOffset * sizeof(dfloat));
+  platform->linAlg->fill((1+nrs->NVfields)*nrs->fieldOffset, std::numeric_limits<dfloat>::min(), o_PBC);
   for (int sweep = 0; sweep < 2; sweep++) {
     nrs->pressureDirichletBCKernel(mesh->Nelements,
                                    time,
@@ -25,7 +29,7 @@ occa::memory pressureSolve(nrs_t* nrs, dfloat time, int stage)
                                    nrs->o_usrwrk,
                                    nrs->o_U,
                                    nrs->o_P,
-                                   platform->o_mempool.slice6);
+                                   o_PBC);
 
     nrs->velocityDirichletBCKernel(mesh->Nelements,
                                    nrs->fieldOffset,
@@ -40,215 +44,256 @@ occa::memory pressureSolve(nrs_t* nrs, dfloat time, int stage)
                                    nrs->o_VmapB,
                                    nrs->o_usrwrk,
                                    nrs->o_U,
-                                   platform->o_mempool.slice7);
+                                   o_UBC);
 
     //take care of Neumann-Dirichlet shared edges across elements
-    if (sweep == 0) oogs::startFinish(platform->o_mempool.slice6, 1+nrs->NVfields, nrs->fieldOffset, ogsDfloat, ogsMax, nrs->gsh);
-    if (sweep == 1) oogs::startFinish(platform->o_mempool.slice6, 1+nrs->NVfields, nrs->fieldOffset, ogsDfloat, ogsMin, nrs->gsh);
+    if (sweep == 0) oogs::startFinish(o_PBC, 1+nrs->NVfields, nrs->fieldOffset, ogsDfloat, ogsMax, nrs->gsh);
+    if (sweep == 1) oogs::startFinish(o_PBC, 1+nrs->NVfields, nrs->fieldOffset, ogsDfloat, ogsMin, nrs->gsh);
   }
 
   if (nrs->pSolver->Nmasked) nrs->maskCopyKernel(nrs->pSolver->Nmasked, 0, nrs->pSolver->o_maskIds,
-                                                 platform->o_mempool.slice6, nrs->o_P); 
+                                                 o_PBC, nrs->o_P); 
 
   if (nrs->uvwSolver) {
     if (nrs->uvwSolver->Nmasked) nrs->maskCopyKernel(nrs->uvwSolver->Nmasked, 0*nrs->fieldOffset, nrs->uvwSolver->o_maskIds,
-                                                     platform->o_mempool.slice7, nrs->o_U);
+                                                     o_UBC, nrs->o_U);
   } else {
     if (nrs->uSolver->Nmasked) nrs->maskCopyKernel(nrs->uSolver->Nmasked, 0*nrs->fieldOffset, nrs->uSolver->o_maskIds, 
-                                                   platform->o_mempool.slice7, nrs->o_U);
+                                                   o_UBC, nrs->o_U);
     if (nrs->vSolver->Nmasked) nrs->maskCopyKernel(nrs->vSolver->Nmasked, 1*nrs->fieldOffset, nrs->vSolver->o_maskIds, 
-                                                   platform->o_mempool.slice7, nrs->o_U);
+                                                   o_UBC, nrs->o_U);
     if (nrs->wSolver->Nmasked) nrs->maskCopyKernel(nrs->wSolver->Nmasked, 2*nrs->fieldOffset, nrs->wSolver->o_maskIds, 
-                                                   platform->o_mempool.slice7, nrs->o_U);
+                                                   o_UBC, nrs->o_U);
+  }
+  platform->scratch.release(o_PBC);
+
+  occa::memory o_curl = platform->scratch.acquireFields(nrs->NVfields);
+  occa::memory o_rhs = platform->scratch.acquireFields(nrs->NVfields);
+  occa::memory o_wrk = platform->scratch.acquireFields(nrs->NVfields);
+
+  // the RHS assembly has no time dependent arguments, unlike the BCs above
+  launchGraph_t& graph = nrs->pressureRhsGraph;
+  const std::string graphKey = launchGraph_t::key(nrs->g0 * nrs->idt, o_Pnew, o_curl, o_rhs, o_wrk);
+  if(!graph.replay(graphKey)) {
+    graph.beginCapture(graphKey);
+
+    graph(nrs->curlKernel,
+      mesh->Nelements,
+      mesh->o_vgeo,
+      mesh->o_D,
+      nrs->fieldOffset,
+      nrs->o_Ue,
+      o_curl);
+
+    graph.host([=]() mutable { oogs::startFinish(o_curl, nrs->NVfields, nrs->fieldOffset,ogsDfloat, ogsAdd, nrs->gsh); });
+
+    graph.host([=]() mutable {
+      platform->linAlg->axmyVector(
+        mesh->Nlocal,
+        nrs->fieldOffset,
+        0,
+        1.0,
+        nrs->meshV->o_invLMM,
+        o_curl
+      );
+    });
+
+    graph(nrs->curlKernel,
+      mesh->Nelements,
+      mesh->o_vgeo,
+      mesh->o_D,
+      nrs->fieldOffset,
+      o_curl,
+      o_rhs);
+
+    graph(nrs->gradientVolumeKernel,
+      mesh->Nelements,
+      mesh->o_vgeo,
+      mesh->o_D,
+      nrs->fieldOffset,
+      nrs->o_div,
+      o_curl);
+
+    if(platform->options.compareArgs("STRESSFORMULATION", "TRUE"))
+      graph(nrs->pressureStressKernel,
+           mesh->Nelements,
+           mesh->o_vgeo,
+           mesh->o_D,
+           nrs->fieldOffset,
+           nrs->o_mue,
+           nrs->o_Ue,
+           nrs->o_div,
+           o_rhs);
+
+    occa::memory o_irho = nrs->o_ellipticCoeff;
+    graph(nrs->pressureRhsKernel,
+      mesh->Nelements * mesh->Np,
+      nrs->fieldOffset,
+      nrs->o_mue,
+      o_irho,
+      nrs->o_BF,
+      o_rhs,
+      o_curl,
+      o_wrk);
+
+    graph.host([=]() mutable { oogs::startFinish(o_wrk, nrs->NVfields, nrs->fieldOffset,ogsDfloat, ogsAdd, nrs->gsh); });
+
+    graph.host([=]() mutable {
+      platform->linAlg->axmyVector(
+        mesh->Nlocal,
+        nrs->fieldOffset,
+        0,
+        1.0,
+        nrs->meshV->o_invLMM,
+        o_wrk
+      );
+    });
+
+    graph(nrs->wDivergenceVolumeKernel,
+      mesh->Nelements,
+      mesh->o_vgeo,
+      mesh->o_D,
+      nrs->fieldOffset,
+      o_wrk,
+      o_rhs);
+
+    graph(nrs->pressureAddQtlKernel,
+      mesh->Nelements,
+      mesh->o_vgeo,
+      nrs->g0 * nrs->idt,
+      nrs->o_div,
+      o_rhs);
+
+    graph(nrs->divergenceSurfaceKernel,
+      mesh->Nelements,
+      mesh->o_sgeo,
+      mesh->o_vmapM,
+      nrs->o_EToB,
+      nrs->g0 * nrs->idt,
+      nrs->fieldOffset,
+      o_wrk,
+      nrs->o_U,
+      o_rhs);
+
+    graph.host([=]() mutable { o_Pnew.copyFrom(nrs->o_P, mesh->Nlocal * sizeof(dfloat)); });
+
+    graph.endCapture();
   }
 
-  nrs->curlKernel(mesh->Nelements,
-                  mesh->o_vgeo,
-                  mesh->o_D,
-                  nrs->fieldOffset,
-                  nrs->o_Ue,
-                  platform->o_mempool.slice0);
+  platform->scratch.release(o_wrk);
 
-  oogs::startFinish(platform->o_mempool.slice0, nrs->NVfields, nrs->fieldOffset,ogsDfloat, ogsAdd, nrs->gsh);
-  
-  platform->linAlg->axmyVector(
-    mesh->Nlocal,
-    nrs->fieldOffset,
-    0,
-    1.0,
-    nrs->meshV->o_invLMM,
-    platform->o_mempool.slice0
-  );
-
-  nrs->curlKernel(
-    mesh->Nelements,
-    mesh->o_vgeo,
-    mesh->o_D,
-    nrs->fieldOffset,
-    platform->o_mempool.slice0,
-    platform->o_mempool.slice3);
-
-  nrs->gradientVolumeKernel(
-    mesh->Nelements,
-    mesh->o_vgeo,
-    mesh->o_D,
-    nrs->fieldOffset,
-    nrs->o_div,
-    platform->o_mempool.slice0);
-
-  if(platform->options.compareArgs("STRESSFORMULATION", "TRUE"))
-    nrs->pressureStressKernel(
-         mesh->Nelements,
-         mesh->o_vgeo,
-         mesh->o_D,
-         nrs->fieldOffset,
-         nrs->o_mue,
-         nrs->o_Ue,
-         nrs->o_div,
-         platform->o_mempool.slice3);
-
-  occa::memory o_irho = nrs->o_ellipticCoeff;
-  nrs->pressureRhsKernel(
-    mesh->Nelements * mesh->Np,
-    nrs->fieldOffset,
-    nrs->o_mue,
-    o_irho,
-    nrs->o_BF,
-    platform->o_mempool.slice3,
-    platform->o_mempool.slice0,
-    platform->o_mempool.slice6);
-
-
-  oogs::startFinish(platform->o_mempool.slice6, nrs->NVfields, nrs->fieldOffset,ogsDfloat, ogsAdd, nrs->gsh);
-
-  platform->linAlg->axmyVector(
-    mesh->Nlocal,
-    nrs->fieldOffset,
-    0,
-    1.0,
-    nrs->meshV->o_invLMM,
-    platform->o_mempool.slice6
-  );
-
-  nrs->wDivergenceVolumeKernel(
-    mesh->Nelements,
-    mesh->o_vgeo,
-    mesh->o_D,
-    nrs->fieldOffset,
-    platform->o_mempool.slice6,
-    platform->o_mempool.slice3);
-
-
-  nrs->pressureAddQtlKernel(
-    mesh->Nelements,
-    mesh->o_vgeo,
-    nrs->g0 * nrs->idt,
-    nrs->o_div,
-    platform->o_mempool.slice3);
-
-  nrs->divergenceSurfaceKernel(
-    mesh->Nelements,
-    mesh->o_sgeo,
-    mesh->o_vmapM,
-    nrs->o_EToB,
-    nrs->g0 * nrs->idt,
-    nrs->fieldOffset,
-    platform->o_mempool.slice6,
-    nrs->o_U,
-    platform->o_mempool.slice3);
-
-  platform->o_mempool.slice1.copyFrom(nrs->o_P, mesh->Nlocal * sizeof(dfloat));
-  ellipticSolve(nrs->pSolver, platform->o_mempool.slice3, platform->o_mempool.slice1);
-
-  return platform->o_mempool.slice1;
+  ellipticSolve(nrs->pSolver, o_rhs, o_Pnew);
+
+  platform->scratch.release(o_rhs);
+  platform->scratch.release(o_curl);
+
+  return o_Pnew;
 }
 
 occa::memory velocitySolve(nrs_t* nrs, dfloat time, int stage)
 {
   mesh_t* mesh = nrs->meshV;
   
-  dfloat scale = -1./3;
-  if(platform->options.compareArgs("STRESSFORMULATION", "TRUE")) scale = 2./3;
-
-  nrs->mueDivKernel(
-       mesh->Nelements*mesh->Np,
-       scale,
-       nrs->o_mue,
-       nrs->o_div,
-       platform->o_mempool.slice3); 
-
-  nrs->gradientVolumeKernel(
-    mesh->Nelements,
-    mesh->o_vgeo,
-    mesh->o_D,
-    nrs->fieldOffset,
-    platform->o_mempool.slice3,
-    platform->o_mempool.slice0);
-
-  nrs->wgradientVolumeKernel(
-    mesh->Nelements,
-    mesh->o_vgeo,
-    mesh->o_D,
-    nrs->fieldOffset,
-    nrs->o_P,
-    platform->o_mempool.slice3); 
-
-  platform->linAlg->axpby(
-    nrs->NVfields*nrs->fieldOffset,
-    1.0,
-    platform->o_mempool.slice3,
-    -1.0,
-    platform->o_mempool.slice0);
-
-  nrs->velocityNeumannBCKernel(
-       mesh->Nelements,
-       nrs->fieldOffset,
-       mesh->o_sgeo,
-       mesh->o_vmapM,
-       mesh->o_EToB,
-       nrs->o_EToB,
-       time,
-       mesh->o_x,
-       mesh->o_y,
-       mesh->o_z,
-       nrs->o_usrwrk,
-       nrs->o_U,
-       platform->o_mempool.slice0); 
-
-  nrs->velocityRhsKernel(
-    mesh->Nelements,
-    nrs->fieldOffset,
-    nrs->o_BF,
-    platform->o_mempool.slice0,
-    nrs->o_rho,
-    platform->o_mempool.slice3);
-
-  if(platform->options.compareArgs("VELOCITY INITIAL GUESS DEFAULT", "EXTRAPOLATION") && stage == 1) { 
-    platform->o_mempool.slice0.copyFrom(nrs->o_Ue, nrs->NVfields * nrs->fieldOffset * sizeof(dfloat));
-    if (nrs->uvwSolver) {
-      if (nrs->uvwSolver->Nmasked) nrs->maskCopyKernel(nrs->uvwSolver->Nmasked, 0*nrs->fieldOffset, nrs->uvwSolver->o_maskIds,
-                                                       nrs->o_U, platform->o_mempool.slice0);
-    } else {
-      if (nrs->uSolver->Nmasked) nrs->maskCopyKernel(nrs->uSolver->Nmasked, 0*nrs->fieldOffset, nrs->uSolver->o_maskIds,
-                                                     nrs->o_U, platform->o_mempool.slice0);
-      if (nrs->vSolver->Nmasked) nrs->maskCopyKernel(nrs->vSolver->Nmasked, 1*nrs->fieldOffset, nrs->vSolver->o_maskIds,
-                                                     nrs->o_U, platform->o_mempool.slice0);
-      if (nrs->wSolver->Nmasked) nrs->maskCopyKernel(nrs->wSolver->Nmasked, 2*nrs->fieldOffset, nrs->wSolver->o_maskIds,
-                                                     nrs->o_U, platform->o_mempool.slice0);
+  occa::memory o_Unew = platform->scratch.acquireFields(nrs->NVfields);
+  occa::memory o_rhs = platform->scratch.acquireFields(nrs->NVfields);
+
+  const bool extrapolatedGuess =
+    platform->options.compareArgs("VELOCITY INITIAL GUESS DEFAULT", "EXTRAPOLATION") && stage == 1;
+
+  // the Neumann BC gets the time as argument and runs after the recorded part,
+  // the mask copies only touch o_Unew
+  launchGraph_t& graph = nrs->velocityRhsGraph;
+  const std::string graphKey = launchGraph_t::key(extrapolatedGuess, udf.div != nullptr, o_rhs, o_Unew);
+  if(!graph.replay(graphKey)) {
+    graph.beginCapture(graphKey);
+
+    occa::kernel& velocityRhsKernel = udf.div ? nrs->velocityRhsDivKernel : nrs->velocityRhsKernel;
+    graph(velocityRhsKernel,
+      mesh->Nelements,
+      mesh->o_vgeo,
+      mesh->o_D,
+      nrs->fieldOffset,
+      nrs->o_mue,
+      nrs->o_div,
+      nrs->o_P,
+      nrs->o_BF,
+      nrs->o_rho,
+      extrapolatedGuess ? nrs->o_Ue : nrs->o_U,
+      o_rhs,
+      o_Unew);
+
+    if(extrapolatedGuess) { 
+      if (nrs->uvwSolver) {
+        if (nrs->uvwSolver->Nmasked) graph(nrs->maskCopyKernel, nrs->uvwSolver->Nmasked, 0*nrs->fieldOffset, nrs->uvwSolver->o_maskIds,
+                                           nrs->o_U, o_Unew);
+      } else {
+        if (nrs->uSolver->Nmasked) graph(nrs->maskCopyKernel, nrs->uSolver->Nmasked, 0*nrs->fieldOffset, nrs->uSolver->o_maskIds,
+                                         nrs->o_U, o_Unew);
+        if (nrs->vSolver->Nmasked) graph(nrs->maskCopyKernel, nrs->vSolver->Nmasked, 1*nrs->fieldOffset, nrs->vSolver->o_maskIds,
+                                         nrs->o_U, o_Unew);
+        if (nrs->wSolver->Nmasked) graph(nrs->maskCopyKernel, nrs->wSolver->Nmasked, 2*nrs->fieldOffset, nrs->wSolver->o_maskIds,
+                                         nrs->o_U, o_Unew);
+      }
     }
-  } else {
-    platform->o_mempool.slice0.copyFrom(nrs->o_U, nrs->NVfields * nrs->fieldOffset * sizeof(dfloat));
+
+    graph.endCapture();
   }
 
+  if(nrs->velocityNeumannBC)
+    nrs->velocityNeumannBCKernel(
+         mesh->Nelements,
+         nrs->fieldOffset,
+         mesh->o_sgeo,
+         mesh->o_vmapM,
+         mesh->o_EToB,
+         nrs->o_EToB,
+         time,
+         mesh->o_x,
+         mesh->o_y,
+         mesh->o_z,
+         nrs->o_usrwrk,
+         nrs->o_U,
+         o_rhs); 
+
   if(nrs->uvwSolver) {
-    ellipticSolve(nrs->uvwSolver, platform->o_mempool.slice3, platform->o_mempool.slice0);
+    ellipticSolve(nrs->uvwSolver, o_rhs, o_Unew);
   } else {
-    ellipticSolve(nrs->uSolver, platform->o_mempool.slice3, platform->o_mempool.slice0);
-    ellipticSolve(nrs->vSolver, platform->o_mempool.slice4, platform->o_mempool.slice1);
-    ellipticSolve(nrs->wSolver, platform->o_mempool.slice5, platform->o_mempool.slice2);
+    occa::memory o_rhsV = o_rhs.slice(1 * nrs->fieldOffset * sizeof(dfloat));
+    occa::memory o_rhsW = o_rhs.slice(2 * nrs->fieldOffset * sizeof(dfloat));
+    occa::memory o_V = o_Unew.slice(1 * nrs->fieldOffset * sizeof(dfloat));
+    occa::memory o_W = o_Unew.slice(2 * nrs->fieldOffset * sizeof(dfloat));
+    ellipticSolve(nrs->uSolver, o_rhs, o_Unew);
+    ellipticSolve(nrs->vSolver, o_rhsV, o_V);
+    ellipticSolve(nrs->wSolver, o_rhsW, o_W);
   }
 
-  return platform->o_mempool.slice0;
+  platform->scratch.release(o_rhs);
+
+  return o_Unew;
+}
+
+occa::memory meshSolve(nrs_t* nrs, dfloat time, int stage)
+{
+  mesh_t* mesh = nrs->meshV;
+  elliptic_t* solver = nrs->meshSolver;
+
+  occa::memory o_Unew = platform->scratch.acquireFields(nrs->NVfields);
+  occa::memory o_rhs = platform->scratch.acquireFields(nrs->NVfields);
+
+  // previous mesh velocity as initial guess, Dirichlet values are zero (fixed)
+  // or the fluid velocity (moving boundaries)
+  o_Unew.copyFrom(mesh->o_U, nrs->NVfields * nrs->fieldOffset * sizeof(dfloat));
+  if (solver->Nmasked) mesh->maskKernel(solver->Nmasked, solver->o_maskIds, o_Unew);
+  if (nrs->NmeshFluidIds) nrs->maskCopyKernel(nrs->NmeshFluidIds, 0, nrs->o_meshFluidIds,
+                                              nrs->o_U, o_Unew);
+
+  platform->linAlg->fill(nrs->NVfields * nrs->fieldOffset, 0.0, o_rhs);
+
+  ellipticSolve(solver, o_rhs, o_Unew);
+
+  platform->scratch.release(o_rhs);
+
+  return o_Unew;
 }
 
 } // namespace
@@ -7,6 +7,7 @@ namespace tombo
 {
 occa::memory pressureSolve(nrs_t* nrs, dfloat time, int stage);
 occa::memory velocitySolve(nrs_t* nrs, dfloat time, int stage);
+occa::memory meshSolve(nrs_t* nrs, dfloat time, int stage);
 }
 
 #endif
@@ -138,7 +138,7 @@ int main(int argc, char** argv)
   double elapsedTime = (MPI_Wtime() - time0);
 
   const int runTimeStatFreq = 500;
-  int tStep = 0;
+  int tStep = nekrs::startStep();
   double time = nekrs::startTime();
   int lastStep = nekrs::lastStep(time, tStep, elapsedTime);
 
@@ -175,6 +175,10 @@ int main(int argc, char** argv)
 
     if (outputStep) nekrs::outfld(time); 
 
+    const int checkpointInterval = nekrs::checkpointInterval();
+    if (checkpointInterval > 0 && (tStep%checkpointInterval == 0 || lastStep))
+      nekrs::checkpoint(time, tStep);
+
     if (tStep%runTimeStatFreq == 0 || lastStep) nekrs::printRuntimeStatistics();
 
     MPI_Barrier(comm);
@@ -47,7 +47,8 @@ struct mesh_t
   void move();
   void update();
   void computeInvLMM();
-  void solve();
+
+  int geometryVersion = 0; // incremented by update()
 
   int nAB;
   dfloat* coeffAB; // coefficients for AB integration
@@ -22,6 +22,8 @@ void mesh_t::move(){
   update();
 }
 void mesh_t::update(){
+    geometryVersion++;
+    occa::memory o_J = platform->scratch.acquire(Nelements * Np * sizeof(dfloat));
     geometricFactorsKernel(
         Nelements,
         1,
@@ -36,12 +38,13 @@ void mesh_t::update(){
         o_vgeo,
         o_ggeo,
         o_cubvgeo,
-        platform->o_mempool.slice0
+        o_J
     );
 
     // do add check if negative
-    const dfloat minJ = platform->linAlg->min(Nelements * Np, platform->o_mempool.slice0, platform->comm.mpiComm);
-    const dfloat maxJ = platform->linAlg->max(Nelements * Np, platform->o_mempool.slice0, platform->comm.mpiComm);
+    const dfloat minJ = platform->linAlg->min(Nelements * Np, o_J, platform->comm.mpiComm);
+    const dfloat maxJ = platform->linAlg->max(Nelements * Np, o_J, platform->comm.mpiComm);
+    platform->scratch.release(o_J);
 
     if(minJ < 0 || maxJ < 0) {
       if(platform->options.compareArgs("GALERKIN COARSE OPERATOR","FALSE") ||
@@ -65,6 +68,3 @@ void mesh_t::update(){
         o_sgeo
     );
 }
-void mesh_t::solve()
-{
-}
@@ -289,19 +289,23 @@ c-----------------------------------------------------------------------
 
       include 'SIZE'
       include 'TOTAL'
+      include 'RESTART'
       include 'NEKINTF'
 
       real ts
-      integer npscals, p63s
-      logical ifxyos, ifvos, ifpos, iftos, ifpscos(ldimt1)
+      integer npscals, p63s, nrgs
+      logical ifxyos, ifvos, ifpos, iftos, ifpscos(ldimt1), ifreguos
       common /ros/  ts
-      common /ios/  npscals, p63s
-      common /ifos/ ifxyos, ifvos, ifpos, iftos, ifpscos
+      common /ios/  npscals, p63s, nrgs
+      common /ifos/ ifxyos, ifvos, ifpos, iftos, ifpscos, ifreguos
 
       time = ts
 
       param(63) = p63s
 
+      nrg     = nrgs
+      ifreguo = ifreguos
+
       npscal = npscals
       ifxyo  = ifxyos 
       ifvo   = ifvos 
@@ -314,22 +318,23 @@ c-----------------------------------------------------------------------
       return
       end
 c-----------------------------------------------------------------------
-      subroutine nekf_setio(ttime, xo, vo, po, so, ns, fp64)
+      subroutine nekf_setio(ttime, xo, vo, po, so, ns, fp64, nout)
 
       include 'SIZE'
       include 'TOTAL'
+      include 'RESTART'
       include 'NEKINTF'
 
       real ttime
-      integer xo, vo, po, so, fp64
+      integer xo, vo, po, so(*), fp64, nout
 
       real ts
-      integer npscals, p63s
-      logical ifxyos, ifvos, ifpos, iftos, ifpscos(ldimt1)
+      integer npscals, p63s, nrgs
+      logical ifxyos, ifvos, ifpos, iftos, ifpscos(ldimt1), ifreguos
 
       common /ros/  ts
-      common /ios/  npscals, p63s
-      common /ifos/ ifxyos, ifvos, ifpos, iftos, ifpscos
+      common /ios/  npscals, p63s, nrgs
+      common /ifos/ ifxyos, ifvos, ifpos, iftos, ifpscos, ifreguos
 
       if(ns.gt.ldimt) call exitti('nekf_setifo: ns > ldimt$',ns) 
 
@@ -338,6 +343,14 @@ c-----------------------------------------------------------------------
 
       p63s = param(63)
       param(63) = fp64 
+
+      ! dump on a coarser uniform grid
+      nrgs     = nrg
+      ifreguos = ifreguo
+      if(nout.gt.0) then
+        ifreguo = .true.
+        nrg     = nout
+      endif
  
       npscals = npscal
       ifxyos  = ifxyo
@@ -360,10 +373,10 @@ c-----------------------------------------------------------------------
       if(xo.ne.0) ifxyo = .true.
       if(vo.ne.0) ifvo  = .true.
       if(po.ne.0) ifpo  = .true.
-      if(so.ne.0) then
-        ifto = .true.
+      if(ns.gt.0) then
+        if(so(1).ne.0) ifto = .true.
         do i = 1,npscal
-          ifpsco(i) = .true.
+          if(so(i+1).ne.0) ifpsco(i) = .true.
         enddo
       endif
 
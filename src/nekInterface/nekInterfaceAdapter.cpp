@@ -2,6 +2,7 @@
 #include <fstream>
 #include "nrs.hpp"
 #include "nekInterfaceAdapter.hpp"
+#include "setup.hpp"
 #include "bcMap.hpp"
 #include "io.hpp"
 
@@ -26,7 +27,7 @@ static void (* nek_ptr_ptr)(void**, char*, int*);
 static void (* nek_scptr_ptr)(int*, void*);
 static void (* nek_outfld_ptr)(char*);
 static void (* nek_resetio_ptr)(void);
-static void (* nek_setio_ptr)(double*, int*, int*, int*, int*, int*, int*);
+static void (* nek_setio_ptr)(double*, int*, int*, int*, int*, int*, int*, int*);
 static void (* nek_uic_ptr)(int*);
 static void (* nek_end_ptr)(void);
 static void (* nek_restart_ptr)(char*, int*);
@@ -79,7 +80,7 @@ void* scPtr(int id)
 
 void outfld(const char* suffix, dfloat t, int coords, int FP64,
                 void* o_uu, void* o_pp, void* o_ss,
-                int NSfields)
+                int NSfields, const int* writeS, int Nout)
 {
 
   mesh_t* mesh = nrs->meshV;
@@ -100,7 +101,7 @@ void outfld(const char* suffix, dfloat t, int coords, int FP64,
   int xo = 0;
   int vo = 0;
   int po = 0;
-  int so = 0;
+  std::vector<int> so(NSfields + 1, 0);
 
   (*nek_storesol_ptr)();
 
@@ -130,17 +131,18 @@ void outfld(const char* suffix, dfloat t, int coords, int FP64,
   if(o_s.ptr()) {
     const dlong nekFieldOffset = nekData.lelt * mesh->Np;
     for(int is = 0; is < NSfields; is++) {
+      if(writeS && !writeS[is]) continue;
       mesh_t* mesh;
       (is) ? mesh = nrs->meshV: mesh = nrs->cds->mesh[0];
       const dlong Nlocal = mesh->Nelements * mesh->Np;
       dfloat* Ti = nekData.t + is * nekFieldOffset;
       occa::memory o_Si = o_s + is * nrs->fieldOffset * sizeof(dfloat);
       o_Si.copyTo(Ti, Nlocal * sizeof(dfloat));
+      so[is] = 1;
     }
-    so = 1;
   }
 
-  (*nek_setio_ptr)(&t, &xo, &vo, &po, &so, &NSfields, &FP64);
+  (*nek_setio_ptr)(&t, &xo, &vo, &po, so.data(), &NSfields, &FP64, &Nout);
   (*nek_outfld_ptr)((char*)suffix);
   (*nek_resetio_ptr)();
 
@@ -164,6 +166,10 @@ void setic(void)
   int readRestartFile;
   options->getArgs("RESTART FROM FILE", readRestartFile);
 
+  // fields are read by nekRS after setup
+  if (options->compareArgs("RESTART READER", "NATIVE") ||
+      options->compareArgs("RESTART READER", "CHECKPOINT")) readRestartFile = 0;
+
   if (readRestartFile) {
     std::string str1;
     options->getArgs("RESTART FILE NAME", str1);
@@ -276,7 +282,7 @@ void set_function_handles(const char* session_in,int verbose)
   nek_resetio_ptr = (void (*)(void))dlsym(handle, fname("nekf_resetio"));
   check_error(dlerror());
   nek_setio_ptr =
-    (void (*)(double*, int*, int*, int*, int*, int*, int*))dlsym(handle, fname("nekf_setio"));
+    (void (*)(double*, int*, int*, int*, int*, int*, int*, int*))dlsym(handle, fname("nekf_setio"));
   check_error(dlerror());
   nek_restart_ptr = (void (*)(char*, int*))dlsym(handle, fname("nekf_restart"));
   check_error(dlerror());
@@ -741,6 +747,7 @@ void copyToNek(dfloat time)
 
 void ocopyToNek(void)
 {
+  nrsAllocateHostMirrors(nrs);
   nrs->o_U.copyTo(nrs->U);
   nrs->o_P.copyTo(nrs->P);
   if(nrs->Nscalar){
@@ -756,10 +763,12 @@ void ocopyToNek(void)
     mesh->o_z.copyTo(mesh->z);
   }
   copyToNek(0.0);
+  nrsFreeHostMirrors(nrs);
 }
 
 void ocopyToNek(dfloat time, int tstep)
 {
+  nrsAllocateHostMirrors(nrs);
   nrs->o_U.copyTo(nrs->U);
   nrs->o_P.copyTo(nrs->P);
   if(nrs->Nscalar){
@@ -775,6 +784,7 @@ void ocopyToNek(dfloat time, int tstep)
     mesh->o_z.copyTo(mesh->z);
   }
   copyToNek(time, tstep);
+  nrsFreeHostMirrors(nrs);
 }
 
 void copyToNek(dfloat time, int tstep)
@@ -785,11 +795,13 @@ void copyToNek(dfloat time, int tstep)
 
 void ocopyFromNek(dfloat &time)
 {
+  nrsAllocateHostMirrors(nrs);
   copyFromNek(time);
-  nrs->o_P.copyFrom(nrs->P);
-  nrs->o_U.copyFrom(nrs->U);
+  // only the current time level is provided by nek, lagged states stay on the device
+  nrs->o_P.copyFrom(nrs->P, nrs->fieldOffset * sizeof(dfloat));
+  nrs->o_U.copyFrom(nrs->U, nrs->NVfields * nrs->fieldOffset * sizeof(dfloat));
   if(nrs->Nscalar){
-    nrs->cds->o_S.copyFrom(nrs->cds->S);
+    nrs->cds->o_S.copyFrom(nrs->cds->S, nrs->cds->fieldOffsetSum * sizeof(dfloat));
   }
   if(platform->options.compareArgs("MOVING MESH", "TRUE")){
     mesh_t *mesh = nrs->meshV;
@@ -797,8 +809,9 @@ void ocopyFromNek(dfloat &time)
     mesh->o_x.copyFrom(mesh->x);
     mesh->o_y.copyFrom(mesh->y);
     mesh->o_z.copyFrom(mesh->z);
-    mesh->o_U.copyFrom(mesh->U);
+    mesh->o_U.copyFrom(mesh->U, nrs->NVfields * nrs->fieldOffset * sizeof(dfloat));
   }
+  nrsFreeHostMirrors(nrs);
 }
 
 void copyFromNek(dfloat &time)
@@ -108,7 +108,7 @@ void*  scPtr(int id);
 void   outSolutionFld(double time, double outputTime);
 void   outfld(const char* suffix, dfloat t, int coords, int FP64,
                   void* o_u, void* o_p, void* o_s,
-                  int NSfields);
+                  int NSfields, const int* writeS = nullptr, int Nout = 0);
 void   uic(int ifield);
 void   end(void);
 void   map_m_to_n(double* a, int na, double* b, int nb);
@@ -117,14 +117,14 @@ void RANSktau::updateSourceTerms()
   cds_t* cds = nrs->cds;
   
 
-  occa::memory o_OiOjSk  = platform->o_mempool.slice0;
-  occa::memory o_SijMag2 = platform->o_mempool.slice1;
-  occa::memory o_SijOij  = platform->o_mempool.slice2;
+  const int NSOfields = 9;
+  occa::memory o_OiOjSk  = platform->scratch.acquireFields(1);
+  occa::memory o_SijMag2 = platform->scratch.acquireFields(1);
+  occa::memory o_SijOij  = platform->scratch.acquireFields(NSOfields);
 
   occa::memory o_FS      = cds->o_FS     + cds->fieldOffsetScan[kFieldIndex] * sizeof(dfloat);
   occa::memory o_BFDiag  = cds->o_BFDiag + cds->fieldOffsetScan[kFieldIndex] * sizeof(dfloat);
 
-  const int NSOfields = 9;
   SijOijKernel(mesh->Nelements,
                nrs->fieldOffset,
                mesh->o_vgeo,
@@ -168,6 +168,10 @@ void RANSktau::updateSourceTerms()
                 o_OiOjSk,
                 o_BFDiag,
                 o_FS);
+
+  platform->scratch.release(o_SijOij);
+  platform->scratch.release(o_SijMag2);
+  platform->scratch.release(o_OiOjSk);
 }
 
 void RANSktau::setup(nrs_t* nrsIn, dfloat mueIn, dfloat rhoIn, int ifld)
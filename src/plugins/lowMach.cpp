@@ -16,8 +16,8 @@ static linAlg_t* the_linAlg = nullptr;
 static int qThermal = 0;
 static dfloat gamma0 = 1;
 static occa::kernel qtlKernel;
-static occa::kernel p0thHelperKernel;
-static occa::kernel surfaceFluxKernel;
+static occa::kernel p0thTermsKernel;
+static occa::kernel p0thUpdateKernel;
 
 
 }
@@ -32,14 +32,14 @@ void lowMach::buildKernel(nrs_t* nrs)
   fileName += "/okl/plugins/lowMach.okl";
   if( BLOCKSIZE < mesh->Nq * mesh->Nq ){
     if(rank == 0)
-      printf("ERROR: nrsSurfaceFlux kernel requires BLOCKSIZE >= Nq * Nq."
+      printf("ERROR: p0thTerms kernel requires BLOCKSIZE >= Nq * Nq."
         "BLOCKSIZE = %d, Nq*Nq = %d\n", BLOCKSIZE, mesh->Nq * mesh->Nq);
     ABORT(EXIT_FAILURE);
   }
   {
     qtlKernel        = platform->device.buildKernel(fileName, "qtlHex3D"  , kernelInfo);
-    p0thHelperKernel = platform->device.buildKernel(fileName, "p0thHelper", kernelInfo);
-    surfaceFluxKernel = platform->device.buildKernel(fileName, "surfaceFlux", kernelInfo);
+    p0thTermsKernel  = platform->device.buildKernel(fileName, "p0thTermsHex3D", kernelInfo);
+    p0thUpdateKernel = platform->device.buildKernel(fileName, "p0thUpdate", kernelInfo);
   }
 }
 
@@ -65,7 +65,10 @@ void lowMach::qThermalIdealGasSingleComponent(dfloat time, occa::memory o_div)
   nrs_t* nrs = the_nrs;
   cds_t* cds = nrs->cds;
   mesh_t* mesh = nrs->meshV;
-  linAlg_t * linAlg = platform->linAlg;
+
+  occa::memory o_gradT = platform->scratch.acquireFields(nrs->NVfields);
+  // udf.sEqnSource writes all scalars, same layout as cds->o_FS
+  occa::memory o_src = platform->scratch.acquire(cds->fieldOffsetSum * sizeof(dfloat));
 
   nrs->gradientVolumeKernel(
     mesh->Nelements,
@@ -73,9 +76,9 @@ void lowMach::qThermalIdealGasSingleComponent(dfloat time, occa::memory o_div)
     mesh->o_D,
     nrs->fieldOffset,
     cds->o_S,
-    platform->o_mempool.slice0);
+    o_gradT);
 
-  oogs::startFinish(platform->o_mempool.slice0, nrs->NVfields, nrs->fieldOffset,ogsDfloat, ogsAdd, nrs->gsh);
+  oogs::startFinish(o_gradT, nrs->NVfields, nrs->fieldOffset,ogsDfloat, ogsAdd, nrs->gsh);
 
   platform->linAlg->axmyVector(
     mesh->Nlocal,
@@ -83,14 +86,14 @@ void lowMach::qThermalIdealGasSingleComponent(dfloat time, occa::memory o_div)
     0,
     1.0,
     nrs->meshV->o_invLMM,
-    platform->o_mempool.slice0);
+    o_gradT);
 
   if(udf.sEqnSource) {
     platform->timer.tic("udfSEqnSource", 1);
-    udf.sEqnSource(nrs, time, cds->o_S, platform->o_mempool.slice3);
+    udf.sEqnSource(nrs, time, cds->o_S, o_src);
     platform->timer.toc("udfSEqnSource");
   } else {
-    platform->linAlg->fill(mesh->Nelements * mesh->Np, 0.0, platform->o_mempool.slice3);
+    platform->linAlg->fill(mesh->Nelements * mesh->Np, 0.0, o_src);
   }
 
   qtlKernel(
@@ -98,52 +101,60 @@ void lowMach::qThermalIdealGasSingleComponent(dfloat time, occa::memory o_div)
     mesh->o_vgeo,
     mesh->o_D,
     nrs->fieldOffset,
-    platform->o_mempool.slice0,
+    o_gradT,
     cds->o_S,
     cds->o_diff,
     cds->o_rho,
-    platform->o_mempool.slice3,
-    o_div);
-
-  oogs::startFinish(o_div, 1, nrs->fieldOffset, ogsDfloat, ogsAdd, nrs->gsh);
-
-  platform->linAlg->axmy(
-    mesh->Nlocal,
-    1.0,
-    nrs->meshV->o_invLMM,
+    o_src,
     o_div);
-  
-  if(nrs->pSolver->allNeumann){
-    const dfloat dd = (1.0 - gamma0) / gamma0;
-    const dlong Nlocal = mesh->Nlocal;
-
-    linAlg->axmyz(Nlocal, 1.0, mesh->o_LMM, o_div, platform->o_mempool.slice0);
-    const dfloat termQ = linAlg->sum(Nlocal, platform->o_mempool.slice0, platform->comm.mpiComm);
 
-    surfaceFluxKernel(
+  platform->scratch.release(o_src);
+  platform->scratch.release(o_gradT);
+
+  const bool closedDomain = nrs->pSolver->allNeumann;
+  const dfloat dd = (1.0 - gamma0) / gamma0;
+  dfloat terms[3] = {0.0, 0.0, 0.0};
+  MPI_Request request;
+  if(closedDomain){
+    // sum(LMM * invLMM * gs(qtl)) equals the sum of the unassembled qtl, so
+    // all integrals are available before the gather-scatter below and their
+    // reduction runs in the background of it
+    occa::memory o_terms = platform->scratch.acquire(3 * mesh->Nelements * sizeof(dfloat));
+    p0thTermsKernel(
       mesh->Nelements,
       mesh->o_sgeo,
       mesh->o_vmapM,
       nrs->o_EToB,
       nrs->fieldOffset,
-      nrs->o_Ue,
-      platform->o_mempool.slice0
-    );
-    platform->o_mempool.slice0.copyTo(platform->mempool.slice0, mesh->Nelements * sizeof(dfloat));
-    dfloat termV = 0.0;
-    for(int i = 0 ; i < mesh->Nelements; ++i) termV += platform->mempool.slice0[i];
-    MPI_Allreduce(MPI_IN_PLACE, &termV, 1, MPI_DFLOAT, MPI_SUM, platform->comm.mpiComm);
-
-    p0thHelperKernel(Nlocal,
       dd,
+      mesh->o_LMM,
+      o_div,
       cds->o_rho,
       nrs->o_rho,
-      nrs->meshV->o_LMM,
-      platform->o_mempool.slice0,
-      platform->o_mempool.slice1 
-    );
-    const dfloat prhs = (termQ - termV)/linAlg->sum(Nlocal, platform->o_mempool.slice0, platform->comm.mpiComm);
-    linAlg->axpby(Nlocal, -prhs, platform->o_mempool.slice1, 1.0, o_div);
+      nrs->o_Ue,
+      o_terms);
+    o_terms.copyTo(platform->mempool.slice0, 3 * mesh->Nelements * sizeof(dfloat));
+    platform->scratch.release(o_terms);
+    for(int i = 0; i < 3; ++i)
+      for(dlong e = 0; e < mesh->Nelements; ++e)
+        terms[i] += platform->mempool.slice0[e + i * mesh->Nelements];
+    MPI_Iallreduce(MPI_IN_PLACE, terms, 3, MPI_DFLOAT, MPI_SUM, platform->comm.mpiComm, &request);
+  }
+
+  oogs::startFinish(o_div, 1, nrs->fieldOffset, ogsDfloat, ogsAdd, nrs->gsh);
+
+  platform->linAlg->axmy(
+    mesh->Nlocal,
+    1.0,
+    nrs->meshV->o_invLMM,
+    o_div);
+  
+  if(closedDomain){
+    MPI_Wait(&request, MPI_STATUS_IGNORE);
+    const dfloat termQ = terms[0];
+    const dfloat termV = terms[2];
+    const dfloat prhs = (termQ - termV) / terms[1];
+    p0thUpdateKernel(mesh->Nlocal, dd, prhs, cds->o_rho, nrs->o_rho, o_div);
 
     dfloat Saqpq = 0.0;
     for(int i = 0 ; i < nrs->nBDF; ++i){
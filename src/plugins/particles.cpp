@@ -0,0 +1,365 @@
+#include <vector>
+#include <string>
+#include <fstream>
+#include <sstream>
+#include <cstring>
+
+#include "nrs.hpp"
+#include "platform.hpp"
+#include "particles.hpp"
+
+extern "C" {
+#include "gslib.h"
+#include "crystal.h"
+#include "sarray_transfer.h"
+#include "findpts.h"
+}
+
+// private members
+namespace
+{
+// transfer unit for the crystal router
+struct particle_t {
+  dfloat x[3];
+  dfloat x0[3];
+  dfloat r[3];
+  long long id;
+  uint el;
+  uint proc;
+};
+
+static nrs_t* nrs;
+
+static occa::kernel RKStageKernel;
+
+static bool setupCalled = 0;
+
+static int rkOrder = 2;
+static int writeInterval = 0;
+static int outputCounter = 0;
+
+static struct comm gcomm;
+static struct crystal cr;
+static struct findpts_data_3* fd = nullptr;
+static int findptsGeometryVersion = -1;
+
+// particles owned by this rank
+static std::vector<dfloat> x, x0, r;
+static std::vector<long long> id;
+static std::vector<dlong> el;
+
+static dlong capacity = 0;
+static occa::memory o_x, o_x0, o_r, o_el;
+static occa::memory o_z;
+
+// with CHT the fluid coordinates move with the solid mesh
+int geometryVersion()
+{
+  return nrs->cht ? nrs->cds->mesh[0]->geometryVersion : nrs->meshV->geometryVersion;
+}
+
+void setupFindpts()
+{
+  mesh_t* mesh = nrs->meshV;
+
+  if(fd) findpts_free_3(fd);
+  findptsGeometryVersion = geometryVersion();
+
+  const double* elx[3] = {mesh->x, mesh->y, mesh->z};
+  const unsigned n[3] = {(unsigned) mesh->Nq, (unsigned) mesh->Nq, (unsigned) mesh->Nq};
+  const unsigned m[3] = {2 * n[0], 2 * n[1], 2 * n[2]};
+  const uint hashSize = mesh->Nelements * mesh->Np;
+  fd = findpts_setup_3(&gcomm, elx, n, mesh->Nelements, m, 0.01,
+                       hashSize, hashSize, 128, 5e-13);
+}
+
+void upload()
+{
+  const dlong N = id.size();
+  if(N > capacity) {
+    capacity = N + N / 2;
+    if(o_x.size()) {
+      o_x.free();
+      o_x0.free();
+      o_r.free();
+      o_el.free();
+    }
+    o_x = platform->device.malloc(3 * capacity * sizeof(dfloat));
+    o_x0 = platform->device.malloc(3 * capacity * sizeof(dfloat));
+    o_r = platform->device.malloc(3 * capacity * sizeof(dfloat));
+    o_el = platform->device.malloc(capacity * sizeof(dlong));
+  }
+  if(!N) return;
+  o_x.copyFrom(x.data(), 3 * N * sizeof(dfloat));
+  o_x0.copyFrom(x0.data(), 3 * N * sizeof(dfloat));
+  o_r.copyFrom(r.data(), 3 * N * sizeof(dfloat));
+  o_el.copyFrom(el.data(), N * sizeof(dlong));
+}
+
+// find owner, element and reference coordinates of all particles in x,
+// migrate the ones owned by another rank and drop the ones outside of the domain
+void relocate()
+{
+  const int rank = platform->comm.mpiRank;
+  const dlong N = id.size();
+
+  if(platform->options.compareArgs("MOVING MESH", "TRUE") && geometryVersion() != findptsGeometryVersion) {
+    mesh_t* mesh = nrs->meshV;
+    mesh->o_x.copyTo(mesh->x);
+    mesh->o_y.copyTo(mesh->y);
+    mesh->o_z.copyTo(mesh->z);
+    setupFindpts();
+  }
+
+  std::vector<uint> code(N), proc(N), elem(N);
+  std::vector<double> rst(3 * N), dist2(N);
+  double dummy[3] = {0, 0, 0};
+  const double* xBase[3] = {N ? &x[0] : dummy, N ? &x[1] : dummy, N ? &x[2] : dummy};
+  const unsigned xStride[3] = {3 * sizeof(dfloat), 3 * sizeof(dfloat), 3 * sizeof(dfloat)};
+  findpts_3(code.data(), sizeof(uint), proc.data(), sizeof(uint), elem.data(), sizeof(uint),
+            rst.data(), 3 * sizeof(double), dist2.data(), sizeof(double),
+            xBase, xStride, N, fd);
+
+  struct array A = null_array;
+  dlong Nkeep = 0;
+  hlong Nlost = 0;
+  for(dlong n = 0; n < N; n++) {
+    // code 2 := not found
+    if(code[n] == 2) {
+      Nlost++;
+      continue;
+    }
+    if(proc[n] == (uint) rank) {
+      for(int d = 0; d < 3; d++) {
+        x[3 * Nkeep + d] = x[3 * n + d];
+        x0[3 * Nkeep + d] = x0[3 * n + d];
+        r[3 * Nkeep + d] = rst[3 * n + d];
+      }
+      id[Nkeep] = id[n];
+      el[Nkeep] = elem[n];
+      Nkeep++;
+    } else {
+      particle_t* p = (particle_t*) array_reserve(particle_t, &A, A.n + 1);
+      p += A.n++;
+      std::memcpy(p->x, &x[3 * n], 3 * sizeof(dfloat));
+      std::memcpy(p->x0, &x0[3 * n], 3 * sizeof(dfloat));
+      for(int d = 0; d < 3; d++) p->r[d] = rst[3 * n + d];
+      p->id = id[n];
+      p->el = elem[n];
+      p->proc = proc[n];
+    }
+  }
+
+  sarray_transfer(particle_t, &A, proc, 0, &cr);
+
+  const dlong Nrecv = A.n;
+  x.resize(3 * (Nkeep + Nrecv));
+  x0.resize(3 * (Nkeep + Nrecv));
+  r.resize(3 * (Nkeep + Nrecv));
+  id.resize(Nkeep + Nrecv);
+  el.resize(Nkeep + Nrecv);
+  const particle_t* p = (const particle_t*) A.ptr;
+  for(dlong n = 0; n < Nrecv; n++) {
+    const dlong m = Nkeep + n;
+    std::memcpy(&x[3 * m], p[n].x, 3 * sizeof(dfloat));
+    std::memcpy(&x0[3 * m], p[n].x0, 3 * sizeof(dfloat));
+    std::memcpy(&r[3 * m], p[n].r, 3 * sizeof(dfloat));
+    id[m] = p[n].id;
+    el[m] = p[n].el;
+  }
+  array_free(&A);
+
+  MPI_Allreduce(MPI_IN_PLACE, &Nlost, 1, MPI_HLONG, MPI_SUM, platform->comm.mpiComm);
+  if(Nlost && rank == 0) printf("particles: %lld particles left the domain\n", (long long) Nlost);
+
+  upload();
+}
+}
+
+void particles::setup(nrs_t* nrs_, dlong N, const dfloat* px, const dfloat* py, const dfloat* pz)
+{
+  if(setupCalled) return;
+
+  nrs = nrs_;
+  mesh_t* mesh = nrs->meshV;
+  MPI_Comm comm = platform->comm.mpiComm;
+
+  platform->options.getArgs("PARTICLES RK ORDER", rkOrder);
+  platform->options.getArgs("PARTICLES WRITE INTERVAL", writeInterval);
+  if(rkOrder != 2 && rkOrder != 3) {
+    if(platform->comm.mpiRank == 0) printf("particles: unsupported RK order %d!\n", rkOrder);
+    ABORT(EXIT_FAILURE);
+  }
+
+  string fileName;
+  fileName.assign(getenv("NEKRS_INSTALL_DIR"));
+  fileName += "/okl/plugins/particles.okl";
+  RKStageKernel = platform->device.buildKernel(fileName, "particlesRKStage", *nrs->kernelInfo);
+
+  o_z = platform->device.malloc(mesh->Nq * sizeof(dfloat), mesh->gllz);
+
+  comm_init(&gcomm, comm);
+  crystal_init(&cr, &gcomm);
+  setupFindpts();
+
+  // global ids in rank order
+  hlong offset = 0;
+  hlong Nlocal = N;
+  MPI_Exscan(&Nlocal, &offset, 1, MPI_HLONG, MPI_SUM, comm);
+  if(platform->comm.mpiRank == 0) offset = 0;
+
+  x.resize(3 * N);
+  r.resize(3 * N);
+  id.resize(N);
+  el.resize(N);
+  for(dlong n = 0; n < N; n++) {
+    x[3 * n + 0] = px[n];
+    x[3 * n + 1] = py[n];
+    x[3 * n + 2] = pz[n];
+    id[n] = offset + n;
+  }
+  x0 = x;
+
+  relocate();
+
+  setupCalled = 1;
+
+  const hlong Ntotal = numParticles();
+  if(platform->comm.mpiRank == 0)
+    printf("particles: tracking %lld particles with SSP-RK%d\n", (long long) Ntotal, rkOrder);
+}
+
+void particles::setup(nrs_t* nrs_, const std::string& particleFile)
+{
+  std::vector<dfloat> px, py, pz;
+  int err = 0;
+  if(platform->comm.mpiRank == 0) {
+    std::ifstream in(particleFile);
+    if(!in) {
+      printf("particles: cannot open %s!\n", particleFile.c_str());
+      err = 1;
+    }
+    std::string line;
+    while(std::getline(in, line)) {
+      if(line.empty() || line[0] == '#') continue;
+      std::istringstream iss(line);
+      dfloat a, b, c;
+      if(iss >> a >> b >> c) {
+        px.push_back(a);
+        py.push_back(b);
+        pz.push_back(c);
+      }
+    }
+  }
+  MPI_Bcast(&err, 1, MPI_INT, 0, platform->comm.mpiComm);
+  if(err) ABORT(EXIT_FAILURE);
+
+  // the first relocation distributes the particles to their owners
+  setup(nrs_, px.size(), px.data(), py.data(), pz.data());
+}
+
+hlong particles::numParticles()
+{
+  hlong N = id.size();
+  MPI_Allreduce(MPI_IN_PLACE, &N, 1, MPI_HLONG, MPI_SUM, platform->comm.mpiComm);
+  return N;
+}
+
+// advance from t^n to t^n+1, requires U^n+1 and U^n in the first two
+// history slots of nrs->o_U (i.e. call after the flow step)
+void particles::advance(dfloat dt)
+{
+  if(!setupCalled) {
+    cout << "particles::advance() was called prior to particles::setup()!\n";
+    ABORT(1);
+  }
+
+  // SSP-RK in Shu-Osher form, stage times relative to dt
+  const dfloat a2[2] = {0, 0.5};
+  const dfloat theta2[2] = {0, 1};
+  const dfloat a3[3] = {0, 0.75, 1.0 / 3};
+  const dfloat theta3[3] = {0, 1, 0.5};
+  const dfloat* a = (rkOrder == 3) ? a3 : a2;
+  const dfloat* theta = (rkOrder == 3) ? theta3 : theta2;
+
+  platform->timer.tic("particles", 1);
+
+  x0 = x;
+  if(id.size()) o_x0.copyFrom(o_x, 3 * id.size() * sizeof(dfloat));
+
+  const dlong offsetByte = nrs->NVfields * nrs->fieldOffset * sizeof(dfloat);
+  occa::memory o_Uprev = nrs->o_U + offsetByte;
+
+  for(int stage = 0; stage < rkOrder; stage++) {
+    const dlong N = id.size();
+    if(N) {
+      RKStageKernel(N, nrs->fieldOffset, dt, a[stage], theta[stage],
+                    o_z, o_el, o_r, nrs->o_U, o_Uprev, o_x0, o_x);
+      o_x.copyTo(x.data(), 3 * N * sizeof(dfloat));
+    }
+    relocate();
+  }
+
+  platform->timer.toc("particles");
+}
+
+void particles::run(dfloat time, dfloat dt, int tstep)
+{
+  if(!setupCalled) return;
+
+  advance(dt);
+
+  if(writeInterval > 0 && (tstep % writeInterval == 0 || nrs->lastStep))
+    write(time + dt);
+}
+
+void particles::write(dfloat time)
+{
+  const int rank = platform->comm.mpiRank;
+  MPI_Comm comm = platform->comm.mpiComm;
+
+  constexpr char magic[8] = {'#', 'n', 'r', 's', 'p', 't', 'c', '1'};
+  constexpr int recordBytes = sizeof(long long) + 3 * sizeof(double);
+  constexpr MPI_Offset headerBytes = sizeof(magic) + sizeof(double) + sizeof(long long);
+
+  std::string casename;
+  platform->options.getArgs("CASENAME", casename);
+  char fileName[FILENAME_MAX];
+  snprintf(fileName, sizeof(fileName), "%s.particles%05d", casename.c_str(), outputCounter++);
+
+  const dlong N = id.size();
+  std::vector<char> records((size_t) N * recordBytes);
+  for(dlong n = 0; n < N; n++) {
+    char* rec = records.data() + (size_t) n * recordBytes;
+    std::memcpy(rec, &id[n], sizeof(long long));
+    const double xn[3] = {x[3 * n + 0], x[3 * n + 1], x[3 * n + 2]};
+    std::memcpy(rec + sizeof(long long), xn, sizeof(xn));
+  }
+
+  long long Nlocal = N;
+  long long offset = 0;
+  long long Ntotal = 0;
+  MPI_Exscan(&Nlocal, &offset, 1, MPI_LONG_LONG, MPI_SUM, comm);
+  if(rank == 0) offset = 0;
+  MPI_Allreduce(&Nlocal, &Ntotal, 1, MPI_LONG_LONG, MPI_SUM, comm);
+
+  MPI_File fh;
+  int err = MPI_File_open(comm, fileName, MPI_MODE_CREATE | MPI_MODE_WRONLY, MPI_INFO_NULL, &fh);
+  if(err != MPI_SUCCESS) {
+    if(rank == 0) printf("particles: cannot open %s for writing!\n", fileName);
+    ABORT(EXIT_FAILURE);
+  }
+  MPI_File_set_size(fh, 0);
+
+  if(rank == 0) {
+    const double t = time;
+    MPI_File_write_at(fh, 0, magic, sizeof(magic), MPI_BYTE, MPI_STATUS_IGNORE);
+    MPI_File_write_at(fh, sizeof(magic), &t, 1, MPI_DOUBLE, MPI_STATUS_IGNORE);
+    MPI_File_write_at(fh, sizeof(magic) + sizeof(double), &Ntotal, 1, MPI_LONG_LONG, MPI_STATUS_IGNORE);
+  }
+  MPI_File_write_at_all(fh, headerBytes + (MPI_Offset) offset * recordBytes,
+                        records.data(), (int) records.size(), MPI_BYTE, MPI_STATUS_IGNORE);
+  MPI_File_close(&fh);
+
+  if(rank == 0) printf("particles: wrote %lld particles to %s\n", Ntotal, fileName);
+}
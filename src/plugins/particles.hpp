@@ -0,0 +1,30 @@
+/*
+   Lagrangian tracer particles advected by the fluid velocity
+
+   Each rank advances the particles inside its elements on the device with an
+   SSP-RK scheme (order 2 or 3), the velocity is interpolated with the spectral
+   basis of the owning element and linearly in time between t^n and t^n+1.
+   After every stage gslib's findpts relocates the particles, only those which
+   crossed a partition boundary are sent through the crystal router.
+   Particles leaving the domain are removed.
+
+   output: <casename>.particles<counter> written collectively with MPI-IO
+   file layout: char[8] "#nrsptc1", double time, long long Ntotal,
+                then Ntotal records {long long id, double x, double y, double z}
+                in arbitrary order
+
+   Note: particles are located in the fluid mesh
+ */
+
+#include <string>
+#include "nrs.hpp"
+
+namespace particles
+{
+void setup(nrs_t* nrs_, dlong N, const dfloat* x, const dfloat* y, const dfloat* z);
+void setup(nrs_t* nrs_, const std::string& particleFile);
+void advance(dfloat dt);
+void run(dfloat time, dfloat dt, int tstep);
+void write(dfloat time);
+hlong numParticles();
+}
@@ -0,0 +1,303 @@
+#include <vector>
+#include <string>
+#include <fstream>
+#include <sstream>
+#include <limits>
+
+#include "nrs.hpp"
+#include "platform.hpp"
+#include "probes.hpp"
+
+extern "C" {
+#include "gslib.h"
+#include "findpts.h"
+}
+
+// private members
+namespace
+{
+static nrs_t* nrs;
+
+static occa::kernel interpolateKernel;
+
+static bool setupCalled = 0;
+
+static int Nfields;
+static dlong Npoints;
+static int interval = 1;
+static int bufferSize = 1024;
+
+// points owned by this rank
+static std::vector<dlong> localIds;
+static std::vector<dfloat> localValues;
+static occa::memory o_element, o_weights, o_values;
+static int locatedGeometryVersion = -1;
+
+// rank 0 only
+static std::vector<dfloat> xp, yp, zp;
+static std::vector<int> found;
+static std::vector<int> recvCounts, recvDispls;
+static std::vector<dlong> recvIds;
+static dlong Nreceived = 0;
+static std::vector<dfloat> recvValues;
+static std::vector<double> samples;
+static int Nbuffered = 0;
+static FILE* fp = nullptr;
+
+void lagrangeWeights(const dfloat* z, int Nq, dfloat r, dfloat* h)
+{
+  for(int i = 0; i < Nq; i++) {
+    h[i] = 1;
+    for(int j = 0; j < Nq; j++)
+      if(j != i) h[i] *= (r - z[j]) / (z[i] - z[j]);
+  }
+}
+
+// with CHT the fluid coordinates move with the solid mesh
+int geometryVersion()
+{
+  return nrs->cht ? nrs->cds->mesh[0]->geometryVersion : nrs->meshV->geometryVersion;
+}
+
+// find owning rank, element and reference coordinates of all points
+void locate()
+{
+  mesh_t* mesh = nrs->meshV;
+  const int rank = platform->comm.mpiRank;
+  const int size = platform->comm.mpiCommSize;
+  MPI_Comm comm = platform->comm.mpiComm;
+
+  if(platform->options.compareArgs("MOVING MESH", "TRUE")) {
+    mesh->o_x.copyTo(mesh->x);
+    mesh->o_y.copyTo(mesh->y);
+    mesh->o_z.copyTo(mesh->z);
+  }
+
+  locatedGeometryVersion = geometryVersion();
+
+  struct comm gcomm;
+  comm_init(&gcomm, comm);
+
+  const double* elx[3] = {mesh->x, mesh->y, mesh->z};
+  const unsigned n[3] = {(unsigned) mesh->Nq, (unsigned) mesh->Nq, (unsigned) mesh->Nq};
+  const unsigned m[3] = {2 * n[0], 2 * n[1], 2 * n[2]};
+  const uint hashSize = mesh->Nelements * mesh->Np;
+  struct findpts_data_3* fd = findpts_setup_3(&gcomm, elx, n, mesh->Nelements, m, 0.01,
+                                              hashSize, hashSize, 128, 5e-13);
+
+  std::vector<uint> code(Npoints), proc(Npoints), el(Npoints);
+  std::vector<double> r(3 * Npoints), dist2(Npoints);
+  const double* x[3] = {xp.data(), yp.data(), zp.data()};
+  const unsigned xStride[3] = {sizeof(double), sizeof(double), sizeof(double)};
+  findpts_3(code.data(), sizeof(uint), proc.data(), sizeof(uint), el.data(), sizeof(uint),
+            r.data(), 3 * sizeof(double), dist2.data(), sizeof(double),
+            x, xStride, (rank == 0) ? Npoints : 0, fd);
+
+  findpts_free_3(fd);
+  comm_free(&gcomm);
+
+  MPI_Bcast(code.data(), Npoints, MPI_UNSIGNED, 0, comm);
+  MPI_Bcast(proc.data(), Npoints, MPI_UNSIGNED, 0, comm);
+  MPI_Bcast(el.data(), Npoints, MPI_UNSIGNED, 0, comm);
+  MPI_Bcast(r.data(), 3 * Npoints, MPI_DOUBLE, 0, comm);
+
+  // code 2 := point not found
+  if(rank == 0) {
+    found.resize(Npoints);
+    int Nmissing = 0;
+    for(dlong i = 0; i < Npoints; i++) {
+      found[i] = (code[i] != 2);
+      if(!found[i]) Nmissing++;
+    }
+    if(Nmissing) printf("probes: %d of %d points not found in mesh!\n", Nmissing, (int) Npoints);
+  }
+
+  localIds.clear();
+  std::vector<dlong> element;
+  std::vector<dfloat> weights;
+  for(dlong i = 0; i < Npoints; i++) {
+    if(code[i] == 2 || proc[i] != (uint) rank) continue;
+    localIds.push_back(i);
+    element.push_back(el[i]);
+    for(int d = 0; d < 3; d++) {
+      std::vector<dfloat> h(mesh->Nq);
+      lagrangeWeights(mesh->gllz, mesh->Nq, r[3 * i + d], h.data());
+      weights.insert(weights.end(), h.begin(), h.end());
+    }
+  }
+
+  const dlong Nlocal = localIds.size();
+  localValues.resize(Nlocal * Nfields);
+  if(o_element.size()) o_element.free();
+  if(o_weights.size()) o_weights.free();
+  if(o_values.size()) o_values.free();
+  if(Nlocal) {
+    o_element = platform->device.malloc(Nlocal * sizeof(dlong), element.data());
+    o_weights = platform->device.malloc(weights.size() * sizeof(dfloat), weights.data());
+    o_values = platform->device.malloc(Nlocal * Nfields * sizeof(dfloat));
+  }
+
+  // rank 0 receives the samples of all ranks in one gather
+  int count = Nlocal;
+  recvCounts.resize(size);
+  recvDispls.resize(size);
+  MPI_Gather(&count, 1, MPI_INT, recvCounts.data(), 1, MPI_INT, 0, comm);
+  for(int i = 0; i < size; i++) recvDispls[i] = (i) ? recvDispls[i - 1] + recvCounts[i - 1] : 0;
+  Nreceived = recvDispls[size - 1] + recvCounts[size - 1];
+  if(rank == 0) recvIds.resize(Npoints);
+  MPI_Gatherv(localIds.data(), count, MPI_DLONG,
+              recvIds.data(), recvCounts.data(), recvDispls.data(), MPI_DLONG, 0, comm);
+  for(int i = 0; i < size; i++) {
+    recvCounts[i] *= Nfields;
+    recvDispls[i] *= Nfields;
+  }
+  if(rank == 0) recvValues.resize(Npoints * Nfields);
+}
+
+void writeHeader()
+{
+  std::string casename;
+  platform->options.getArgs("CASENAME", casename);
+  const std::string fileName = casename + ".probes";
+  fp = fopen(fileName.c_str(), "wb");
+  if(!fp) {
+    printf("probes: cannot open %s for writing!\n", fileName.c_str());
+    ABORT(EXIT_FAILURE);
+  }
+
+  const char magic[8] = {'#', 'n', 'r', 's', 'p', 'r', 'b', '1'};
+  const int N = Npoints;
+  std::vector<double> xyz(3 * Npoints);
+  for(dlong i = 0; i < Npoints; i++) {
+    xyz[3 * i + 0] = xp[i];
+    xyz[3 * i + 1] = yp[i];
+    xyz[3 * i + 2] = zp[i];
+  }
+  fwrite(magic, sizeof(char), 8, fp);
+  fwrite(&N, sizeof(int), 1, fp);
+  fwrite(&Nfields, sizeof(int), 1, fp);
+  fwrite(xyz.data(), sizeof(double), xyz.size(), fp);
+  fwrite(found.data(), sizeof(int), found.size(), fp);
+  fflush(fp);
+}
+}
+
+void probes::setup(nrs_t* nrs_, dlong Npoints_, const dfloat* x, const dfloat* y, const dfloat* z)
+{
+  if(setupCalled) return;
+
+  nrs = nrs_;
+  MPI_Comm comm = platform->comm.mpiComm;
+  const int rank = platform->comm.mpiRank;
+
+  // points are taken from rank 0
+  Npoints = Npoints_;
+  MPI_Bcast(&Npoints, 1, MPI_DLONG, 0, comm);
+  if(rank == 0) {
+    xp.assign(x, x + Npoints);
+    yp.assign(y, y + Npoints);
+    zp.assign(z, z + Npoints);
+  }
+
+  platform->options.getArgs("PROBES INTERVAL", interval);
+  platform->options.getArgs("PROBES BUFFER SIZE", bufferSize);
+  if(interval < 1) interval = 1;
+  if(bufferSize < 1) bufferSize = 1;
+
+  Nfields = nrs->NVfields + 1 + nrs->Nscalar;
+
+  string fileName;
+  fileName.assign(getenv("NEKRS_INSTALL_DIR"));
+  fileName += "/okl/plugins/probes.okl";
+  interpolateKernel = platform->device.buildKernel(fileName, "probesInterpolate", *nrs->kernelInfo);
+
+  locate();
+
+  if(rank == 0) {
+    samples.resize((size_t) bufferSize * (1 + Npoints * Nfields));
+    writeHeader();
+    printf("probes: sampling %d points every %d steps\n", (int) Npoints, interval);
+  }
+
+  setupCalled = 1;
+}
+
+void probes::setup(nrs_t* nrs_, const std::string& pointFile)
+{
+  std::vector<dfloat> x, y, z;
+  int err = 0;
+  if(platform->comm.mpiRank == 0) {
+    std::ifstream in(pointFile);
+    if(!in) {
+      printf("probes: cannot open point file %s!\n", pointFile.c_str());
+      err = 1;
+    }
+    std::string line;
+    while(std::getline(in, line)) {
+      if(line.empty() || line[0] == '#') continue;
+      std::istringstream iss(line);
+      dfloat px, py, pz;
+      if(iss >> px >> py >> pz) {
+        x.push_back(px);
+        y.push_back(py);
+        z.push_back(pz);
+      }
+    }
+  }
+  MPI_Bcast(&err, 1, MPI_INT, 0, platform->comm.mpiComm);
+  if(err) ABORT(EXIT_FAILURE);
+
+  setup(nrs_, x.size(), x.data(), y.data(), z.data());
+}
+
+void probes::run(dfloat time, int tstep)
+{
+  if(!setupCalled) return;
+
+  const bool sample = (tstep % interval == 0);
+  if(sample) {
+    platform->timer.tic("probes", 1);
+
+    if(geometryVersion() != locatedGeometryVersion) locate();
+
+    const dlong Nlocal = localIds.size();
+    if(Nlocal) {
+      const dlong offsetByte = nrs->NVfields * sizeof(dfloat);
+      interpolateKernel(Nlocal, nrs->NVfields, nrs->fieldOffset, Nfields,
+                        o_element, o_weights, nrs->o_U, o_values);
+      interpolateKernel(Nlocal, 1, nrs->fieldOffset, Nfields,
+                        o_element, o_weights, nrs->o_P, o_values + offsetByte);
+      if(nrs->Nscalar)
+        interpolateKernel(Nlocal, nrs->Nscalar, nrs->cds->fieldOffset[0], Nfields,
+                          o_element, o_weights, nrs->cds->o_S, o_values + offsetByte + sizeof(dfloat));
+      o_values.copyTo(localValues.data(), Nlocal * Nfields * sizeof(dfloat));
+    }
+
+    MPI_Gatherv(localValues.data(), Nlocal * Nfields, MPI_DFLOAT,
+                recvValues.data(), recvCounts.data(), recvDispls.data(), MPI_DFLOAT,
+                0, platform->comm.mpiComm);
+
+    if(platform->comm.mpiRank == 0) {
+      double* record = samples.data() + (size_t) Nbuffered * (1 + Npoints * Nfields);
+      record[0] = time;
+      double* values = record + 1;
+      std::fill(values, values + Npoints * Nfields, std::numeric_limits<double>::quiet_NaN());
+      for(dlong i = 0; i < Nreceived; i++)
+        for(int fld = 0; fld < Nfields; fld++)
+          values[recvIds[i] * Nfields + fld] = recvValues[i * Nfields + fld];
+      Nbuffered++;
+    }
+
+    platform->timer.toc("probes");
+  }
+
+  if(Nbuffered == bufferSize || nrs->lastStep) flush();
+}
+
+void probes::flush()
+{
+  if(!fp || !Nbuffered) return;
+  fwrite(samples.data(), sizeof(double), (size_t) Nbuffered * (1 + Npoints * Nfields), fp);
+  fflush(fp);
+  Nbuffered = 0;
+}
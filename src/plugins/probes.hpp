@@ -0,0 +1,25 @@
+/*
+   sample velocity, pressure and scalars at a fixed set of points
+
+   The points are located once with gslib's findpts (again at every sample
+   on moving meshes). Every rank interpolates the points it owns on the device,
+   rank 0 buffers the samples and writes them in large blocks to <casename>.probes
+
+   file layout: char[8] "#nrsprb1", int Npoints, int Nfields,
+                double xyz[Npoints][3], int found[Npoints],
+                then one record per sample: double time, double val[Npoints][Nfields]
+                with fields ordered u,v,w,p,s00,s01,... (NaN if a point was not found)
+
+   Note: points are located in the fluid mesh
+ */
+
+#include <string>
+#include "nrs.hpp"
+
+namespace probes
+{
+void setup(nrs_t* nrs_, dlong Npoints, const dfloat* x, const dfloat* y, const dfloat* z);
+void setup(nrs_t* nrs_, const std::string& pointFile);
+void run(dfloat time, int tstep);
+void flush();
+}
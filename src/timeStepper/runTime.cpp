@@ -17,9 +17,9 @@ occa::memory velocityStrongSubCycleMovingMesh(nrs_t* nrs, int nEXT, dfloat time,
 void fluidSolve(nrs_t* nrs, dfloat time, occa::memory o_U, int stage);
 
 void makeq(nrs_t* nrs, dfloat time, int tstep, occa::memory o_FS, occa::memory o_BF);
-occa::memory scalarStrongSubCycleMovingMesh(cds_t* cds, int nEXT, dfloat time, int is,
+occa::memory scalarStrongSubCycleMovingMesh(cds_t* cds, int nEXT, dfloat time, int is, int Nfields,
                                   occa::memory o_U, occa::memory o_S);
-occa::memory scalarStrongSubCycle(cds_t* cds, int nEXT, dfloat time, int is,
+occa::memory scalarStrongSubCycle(cds_t* cds, int nEXT, dfloat time, int is, int Nfields,
                                   occa::memory o_U, occa::memory o_S);
 void scalarSolve(nrs_t* nrs, dfloat time, occa::memory o_S, int stage);
 
@@ -27,6 +27,89 @@ void printInfo(nrs_t* nrs, dfloat time, int tstep, double tElapsedStep, double t
 
 double tElapsed = 0;
 
+namespace {
+// o_Urst is a ring buffer of time levels, level 0 is the newest one
+occa::memory UrstLevel(occa::memory o_Urst, int head, int Nlevels, dlong levelOffset, int level)
+{
+  if(!o_Urst.size()) return o_Urst; // relative velocity is used with moving meshes
+  const int slot = (head + level) % Nlevels;
+  return o_Urst.slice(slot * levelOffset * sizeof(dfloat));
+}
+
+// reorder extrapolation weights from time level to ring buffer slot order
+void UrstSlotOrder(int head, int Nlevels, dfloat* c)
+{
+  dfloat cLevel[3];
+  for(int s = 0; s < 3; s++) cLevel[s] = c[s];
+  for(int s = 0; s < Nlevels; s++) c[(head + s) % Nlevels] = cLevel[s];
+}
+
+// per stage the weights are stored twice, first in ring buffer slot order
+// (o_Urst, o_relUrst, o_divU) followed by time level order (o_LMM)
+dlong subCycleExtCIndex(int Nsubsteps, int nRK, int torder, int ststep, int rk)
+{
+  return STEPCOEFF_EXTC + 6 * ((torder * Nsubsteps + ststep) * nRK + rk);
+}
+
+// device view of the velocity extrapolation weights used in a subcycling stage
+occa::memory subCycleExtC(occa::memory o_stepCoeff, int Nsubsteps, int nRK, int torder, int ststep, int rk)
+{
+  const dlong idx = subCycleExtCIndex(Nsubsteps, nRK, torder, ststep, rk);
+  return o_stepCoeff.slice(idx * sizeof(dfloat), 6 * sizeof(dfloat));
+}
+
+// same weights in time level order
+occa::memory subCycleExtCLevel(occa::memory o_stepCoeff, int Nsubsteps, int nRK, int torder, int ststep, int rk)
+{
+  const dlong idx = subCycleExtCIndex(Nsubsteps, nRK, torder, ststep, rk) + 3;
+  return o_stepCoeff.slice(idx * sizeof(dfloat), 3 * sizeof(dfloat));
+}
+
+// Lagrange extrapolation weights of the velocity levels t^n, t^(n-1), t^(n-2)
+// to all subcycling stage times of this step, the order ramps up like the
+// one the subcyclers run with during the startup steps
+void subCycleExtCoeff(nrs_t* nrs, int tstep)
+{
+  const int nEXT = mymin(tstep, nrs->nEXT);
+  const dfloat tn0 = 0;
+  const dfloat tn1 = -nrs->dt[1];
+  const dfloat tn2 = -(nrs->dt[1] + nrs->dt[2]);
+
+  for (int torder = nEXT - 1; torder >= 0; torder--) {
+    dfloat tsub = 0;
+    for (int i = torder; i > 0 ; i--) tsub -= nrs->dt[i];
+    const dfloat sdt = nrs->dt[torder]/nrs->Nsubsteps;
+
+    for(int ststep = 0; ststep < nrs->Nsubsteps; ++ststep) {
+      const dfloat tstage = tsub + ststep * sdt;
+      for(int rk = 0; rk < nrs->nRK; ++rk) {
+        const dfloat t = tstage + sdt * nrs->nodesRK[rk];
+        dfloat* extC = nrs->stepCoeff + subCycleExtCIndex(nrs->Nsubsteps, nrs->nRK, torder, ststep, rk);
+        switch(nEXT) {
+        case 1:
+          extC[0] = 1;
+          extC[1] = 0;
+          extC[2] = 0;
+          break;
+        case 2:
+          extC[0] = (t - tn1) / (tn0 - tn1);
+          extC[1] = (t - tn0) / (tn1 - tn0);
+          extC[2] = 0;
+          break;
+        case 3:
+          extC[0] = (t - tn1) * (t - tn2) / ((tn0 - tn1) * (tn0 - tn2));
+          extC[1] = (t - tn0) * (t - tn2) / ((tn1 - tn0) * (tn1 - tn2));
+          extC[2] = (t - tn0) * (t - tn1) / ((tn2 - tn0) * (tn2 - tn1));
+          break;
+        }
+        for(int s = 0; s < 3; s++) extC[3 + s] = extC[s];
+        UrstSlotOrder(nrs->UrstHead, nrs->NUrstLevels, extC);
+      }
+    }
+  }
+}
+}
+
 void runStep(nrs_t* nrs, dfloat time, dfloat dt, int tstep)
 {
   const double tStart = MPI_Wtime();
@@ -35,13 +118,18 @@ void runStep(nrs_t* nrs, dfloat time, dfloat dt, int tstep)
   
   cds_t* cds = nrs->cds;
 
+  const bool movingMesh = platform->options.compareArgs("MOVING MESH", "TRUE");
+
+  // the new level replaces the oldest one, no data is moved
+  if(nrs->Nsubsteps)
+    nrs->UrstHead = (nrs->UrstHead + nrs->NUrstLevels - 1) % nrs->NUrstLevels;
+  if(nrs->Nscalar) cds->UrstHead = nrs->UrstHead;
+
   nrs->dt[0] = dt;
   nrs->idt = 1/nrs->dt[0];
   if(nrs->Nscalar) cds->idt = 1/cds->dt[0]; 
   computeCoefficients(nrs, tstep);
 
-  const bool movingMesh = platform->options.compareArgs("MOVING MESH", "TRUE");
-
   if(nrs->flow) 
     nrs->extrapolateKernel(mesh->Nelements,
                            nrs->NVfields,
@@ -69,16 +157,7 @@ void runStep(nrs_t* nrs, dfloat time, dfloat dt, int tstep)
   if(nrs->Nsubsteps) {
     mesh_t* mesh = nrs->meshV;
     if(nrs->cht) mesh = nrs->cds->mesh[0];
-    const dlong NbyteCubature = nrs->NVfields * cubatureOffset * sizeof(dfloat);
-    for (int s = nrs->nEXT; s > 1; s--) {
-      const dlong Nbyte = nrs->fieldOffset * sizeof(dfloat);
-      if(movingMesh){
-        mesh->o_divU.copyFrom(mesh->o_divU, Nbyte, (s - 1)*Nbyte, (s - 2)*Nbyte);
-        nrs->o_relUrst.copyFrom(nrs->o_relUrst , NbyteCubature, (s - 1)*NbyteCubature, (s - 2)*NbyteCubature);
-      } else {
-        nrs->o_Urst.copyFrom(nrs->o_Urst , NbyteCubature, (s - 1)*NbyteCubature, (s - 2)*NbyteCubature);
-      }
-    }
+    // o_divU shares the ring buffer slots of o_relUrst
     if(movingMesh)
       nrs->divergenceVolumeKernel(
         mesh->Nelements,
@@ -86,11 +165,12 @@ void runStep(nrs_t* nrs, dfloat time, dfloat dt, int tstep)
         mesh->o_D,
         nrs->fieldOffset,
         mesh->o_U,
-        mesh->o_divU);
+        UrstLevel(mesh->o_divU, nrs->UrstHead, nrs->NUrstLevels, nrs->fieldOffset, 0));
   }
 
   const bool relative = movingMesh && nrs->Nsubsteps;
-  occa::memory& o_Urst = relative ? nrs->o_relUrst : nrs->o_Urst;
+  occa::memory o_Urst = UrstLevel(relative ? nrs->o_relUrst : nrs->o_Urst,
+                                  nrs->UrstHead, nrs->NUrstLevels, nrs->UrstLevelOffset, 0);
   mesh = nrs->meshV;
   if(platform->options.compareArgs("ADVECTION TYPE", "CUBATURE"))
     nrs->UrstCubatureKernel(
@@ -125,7 +205,6 @@ void runStep(nrs_t* nrs, dfloat time, dfloat dt, int tstep)
 
   if(nrs->flow) {
     platform->timer.tic("makef", 1);
-    platform->linAlg->fillKernel(nrs->fieldOffset * nrs->NVfields, 0.0, nrs->o_FU);
     makef(nrs, time, tstep, nrs->o_FU, nrs->o_BF);
     platform->timer.toc("makef");
   }
@@ -145,7 +224,14 @@ void runStep(nrs_t* nrs, dfloat time, dfloat dt, int tstep)
       const dlong Nbyte = nrs->fieldOffset * nrs->NVfields * sizeof(dfloat);
       mesh->o_U.copyFrom(mesh->o_U , Nbyte, (s - 1)*Nbyte, (s - 2)*Nbyte);
     }
-    if(platform->options.compareArgs("MESH SOLVER", "ELASTICITY")) mesh->solve();
+    if(nrs->meshSolver) {
+      platform->timer.tic("meshSolve", 1);
+      occa::memory o_Unew = tombo::meshSolve(nrs, time, 1);
+      mesh->o_U.copyFrom(o_Unew, nrs->NVfields * nrs->fieldOffset * sizeof(dfloat));
+      platform->scratch.release(o_Unew);
+      platform->timer.toc("meshSolve");
+    }
+    if(nrs->flow) ellipticMultiGridUpdate(nrs->pSolver);
   } 
 
   platform->device.finish();
@@ -168,13 +254,15 @@ void runStep(nrs_t* nrs, dfloat time, dfloat dt, int tstep)
 
     if(udf.properties) {
       platform->timer.tic("udfProperties", 1);
-      occa::memory o_S = platform->o_mempool.slice0;
-      occa::memory o_SProp = platform->o_mempool.slice0;
+      occa::memory o_dummy = platform->scratch.acquireFields(1);
+      occa::memory o_S = o_dummy;
+      occa::memory o_SProp = o_dummy;
       if(nrs->Nscalar) {
         o_S = cds->o_S;
         o_SProp = cds->o_prop;
       }
       udf.properties(nrs, timeNew, nrs->o_U, o_S, nrs->o_prop, o_SProp);
+      platform->scratch.release(o_dummy);
       platform->timer.toc("udfProperties");
     }
 
@@ -233,18 +321,40 @@ void computeCoefficients(nrs_t* nrs, int tstep)
     nek::coeffAB(mesh->coeffAB, nrs->dt, meshOrder);
     for(int i = 0 ; i < meshOrder; ++i) mesh->coeffAB[i] *= nrs->dt[0];
     for(int i = mesh->nAB; i > meshOrder; i--) mesh->coeffAB[i-1] = 0.0;
-    mesh->o_coeffAB.copyFrom(mesh->coeffAB, mesh->nAB * sizeof(dfloat));
   }
 
+  for(int i = 0; i < 3; i++) nrs->stepCoeff[STEPCOEFF_DT + i] = nrs->dt[i];
+
+  if(nrs->Nsubsteps)
+    subCycleExtCoeff(nrs, tstep);
+
+  // single upload of everything the device needs for this step
   nrs->ig0 = 1.0 / nrs->g0;
-  nrs->o_coeffBDF.copyFrom(nrs->coeffBDF);
-  nrs->o_coeffEXT.copyFrom(nrs->coeffEXT);
+  nrs->o_stepCoeff.copyFrom(nrs->stepCoeff, nrs->NstepCoeff * sizeof(dfloat));
 
   if (nrs->Nscalar) {
     nrs->cds->g0 = nrs->g0;
     nrs->cds->ig0 = nrs->ig0;
   }
 }
+
+namespace {
+// scalars advected together share the scratch layout and gather-scatter handle (cds->gsh)
+// of the velocity subcycling which are sized for NVfields
+constexpr int maxScalarBatch = 3;
+
+bool advectTogether(cds_t* cds, int is, int js)
+{
+  if(!cds->compute[js]) return false;
+  mesh_t* meshIs = (is) ? cds->meshV : cds->mesh[0];
+  mesh_t* meshJs = (js) ? cds->meshV : cds->mesh[0];
+  if(meshIs != meshJs) return false;
+  for(std::string key : {"ADVECTION", "ADVECTION TYPE", "MOVING MESH"})
+    if(cds->options[is].getArgs(key) != cds->options[js].getArgs(key)) return false;
+  return true;
+}
+}
+
 void makeq(nrs_t* nrs, dfloat time, int tstep, occa::memory o_FS, occa::memory o_BF)
 {
   cds_t* cds   = nrs->cds;
@@ -289,14 +399,34 @@ void makeq(nrs_t* nrs, dfloat time, int tstep, occa::memory o_FS, occa::memory o
         o_FS
       );
     }
+  }
+
+  // advect consecutive scalars with the same mesh and advection settings in one go
+  for(int is = 0; is < cds->NSfields;) {
+    if(!cds->compute[is]) {
+      is++;
+      continue;
+    }
+
+    int Nbatch = 1;
+    while(Nbatch < maxScalarBatch && is + Nbatch < cds->NSfields && advectTogether(cds, is, is + Nbatch))
+      Nbatch++;
+
+    mesh_t* mesh;
+    (is) ? mesh = cds->meshV : mesh = cds->mesh[0];
+    const dlong isOffset = cds->fieldOffsetScan[is];
+    const int movingMesh = cds->options[is].compareArgs("MOVING MESH", "TRUE");
 
-    occa::memory o_Usubcycling = platform->o_mempool.slice0;
+    occa::memory o_Urst = UrstLevel(cds->o_Urst, cds->UrstHead, cds->NUrstLevels, cds->UrstLevelOffset, 0);
+    occa::memory o_adv = platform->scratch.acquire(cds->fieldOffsetSum * sizeof(dfloat));
+    occa::memory o_Usubcycling = o_adv;
+    const int subcycling = cds->options[is].compareArgs("ADVECTION", "TRUE") && cds->Nsubsteps;
     if(cds->options[is].compareArgs("ADVECTION", "TRUE")) {
       if(cds->Nsubsteps) {
         if(movingMesh)
-          o_Usubcycling = scalarStrongSubCycleMovingMesh(cds, mymin(tstep, cds->nEXT), time, is, cds->o_U, cds->o_S);
+          o_Usubcycling = scalarStrongSubCycleMovingMesh(cds, mymin(tstep, cds->nEXT), time, is, Nbatch, cds->o_U, cds->o_S);
         else
-          o_Usubcycling = scalarStrongSubCycle(cds, mymin(tstep, cds->nEXT), time, is, cds->o_U, cds->o_S);
+          o_Usubcycling = scalarStrongSubCycle(cds, mymin(tstep, cds->nEXT), time, is, Nbatch, cds->o_U, cds->o_S);
       } else {
         if(cds->options[is].compareArgs("ADVECTION TYPE", "CUBATURE"))
           cds->advectionStrongCubatureVolumeKernel(
@@ -308,47 +438,61 @@ void makeq(nrs_t* nrs, dfloat time, int tstep, occa::memory o_FS, occa::memory o
             cds->vFieldOffset,
             isOffset,
             cubatureOffset,
+            Nbatch,
+            cds->fieldOffset[is],
             cds->o_S,
-            cds->o_Urst,
+            o_Urst,
             cds->o_rho,
-            platform->o_mempool.slice0);
+            o_adv);
         else
           cds->advectionStrongVolumeKernel(
             cds->meshV->Nelements,
             mesh->o_D,
             cds->vFieldOffset,
             isOffset,
+            Nbatch,
+            cds->fieldOffset[is],
             cds->o_S,
-            cds->o_Urst,
+            o_Urst,
             cds->o_rho,
-            platform->o_mempool.slice0);
-        platform->linAlg->axpby(
+            o_adv);
+        occa::memory o_FSbatch = o_FS.slice(isOffset * sizeof(dfloat));
+        platform->linAlg->axpbyMany(
           cds->meshV->Nelements * cds->meshV->Np,
+          Nbatch,
+          cds->fieldOffset[is],
           -1.0,
-          platform->o_mempool.slice0,
+          o_adv,
           1.0,
-          o_FS,
-          0, isOffset
+          o_FSbatch
         );
       }
     } else {
       platform->linAlg->fill(cds->fieldOffsetSum, 0.0, o_Usubcycling);
     } 
 
-    cds->sumMakefKernel(
-      mesh->Nlocal,
-      mesh->o_LMM,
-      cds->idt,
-      cds->o_coeffEXT,
-      cds->o_coeffBDF,
-      cds->fieldOffsetSum,
-      cds->fieldOffset[is],
-      isOffset,
-      cds->o_S,
-      o_Usubcycling,
-      o_FS,
-      cds->o_rho,
-      o_BF);
+    for(int fld = 0; fld < Nbatch; fld++) {
+      occa::memory o_NS = o_Usubcycling.slice(fld * cds->fieldOffset[is] * sizeof(dfloat));
+      cds->sumMakefKernel(
+        mesh->Nlocal,
+        mesh->o_LMM,
+        cds->idt,
+        cds->o_coeffEXT,
+        cds->o_coeffBDF,
+        cds->fieldOffsetSum,
+        cds->fieldOffset[is + fld],
+        cds->fieldOffsetScan[is + fld],
+        cds->o_S,
+        o_NS,
+        o_FS,
+        cds->o_rho,
+        o_BF);
+    }
+
+    if(subcycling) platform->scratch.release(o_Usubcycling);
+    platform->scratch.release(o_adv);
+
+    is += Nbatch;
   }
 
   for (int s = std::max(cds->nBDF, cds->nEXT); s > 1; s--) {
@@ -391,6 +535,7 @@ void scalarSolve(nrs_t* nrs, dfloat time, occa::memory o_S, int stage)
 
     occa::memory o_Snew = cdsSolve(is, cds, time, stage);
     o_Snew.copyTo(o_S, cds->fieldOffset[is] * sizeof(dfloat), cds->fieldOffsetScan[is] * sizeof(dfloat));
+    platform->scratch.release(o_Snew);
   }
   platform->timer.toc("scalarSolve");
 }
@@ -401,21 +546,17 @@ void makef(nrs_t* nrs, dfloat time, int tstep, occa::memory o_FU, occa::memory o
   const int verbose = platform->options.compareArgs("VERBOSE", "TRUE"); 
   const int movingMesh = platform->options.compareArgs("MOVING MESH", "TRUE");
 
+  // contributions accumulated into FU before the fused kernel
+  const int addFU = udf.uEqnSource || (movingMesh && !nrs->Nsubsteps);
+  if(addFU)
+    platform->linAlg->fill(nrs->fieldOffset * nrs->NVfields, 0.0, o_FU);
+
   if(udf.uEqnSource) {
     platform->timer.tic("udfUEqnSource", 1);
     udf.uEqnSource(nrs, time, nrs->o_U, o_FU);
     platform->timer.toc("udfUEqnSource");
   }
 
-  if(platform->options.compareArgs("FILTER STABILIZATION", "RELAXATION"))
-    nrs->filterRTKernel(
-      mesh->Nelements,
-      nrs->o_filterMT,
-      nrs->filterS,
-      nrs->fieldOffset,
-      nrs->o_U,
-      o_FU);
-
   if(movingMesh && !nrs->Nsubsteps){
     nrs->advectMeshVelocityKernel(
       mesh->Nelements,
@@ -428,58 +569,72 @@ void makef(nrs_t* nrs, dfloat time, int tstep, occa::memory o_FU, occa::memory o
     );
   }
 
-  occa::memory o_Usubcycling = platform->o_mempool.slice0;
+  occa::memory o_Urst = UrstLevel(nrs->o_Urst, nrs->UrstHead, nrs->NUrstLevels, nrs->UrstLevelOffset, 0);
+  occa::memory o_adv = platform->scratch.acquireFields(nrs->NVfields);
+  occa::memory o_Usubcycling = o_adv;
+  const int subcycling = platform->options.compareArgs("ADVECTION", "TRUE") && nrs->Nsubsteps;
   if(platform->options.compareArgs("ADVECTION", "TRUE")) {
     if(nrs->Nsubsteps) {
       if(movingMesh)     
         o_Usubcycling = velocityStrongSubCycleMovingMesh(nrs, mymin(tstep, nrs->nEXT), time, nrs->o_U);
       else 
         o_Usubcycling = velocityStrongSubCycle(nrs, mymin(tstep, nrs->nEXT), time, nrs->o_U);
-    } else {
-      if(platform->options.compareArgs("ADVECTION TYPE", "CUBATURE"))
-        nrs->advectionStrongCubatureVolumeKernel(
-          mesh->Nelements,
-          mesh->o_vgeo,
-          mesh->o_cubDiffInterpT,
-          mesh->o_cubInterpT,
-          mesh->o_cubProjectT,
-          nrs->fieldOffset,
-          std::max(nrs->fieldOffset, mesh->Nelements * mesh->cubNp),
-          nrs->o_U,
-          nrs->o_Urst,
-          platform->o_mempool.slice0);
-      else
-        nrs->advectionStrongVolumeKernel(
-          mesh->Nelements,
-          mesh->o_D,
-          nrs->fieldOffset,
-          nrs->o_U,
-          nrs->o_Urst,
-          platform->o_mempool.slice0);
-
-      platform->linAlg->axpby(
-        nrs->NVfields * nrs->fieldOffset,
-        -1.0,
-        platform->o_mempool.slice0,
-        1.0,
-        o_FU
-      );
+    } else if(platform->options.compareArgs("ADVECTION TYPE", "CUBATURE")) {
+      // collocation advection is evaluated inside makefKernel
+      nrs->advectionStrongCubatureVolumeKernel(
+        mesh->Nelements,
+        mesh->o_vgeo,
+        mesh->o_cubDiffInterpT,
+        mesh->o_cubInterpT,
+        mesh->o_cubProjectT,
+        nrs->fieldOffset,
+        std::max(nrs->fieldOffset, mesh->Nelements * mesh->cubNp),
+        nrs->o_U,
+        o_Urst,
+        o_Usubcycling);
     }
   } else {
     if(nrs->Nsubsteps) platform->linAlg->fill(nrs->fieldOffset * nrs->NVfields, 0.0, o_Usubcycling);
   }
 
-  nrs->sumMakefKernel(
-    mesh->Nlocal,
-    mesh->o_LMM,
-    nrs->idt,
-    nrs->o_coeffEXT,
-    nrs->o_coeffBDF,
-    nrs->fieldOffset,
-    nrs->o_U,
-    o_Usubcycling,
-    o_FU,
-    o_BF);
+  // filter, advection, extrapolation and BDF sums in a single pass followed
+  // by the lag shifts, the udf source and the subcycler run before
+  launchGraph_t& graph = nrs->makefGraph;
+  const std::string graphKey = launchGraph_t::key(nrs->idt, addFU, o_Urst, o_Usubcycling, o_FU, o_BF);
+  if(!graph.replay(graphKey)) {
+    graph.beginCapture(graphKey);
+
+    const bool filter = platform->options.compareArgs("FILTER STABILIZATION", "RELAXATION");
+    graph(nrs->makefKernel,
+      mesh->Nelements,
+      mesh->o_D,
+      filter ? nrs->o_filterMT : mesh->o_D, // unused if filter is off
+      nrs->filterS,
+      mesh->o_LMM,
+      nrs->idt,
+      nrs->o_coeffEXT,
+      nrs->o_coeffBDF,
+      nrs->fieldOffset,
+      addFU,
+      nrs->o_U,
+      o_Urst,
+      o_Usubcycling,
+      o_FU,
+      o_BF);
+
+    for (int s = std::max(nrs->nBDF, nrs->nEXT); s > 1; s--) {
+      const dlong Nbyte = nrs->fieldOffset * nrs->NVfields * sizeof(dfloat);
+      graph.host([=]() mutable {
+        nrs->o_U.copyFrom(nrs->o_U, Nbyte, (s - 1)*Nbyte, (s - 2)*Nbyte);
+        o_FU.copyFrom(o_FU, Nbyte, (s - 1)*Nbyte, (s - 2)*Nbyte);
+      });
+    }
+
+    graph.endCapture();
+  }
+
+  if(subcycling) platform->scratch.release(o_Usubcycling);
+  platform->scratch.release(o_adv);
 
   if(verbose) {
     const dfloat debugNorm =
@@ -493,12 +648,6 @@ void makef(nrs_t* nrs, dfloat time, int tstep, occa::memory o_FU, occa::memory o
       );
     if(platform->comm.mpiRank == 0) printf("BF norm: %.15e\n", debugNorm);
   }
-
-  for (int s = std::max(nrs->nBDF, nrs->nEXT); s > 1; s--) {
-    const dlong Nbyte = nrs->fieldOffset * nrs->NVfields * sizeof(dfloat);
-    nrs->o_U.copyFrom (nrs->o_U , Nbyte, (s - 1)*Nbyte, (s - 2)*Nbyte);
-    o_FU.copyFrom(o_FU, Nbyte, (s - 1)*Nbyte, (s - 2)*Nbyte);
-  }
 }
 
 void fluidSolve(nrs_t* nrs, dfloat time, occa::memory o_U, int stage)
@@ -514,6 +663,7 @@ void fluidSolve(nrs_t* nrs, dfloat time, occa::memory o_U, int stage)
     nrs->o_ellipticCoeff);
   occa::memory o_Pnew = tombo::pressureSolve(nrs, time, stage);
   nrs->o_P.copyFrom(o_Pnew, nrs->fieldOffset * sizeof(dfloat));
+  platform->scratch.release(o_Pnew);
   platform->timer.toc("pressureSolve");
 
   platform->timer.tic("velocitySolve", 1);
@@ -528,6 +678,7 @@ void fluidSolve(nrs_t* nrs, dfloat time, occa::memory o_U, int stage)
 
   occa::memory o_Unew = tombo::velocitySolve(nrs, time, stage);
   o_U.copyFrom(o_Unew, nrs->NVfields * nrs->fieldOffset * sizeof(dfloat));
+  platform->scratch.release(o_Unew);
   platform->timer.toc("velocitySolve");
 }
 
@@ -536,15 +687,18 @@ occa::memory velocityStrongSubCycleMovingMesh(nrs_t* nrs, int nEXT, dfloat time,
   mesh_t* mesh = nrs->meshV;
   linAlg_t* linAlg = platform->linAlg;
 
-  occa::memory& o_p0 = platform->o_mempool.slice0;
-  occa::memory& o_u1 = platform->o_mempool.slice3;
+  // o_p0 is handed back to the caller, everything else is released on return
+  const size_t NbyteVec = nrs->NVfields * nrs->fieldOffset * sizeof(dfloat);
+  occa::memory o_p0 = platform->scratch.acquireFields(nrs->NVfields);
+  occa::memory o_u1 = platform->scratch.acquireFields(nrs->NVfields);
 
-  occa::memory& o_r1 = platform->o_mempool.slice6;
-  occa::memory& o_r2 = platform->o_mempool.slice9;
-  occa::memory& o_r3 = platform->o_mempool.slice12;
-  occa::memory& o_r4 = platform->o_mempool.slice15;
+  occa::memory o_rk = platform->scratch.acquireFields(4 * nrs->NVfields);
+  occa::memory o_r1 = o_rk.slice(0 * NbyteVec, NbyteVec);
+  occa::memory o_r2 = o_rk.slice(1 * NbyteVec, NbyteVec);
+  occa::memory o_r3 = o_rk.slice(2 * NbyteVec, NbyteVec);
+  occa::memory o_r4 = o_rk.slice(3 * NbyteVec, NbyteVec);
 
-  occa::memory& o_LMMe = platform->o_mempool.slice18;
+  occa::memory o_LMMe = platform->scratch.acquireFields(1);
 
   const dlong cubatureOffset = std::max(nrs->fieldOffset, mesh->cubNp * mesh->Nelements);
 
@@ -568,13 +722,9 @@ occa::memory velocityStrongSubCycleMovingMesh(nrs_t* nrs, int nEXT, dfloat time,
     );
 
     // Advance subproblem from here from t^(n-torder) to t^(n-torder+1)
-    dfloat tsub = time;
-    for (int i = torder; i > 0 ; i--) tsub -= nrs->dt[i];
     const dfloat sdt = nrs->dt[torder]/nrs->Nsubsteps;
 
     for(int ststep = 0; ststep < nrs->Nsubsteps; ++ststep) {
-      const dfloat tstage = tsub + ststep * sdt;
-
       o_u1.copyFrom(o_p0, nrs->NVfields * nrs->fieldOffset * sizeof(dfloat));
 
       for(int rk = 0; rk < nrs->nRK; ++rk) {
@@ -583,37 +733,14 @@ occa::memory velocityStrongSubCycleMovingMesh(nrs_t* nrs, int nEXT, dfloat time,
         if(rk == 1) o_rhs = o_r2;
         if(rk == 2) o_rhs = o_r3;
         if(rk == 3) o_rhs = o_r4;
-        // Extrapolate velocity to subProblem stage time
-        const dfloat t   = tstage +  sdt * nrs->nodesRK[rk];
-        const dfloat tn0 = time;
-        const dfloat tn1 = time - nrs->dt[1];
-        const dfloat tn2 = time - (nrs->dt[1] + nrs->dt[2]);
-        dfloat extC[3] = {0., 0., 0.};
-        switch(nEXT) {
-        case 1:
-          extC[0] = 1;
-          extC[1] = 0;
-          extC[2] = 0;
-          break;
-        case 2:
-          extC[0] = (t - tn1) / (tn0 - tn1);
-          extC[1] = (t - tn0) / (tn1 - tn0);
-          extC[2] = 0;
-          break;
-        case 3:
-          extC[0] = (t - tn1) * (t - tn2) / ((tn0 - tn1) * (tn0 - tn2));
-          extC[1] = (t - tn0) * (t - tn2) / ((tn1 - tn0) * (tn1 - tn2));
-          extC[2] = (t - tn0) * (t - tn1) / ((tn2 - tn0) * (tn2 - tn1));
-          break;
-        }
+        // extrapolation weights of the velocity at the stage time
+        occa::memory o_extC = subCycleExtC(nrs->o_stepCoeff, nrs->Nsubsteps, nrs->nRK, torder, ststep, rk);
 
         nrs->nStagesSum3Kernel(
           mesh->Nlocal,
           nrs->fieldOffset,
           nEXT,
-          extC[0],
-          extC[1],
-          extC[2],
+          subCycleExtCLevel(nrs->o_stepCoeff, nrs->Nsubsteps, nrs->nRK, torder, ststep, rk),
           mesh->o_LMM,
           o_LMMe
         );
@@ -640,9 +767,7 @@ occa::memory velocityStrongSubCycleMovingMesh(nrs_t* nrs, int nEXT, dfloat time,
               0,
               mesh->o_invLMM,
               mesh->o_divU,
-              extC[0],
-              extC[1],
-              extC[2],
+              o_extC,
               nrs->o_relUrst,
               o_u1,
               o_rhs);
@@ -655,9 +780,7 @@ occa::memory velocityStrongSubCycleMovingMesh(nrs_t* nrs, int nEXT, dfloat time,
               0,
               mesh->o_invLMM,
               mesh->o_divU,
-              extC[0],
-              extC[1],
-              extC[2],
+              o_extC,
               nrs->o_relUrst,
               o_u1,
               o_rhs);
@@ -678,9 +801,7 @@ occa::memory velocityStrongSubCycleMovingMesh(nrs_t* nrs, int nEXT, dfloat time,
               0,
               mesh->o_invLMM,
               mesh->o_divU,
-              extC[0],
-              extC[1],
-              extC[2],
+              o_extC,
               nrs->o_relUrst,
               o_u1,
               o_rhs);
@@ -693,9 +814,7 @@ occa::memory velocityStrongSubCycleMovingMesh(nrs_t* nrs, int nEXT, dfloat time,
               0,
               mesh->o_invLMM,
               mesh->o_divU,
-              extC[0],
-              extC[1],
-              extC[2],
+              o_extC,
               nrs->o_relUrst,
               o_u1,
               o_rhs);
@@ -730,6 +849,9 @@ occa::memory velocityStrongSubCycleMovingMesh(nrs_t* nrs, int nEXT, dfloat time,
       }
     }
   }
+  platform->scratch.release(o_LMMe);
+  platform->scratch.release(o_rk);
+  platform->scratch.release(o_u1);
   return o_p0;
 }
 occa::memory velocityStrongSubCycle(nrs_t* nrs, int nEXT, dfloat time, occa::memory o_U)
@@ -743,11 +865,30 @@ occa::memory velocityStrongSubCycle(nrs_t* nrs, int nEXT, dfloat time, occa::mem
   else
     cubatureOffset = nrs->fieldOffset;
 
+  // scratch layout: Ud [NVfields], U0 (or 2N residual) [NVfields], rhs [nRhs][NVfields]
+  // only classical ERK keeps the rhs of all stages
+  const int nRhs = (nrs->RKform == SUBCYCLE_ERK) ? nrs->nRK : 1;
+  const size_t NbyteVec = nrs->NVfields * nrs->fieldOffset * sizeof(dfloat);
+  occa::memory o_Ud = platform->scratch.acquireFields((2 + nRhs) * nrs->NVfields);
+  occa::memory o_U0 = o_Ud.slice(NbyteVec);
+  occa::memory o_rhsRK = o_Ud.slice(2 * NbyteVec);
+
+  // launch arguments only depend on the history of dt, the startup order ramp and the buffers
+  launchGraph_t& graph = nrs->subCycleGraph;
+  const std::string graphKey = launchGraph_t::key(nEXT, nrs->dt[0], nrs->dt[1], nrs->dt[2],
+                                                  nrs->coeffBDF[0], nrs->coeffBDF[1], nrs->coeffBDF[2],
+                                                  o_U, o_Ud);
+  if(graph.replay(graphKey)) return o_Ud;
+  graph.beginCapture(graphKey);
+
+  if(nrs->RKform == SUBCYCLE_LSRK_2N)
+    graph.host([=]() mutable { linAlg->fill(nrs->NVfields * nrs->fieldOffset, 0.0, o_U0); });
+
   // Solve for Each SubProblem
   for (int torder = nEXT - 1; torder >= 0; torder--) {
     // Initialize SubProblem Velocity i.e. Ud = U^(t-torder*dt)
     dlong toffset = torder * nrs->NVfields * nrs->fieldOffset;
-    nrs->subCycleInitU0Kernel(
+    graph(nrs->subCycleInitU0Kernel,
       mesh->Nlocal,
       nrs->NVfields,
       nrs->fieldOffset,
@@ -758,48 +899,24 @@ occa::memory velocityStrongSubCycle(nrs_t* nrs, int nEXT, dfloat time, occa::mem
       nrs->coeffBDF[torder],
       mesh->o_LMM,
       o_U,
-      platform->o_mempool.slice0
+      o_Ud
     );
 
     // Advance subproblem from here from t^(n-torder) to t^(n-torder+1)
-    dfloat tsub = time;
-    for (int i = torder; i > 0 ; i--) tsub -= nrs->dt[i];
     const dfloat sdt = nrs->dt[torder]/nrs->Nsubsteps;
 
     for(int ststep = 0; ststep < nrs->Nsubsteps; ++ststep) {
-      const dfloat tstage = tsub + ststep * sdt;
-
-      platform->o_mempool.slice0.copyFrom(platform->o_mempool.slice0, nrs->NVfields * nrs->fieldOffset * sizeof(dfloat),
-                           nrs->NVfields * nrs->fieldOffset * sizeof(dfloat),0);
+      if(nrs->RKform != SUBCYCLE_LSRK_2N)
+        graph.host([=]() mutable { o_U0.copyFrom(o_Ud, NbyteVec); });
 
       for(int rk = 0; rk < nrs->nRK; ++rk) {
-        // Extrapolate velocity to subProblem stage time
-        const dfloat t   = tstage +  sdt * nrs->nodesRK[rk];
-        const dfloat tn0 = time;
-        const dfloat tn1 = time - nrs->dt[1];
-        const dfloat tn2 = time - (nrs->dt[1] + nrs->dt[2]);
-        dfloat extC[3] = {0., 0., 0.};
-        switch(nEXT) {
-        case 1:
-          extC[0] = 1;
-          extC[1] = 0;
-          extC[2] = 0;
-          break;
-        case 2:
-          extC[0] = (t - tn1) / (tn0 - tn1);
-          extC[1] = (t - tn0) / (tn1 - tn0);
-          extC[2] = 0;
-          break;
-        case 3:
-          extC[0] = (t - tn1) * (t - tn2) / ((tn0 - tn1) * (tn0 - tn2));
-          extC[1] = (t - tn0) * (t - tn2) / ((tn1 - tn0) * (tn1 - tn2));
-          extC[2] = (t - tn0) * (t - tn1) / ((tn2 - tn0) * (tn2 - tn1));
-          break;
-        }
+        const dlong rhsOffset = (nrs->RKform == SUBCYCLE_ERK) ? rk * nrs->NVfields * nrs->fieldOffset : 0;
+        // extrapolation weights of the velocity at the stage time
+        occa::memory o_extC = subCycleExtC(nrs->o_stepCoeff, nrs->Nsubsteps, nrs->nRK, torder, ststep, rk);
 
         if(mesh->NglobalGatherElements) {
           if(platform->options.compareArgs("ADVECTION TYPE", "CUBATURE"))
-            nrs->subCycleStrongCubatureVolumeKernel(
+            graph(nrs->subCycleStrongCubatureVolumeKernel,
               mesh->NglobalGatherElements,
               mesh->o_globalGatherElementList,
               mesh->o_cubDiffInterpT,
@@ -807,43 +924,35 @@ occa::memory velocityStrongSubCycle(nrs_t* nrs, int nEXT, dfloat time, occa::mem
               mesh->o_cubProjectT,
               nrs->fieldOffset,
               cubatureOffset,
-              rk * nrs->NVfields * nrs->fieldOffset,
+              rhsOffset,
               mesh->o_invLMM,
               mesh->o_divU,
-              extC[0],
-              extC[1],
-              extC[2],
+              o_extC,
               nrs->o_Urst,
-              platform->o_mempool.slice0,
-              platform->o_mempool.slice6);
+              o_Ud,
+              o_rhsRK);
           else
-            nrs->subCycleStrongVolumeKernel(
+            graph(nrs->subCycleStrongVolumeKernel,
               mesh->NglobalGatherElements,
               mesh->o_globalGatherElementList,
               mesh->o_D,
               nrs->fieldOffset,
-              rk * nrs->NVfields * nrs->fieldOffset,
+              rhsOffset,
               mesh->o_invLMM,
               mesh->o_divU,
-              extC[0],
-              extC[1],
-              extC[2],
+              o_extC,
               nrs->o_Urst,
-              platform->o_mempool.slice0,
-              platform->o_mempool.slice6);
+              o_Ud,
+              o_rhsRK);
         }
 
-        occa::memory o_rhs;
-        if(rk == 0) o_rhs = platform->o_mempool.slice6;
-        if(rk == 1) o_rhs = platform->o_mempool.slice9;
-        if(rk == 2) o_rhs = platform->o_mempool.slice12;
-        if(rk == 3) o_rhs = platform->o_mempool.slice15;
+        occa::memory o_rhs = o_rhsRK.slice(rhsOffset * sizeof(dfloat), NbyteVec);
 
-        oogs::start(o_rhs, nrs->NVfields, nrs->fieldOffset,ogsDfloat, ogsAdd, nrs->gsh);                     
+        graph.host([=]() mutable { oogs::start(o_rhs, nrs->NVfields, nrs->fieldOffset,ogsDfloat, ogsAdd, nrs->gsh); });
 
         if(mesh->NlocalGatherElements) {
           if(platform->options.compareArgs("ADVECTION TYPE", "CUBATURE"))
-            nrs->subCycleStrongCubatureVolumeKernel(
+            graph(nrs->subCycleStrongCubatureVolumeKernel,
               mesh->NlocalGatherElements,
               mesh->o_localGatherElementList,
               mesh->o_cubDiffInterpT,
@@ -851,66 +960,90 @@ occa::memory velocityStrongSubCycle(nrs_t* nrs, int nEXT, dfloat time, occa::mem
               mesh->o_cubProjectT,
               nrs->fieldOffset,
               cubatureOffset,
-              rk * nrs->NVfields * nrs->fieldOffset,
+              rhsOffset,
               mesh->o_invLMM,
               mesh->o_divU,
-              extC[0],
-              extC[1],
-              extC[2],
+              o_extC,
               nrs->o_Urst,
-              platform->o_mempool.slice0,
-              platform->o_mempool.slice6);
+              o_Ud,
+              o_rhsRK);
           else
-            nrs->subCycleStrongVolumeKernel(
+            graph(nrs->subCycleStrongVolumeKernel,
               mesh->NlocalGatherElements,
               mesh->o_localGatherElementList,
               mesh->o_D,
               nrs->fieldOffset,
-              rk * nrs->NVfields * nrs->fieldOffset,
+              rhsOffset,
               mesh->o_invLMM,
               mesh->o_divU,
-              extC[0],
-              extC[1],
-              extC[2],
+              o_extC,
               nrs->o_Urst,
-              platform->o_mempool.slice0,
-              platform->o_mempool.slice6);
+              o_Ud,
+              o_rhsRK);
         }
 
-        oogs::finish(o_rhs, nrs->NVfields, nrs->fieldOffset,ogsDfloat, ogsAdd, nrs->gsh);                     
+        graph.host([=]() mutable { oogs::finish(o_rhs, nrs->NVfields, nrs->fieldOffset,ogsDfloat, ogsAdd, nrs->gsh); });
 
-        nrs->subCycleRKUpdateKernel(
-          mesh->Nelements,
-          rk,
-          sdt,
-          nrs->fieldOffset,
-          nrs->o_coeffsfRK,
-          nrs->o_weightsRK,
-          platform->o_mempool.slice3,
-          platform->o_mempool.slice6,
-          platform->o_mempool.slice0);
+        if(nrs->RKform == SUBCYCLE_LSRK_2N)
+          graph(nrs->subCycleRKUpdateKernel,
+            mesh->Nelements,
+            sdt,
+            nrs->coeffsfRK[rk],
+            nrs->weightsRK[rk],
+            nrs->fieldOffset,
+            o_rhs,
+            o_U0,
+            o_Ud);
+        else if(nrs->RKform == SUBCYCLE_SSPRK_2S)
+          graph(nrs->subCycleRKUpdateKernel,
+            mesh->Nelements,
+            sdt,
+            nrs->coeffsfRK[rk],
+            nrs->weightsRK[rk],
+            nrs->fieldOffset,
+            o_U0,
+            o_rhs,
+            o_Ud);
+        else
+          graph(nrs->subCycleRKUpdateKernel,
+            mesh->Nelements,
+            rk,
+            sdt,
+            nrs->fieldOffset,
+            nrs->o_coeffsfRK,
+            nrs->o_weightsRK,
+            o_U0,
+            o_rhsRK,
+            o_Ud);
       }
     }
   }
-  linAlg->axmyMany(mesh->Nlocal, 3, nrs->fieldOffset, 0, 1.0, mesh->o_LMM, platform->o_mempool.slice0);
-  return platform->o_mempool.slice0;
+  graph.host([=]() mutable { linAlg->axmyMany(mesh->Nlocal, 3, nrs->fieldOffset, 0, 1.0, mesh->o_LMM, o_Ud); });
+  graph.endCapture();
+
+  return o_Ud;
 }
 
-occa::memory scalarStrongSubCycleMovingMesh(cds_t* cds, int nEXT, dfloat time, int is,
+occa::memory scalarStrongSubCycleMovingMesh(cds_t* cds, int nEXT, dfloat time, int is, int Nfields,
                                   occa::memory o_U, occa::memory o_S)
 {
 
   linAlg_t* linAlg = platform->linAlg;
 
-  occa::memory& o_r1 = platform->o_mempool.slice2;
-  occa::memory& o_r2 = platform->o_mempool.slice3;
-  occa::memory& o_r3 = platform->o_mempool.slice4;
-  occa::memory& o_r4 = platform->o_mempool.slice5;
+  // scratch layout: p0 [Nfields], LMMe, r1-r4 [Nfields], u1 [Nfields]
+  const dlong fieldOffset = cds->fieldOffset[is];
+  occa::memory o_scratch = platform->scratch.acquire((6 * Nfields + 1) * fieldOffset * sizeof(dfloat));
+  auto scratch = [&](dlong n) { return o_scratch.slice(n * fieldOffset * sizeof(dfloat)); };
 
-  occa::memory& o_p0 = platform->o_mempool.slice0;
-  occa::memory& o_u1 = platform->o_mempool.slice6;
+  occa::memory o_r1 = scratch(Nfields + 1);
+  occa::memory o_r2 = scratch(2 * Nfields + 1);
+  occa::memory o_r3 = scratch(3 * Nfields + 1);
+  occa::memory o_r4 = scratch(4 * Nfields + 1);
 
-  occa::memory& o_LMMe = platform->o_mempool.slice1;
+  occa::memory o_p0 = scratch(0);
+  occa::memory o_u1 = scratch(5 * Nfields + 1);
+
+  occa::memory o_LMMe = scratch(Nfields);
   
   dlong cubatureOffset = std::max(cds->vFieldOffset, cds->meshV->Nelements * cds->meshV->cubNp);
 
@@ -919,11 +1052,11 @@ occa::memory scalarStrongSubCycleMovingMesh(cds_t* cds, int nEXT, dfloat time, i
     // Initialize SubProblem Velocity i.e. Ud = U^(t-torder*dt)
     const dlong toffset = cds->fieldOffsetScan[is] +
                           torder * cds->fieldOffsetSum;
-    const dlong offset = torder * cds->fieldOffset[is];
+    const dlong offset = torder * fieldOffset;
     cds->subCycleInitU0Kernel(
       cds->mesh[0]->Nlocal,
-      1,
-      cds->fieldOffset[is],
+      Nfields,
+      fieldOffset,
       torder,
       nEXT,
       toffset,
@@ -935,13 +1068,10 @@ occa::memory scalarStrongSubCycleMovingMesh(cds_t* cds, int nEXT, dfloat time, i
     );
 
     // Advance SubProblem to t^(n-torder+1)
-    dfloat tsub = time;
-    for (int i = torder; i > 0 ; i--) tsub -= cds->dt[i];
     const dfloat sdt = cds->dt[torder]/cds->Nsubsteps;
 
     for(int ststep = 0; ststep < cds->Nsubsteps; ++ststep) {
-      const dfloat tstage = tsub + ststep * sdt;
-      o_u1.copyFrom(o_p0, cds->mesh[0]->Nlocal * sizeof(dfloat));
+      o_u1.copyFrom(o_p0, Nfields * fieldOffset * sizeof(dfloat));
       for(int rk = 0; rk < cds->nRK; ++rk)
       {
         occa::memory o_rhs;
@@ -950,40 +1080,17 @@ occa::memory scalarStrongSubCycleMovingMesh(cds_t* cds, int nEXT, dfloat time, i
         if(rk == 2) o_rhs = o_r3;
         if(rk == 3) o_rhs = o_r4;
 
-        // Extrapolate velocity to subProblem stage time
-        const dfloat t   = tstage +  sdt * cds->nodesRK[rk];
-        const dfloat tn0 = time;
-        const dfloat tn1 = time - cds->dt[1];
-        const dfloat tn2 = time - (cds->dt[1] + cds->dt[2]);
-        dfloat extC[3] = {0., 0., 0.};
-        switch(nEXT) {
-        case 1:
-          extC[0] = 1;
-          extC[1] = 0;
-          extC[2] = 0;
-          break;
-        case 2:
-          extC[0] = (t - tn1) / (tn0 - tn1);
-          extC[1] = (t - tn0) / (tn1 - tn0);
-          extC[2] = 0;
-          break;
-        case 3:
-          extC[0] = (t - tn1) * (t - tn2) / ((tn0 - tn1) * (tn0 - tn2));
-          extC[1] = (t - tn0) * (t - tn2) / ((tn1 - tn0) * (tn1 - tn2));
-          extC[2] = (t - tn0) * (t - tn1) / ((tn2 - tn0) * (tn2 - tn1));
-          break;
-        }
+        // extrapolation weights of the velocity at the stage time
+        occa::memory o_extC = subCycleExtC(cds->o_stepCoeff, cds->Nsubsteps, cds->nRK, torder, ststep, rk);
         cds->nStagesSum3Kernel(
           cds->mesh[0]->Nlocal,
           cds->vFieldOffset,
           nEXT,
-          extC[0],
-          extC[1],
-          extC[2],
+          subCycleExtCLevel(cds->o_stepCoeff, cds->Nsubsteps, cds->nRK, torder, ststep, rk),
           cds->mesh[0]->o_LMM,
           o_LMMe
         );
-        linAlg->aydx(cds->mesh[0]->Nlocal, 1.0, o_LMMe, o_u1);
+        linAlg->aydxMany(cds->mesh[0]->Nlocal, Nfields, fieldOffset, 0, 1.0, o_LMMe, o_u1);
 
         if(cds->meshV->NglobalGatherElements) {
           if(cds->options[is].compareArgs("ADVECTION TYPE", "CUBATURE"))
@@ -996,11 +1103,10 @@ occa::memory scalarStrongSubCycleMovingMesh(cds_t* cds, int nEXT, dfloat time, i
               cds->vFieldOffset,
               cubatureOffset,
               0,
+              Nfields,
               cds->mesh[0]->o_invLMM,
               cds->mesh[0]->o_divU,
-              extC[0],
-              extC[1],
-              extC[2],
+              o_extC,
               cds->o_relUrst,
               o_u1,
               o_rhs);
@@ -1011,17 +1117,16 @@ occa::memory scalarStrongSubCycleMovingMesh(cds_t* cds, int nEXT, dfloat time, i
               cds->meshV->o_D,
               cds->vFieldOffset,
               0,
+              Nfields,
               cds->mesh[0]->o_invLMM,
               cds->mesh[0]->o_divU,
-              extC[0],
-              extC[1],
-              extC[2],
+              o_extC,
               cds->o_relUrst,
               o_u1,
               o_rhs);
         }
 
-        oogs::start(o_rhs, 1, cds->fieldOffset[is], ogsDfloat, ogsAdd, cds->gsh);
+        oogs::start(o_rhs, Nfields, fieldOffset, ogsDfloat, ogsAdd, cds->gsh);
 
         if(cds->meshV->NlocalGatherElements) {
           if(cds->options[is].compareArgs("ADVECTION TYPE", "CUBATURE"))
@@ -1034,11 +1139,10 @@ occa::memory scalarStrongSubCycleMovingMesh(cds_t* cds, int nEXT, dfloat time, i
               cds->vFieldOffset,
               cubatureOffset,
               0,
+              Nfields,
               cds->mesh[0]->o_invLMM,
               cds->mesh[0]->o_divU,
-              extC[0],
-              extC[1],
-              extC[2],
+              o_extC,
               cds->o_relUrst,
               o_u1,
               o_rhs);
@@ -1049,24 +1153,25 @@ occa::memory scalarStrongSubCycleMovingMesh(cds_t* cds, int nEXT, dfloat time, i
               cds->meshV->o_D,
               cds->vFieldOffset,
               0,
+              Nfields,
               cds->mesh[0]->o_invLMM,
               cds->mesh[0]->o_divU,
-              extC[0],
-              extC[1],
-              extC[2],
+              o_extC,
               cds->o_relUrst,
               o_u1,
               o_rhs);
         }
 
-        oogs::finish(o_rhs, 1, cds->fieldOffset[is], ogsDfloat, ogsAdd, cds->gsh);
+        oogs::finish(o_rhs, Nfields, fieldOffset, ogsDfloat, ogsAdd, cds->gsh);
 
-        linAlg->axmy(cds->mesh[0]->Nlocal, 1.0, o_LMMe, o_rhs);
+        linAlg->axmyMany(cds->mesh[0]->Nlocal, Nfields, fieldOffset, 0, 1.0, o_LMMe, o_rhs);
         if(rk != 3)
-          linAlg->axpbyz(cds->mesh[0]->Nlocal, 1.0, o_p0, -sdt * cds->coeffsfRK[rk+1], o_rhs, o_u1);
+          linAlg->axpbyzMany(cds->mesh[0]->Nlocal, Nfields, fieldOffset, 1.0, o_p0, -sdt * cds->coeffsfRK[rk+1], o_rhs, o_u1);
         else
           cds->subCycleRKKernel(
             cds->mesh[0]->Nlocal,
+            Nfields,
+            fieldOffset,
             sdt,
             cds->o_weightsRK,
             o_r1,
@@ -1080,21 +1185,39 @@ occa::memory scalarStrongSubCycleMovingMesh(cds_t* cds, int nEXT, dfloat time, i
   }
   return o_p0;
 }
-occa::memory scalarStrongSubCycle(cds_t* cds, int nEXT, dfloat time, int is,
+
+occa::memory scalarStrongSubCycle(cds_t* cds, int nEXT, dfloat time, int is, int Nfields,
                                   occa::memory o_U, occa::memory o_S)
 {
   linAlg_t* linAlg= platform->linAlg;
   dlong offset = std::max(cds->vFieldOffset, cds->meshV->Nelements * cds->meshV->cubNp);
 
+  // scratch layout: S [Nfields], S0 (or 2N residual) [Nfields], rhs [nRhs][Nfields]
+  const int nRhs = (cds->RKform == SUBCYCLE_ERK) ? cds->nRK : 1;
+  const dlong fieldOffset = cds->fieldOffset[is];
+  occa::memory o_Sd = platform->scratch.acquire((2 + nRhs) * Nfields * fieldOffset * sizeof(dfloat));
+  occa::memory o_S0 = o_Sd.slice(Nfields * fieldOffset * sizeof(dfloat));
+  occa::memory o_rhsRK = o_Sd.slice(2 * Nfields * fieldOffset * sizeof(dfloat));
+
+  launchGraph_t& graph = cds->subCycleGraph[is];
+  const std::string graphKey = launchGraph_t::key(nEXT, Nfields, cds->dt[0], cds->dt[1], cds->dt[2],
+                                                  cds->coeffBDF[0], cds->coeffBDF[1], cds->coeffBDF[2],
+                                                  o_U, o_S, o_Sd);
+  if(graph.replay(graphKey)) return o_Sd;
+  graph.beginCapture(graphKey);
+
+  if(cds->RKform == SUBCYCLE_LSRK_2N)
+    graph.host([=]() mutable { linAlg->fill(Nfields * fieldOffset, 0.0, o_S0); });
+
   // Solve for Each SubProblem
   for (int torder = (nEXT - 1); torder >= 0; torder--) {
     // Initialize SubProblem Velocity i.e. Ud = U^(t-torder*dt)
     const dlong toffset = cds->fieldOffsetScan[is] +
                           torder * cds->fieldOffsetSum;
-    cds->subCycleInitU0Kernel(
+    graph(cds->subCycleInitU0Kernel,
       cds->mesh[0]->Nlocal,
-      1,
-      cds->fieldOffset[is],
+      Nfields,
+      fieldOffset,
       torder,
       nEXT,
       toffset,
@@ -1102,48 +1225,25 @@ occa::memory scalarStrongSubCycle(cds_t* cds, int nEXT, dfloat time, int is,
       cds->coeffBDF[torder],
       cds->mesh[0]->o_LMM,
       o_S,
-      platform->o_mempool.slice0
+      o_Sd
     );
 
     // Advance SubProblem to t^(n-torder+1)
-    dfloat tsub = time;
-    for (int i = torder; i > 0 ; i--) tsub -= cds->dt[i];
     const dfloat sdt = cds->dt[torder]/cds->Nsubsteps;
 
     for(int ststep = 0; ststep < cds->Nsubsteps; ++ststep) {
-      const dfloat tstage = tsub + ststep * sdt;
-
-      platform->o_mempool.slice0.copyFrom(platform->o_mempool.slice0, cds->fieldOffset[is] * sizeof(dfloat),
-                           cds->fieldOffset[is] * sizeof(dfloat), 0);
+      if(cds->RKform != SUBCYCLE_LSRK_2N)
+        graph.host([=]() mutable { o_S0.copyFrom(o_Sd, Nfields * fieldOffset * sizeof(dfloat)); });
 
       for(int rk = 0; rk < cds->nRK; ++rk) {
-        // Extrapolate velocity to subProblem stage time
-        const dfloat t   = tstage +  sdt * cds->nodesRK[rk];
-        const dfloat tn0 = time;
-        const dfloat tn1 = time - cds->dt[1];
-        const dfloat tn2 = time - (cds->dt[1] + cds->dt[2]);
-        dfloat extC[3] = {0.,0.,0.};
-        switch(nEXT) {
-        case 1:
-          extC[0] = 1;
-          extC[1] = 0;
-          extC[2] = 0;
-          break;
-        case 2:
-          extC[0] = (t - tn1) / (tn0 - tn1);
-          extC[1] = (t - tn0) / (tn1 - tn0);
-          extC[2] = 0;
-          break;
-        case 3:
-          extC[0] = (t - tn1) * (t - tn2) / ((tn0 - tn1) * (tn0 - tn2));
-          extC[1] = (t - tn0) * (t - tn2) / ((tn1 - tn0) * (tn1 - tn2));
-          extC[2] = (t - tn0) * (t - tn1) / ((tn2 - tn0) * (tn2 - tn1));
-          break;
-        }
+        // extrapolation weights of the velocity at the stage time
+        occa::memory o_extC = subCycleExtC(cds->o_stepCoeff, cds->Nsubsteps, cds->nRK, torder, ststep, rk);
+
+        const dlong rhsOffset = (cds->RKform == SUBCYCLE_ERK) ? rk * Nfields * fieldOffset : 0;
 
         if(cds->meshV->NglobalGatherElements) {
           if(cds->options[is].compareArgs("ADVECTION TYPE", "CUBATURE"))
-            cds->subCycleStrongCubatureVolumeKernel(
+            graph(cds->subCycleStrongCubatureVolumeKernel,
               cds->meshV->NglobalGatherElements,
               cds->meshV->o_globalGatherElementList,
               cds->meshV->o_cubDiffInterpT,
@@ -1151,43 +1251,36 @@ occa::memory scalarStrongSubCycle(cds_t* cds, int nEXT, dfloat time, int is,
               cds->meshV->o_cubProjectT,
               cds->vFieldOffset,
               offset,
-              rk * cds->fieldOffset[is],
+              rhsOffset,
+              Nfields,
               cds->mesh[0]->o_invLMM,
               cds->mesh[0]->o_divU,
-              extC[0],
-              extC[1],
-              extC[2],
+              o_extC,
               cds->o_Urst,
-              platform->o_mempool.slice0,
-              platform->o_mempool.slice2);
+              o_Sd,
+              o_rhsRK);
           else
-            cds->subCycleStrongVolumeKernel(
+            graph(cds->subCycleStrongVolumeKernel,
               cds->meshV->NglobalGatherElements,
               cds->meshV->o_globalGatherElementList,
               cds->meshV->o_D,
               cds->vFieldOffset,
-              rk * cds->fieldOffset[is],
+              rhsOffset,
+              Nfields,
               cds->mesh[0]->o_invLMM,
               cds->mesh[0]->o_divU,
-              extC[0],
-              extC[1],
-              extC[2],
+              o_extC,
               cds->o_Urst,
-              platform->o_mempool.slice0,
-              platform->o_mempool.slice2);
+              o_Sd,
+              o_rhsRK);
         }
 
-        occa::memory o_rhs;
-        if(rk == 0) o_rhs = platform->o_mempool.slice2;
-        if(rk == 1) o_rhs = platform->o_mempool.slice3;
-        if(rk == 2) o_rhs = platform->o_mempool.slice4;
-        if(rk == 3) o_rhs = platform->o_mempool.slice5;
-
-        oogs::start(o_rhs, 1, cds->fieldOffset[is], ogsDfloat, ogsAdd, cds->gsh);
-
+        // one exchange per stage for all fields of the batch
+        occa::memory o_rhs = o_rhsRK.slice(rhsOffset * sizeof(dfloat));
+        graph.host([=]() mutable { oogs::start(o_rhs, Nfields, fieldOffset, ogsDfloat, ogsAdd, cds->gsh); });
         if(cds->meshV->NlocalGatherElements) {
           if(cds->options[is].compareArgs("ADVECTION TYPE", "CUBATURE"))
-            cds->subCycleStrongCubatureVolumeKernel(
+            graph(cds->subCycleStrongCubatureVolumeKernel,
               cds->meshV->NlocalGatherElements,
               cds->meshV->o_localGatherElementList,
               cds->meshV->o_cubDiffInterpT,
@@ -1195,49 +1288,72 @@ occa::memory scalarStrongSubCycle(cds_t* cds, int nEXT, dfloat time, int is,
               cds->meshV->o_cubProjectT,
               cds->vFieldOffset,
               offset,
-              rk * cds->fieldOffset[is],
+              rhsOffset,
+              Nfields,
               cds->mesh[0]->o_invLMM,
               cds->mesh[0]->o_divU,
-              extC[0],
-              extC[1],
-              extC[2],
+              o_extC,
               cds->o_Urst,
-              platform->o_mempool.slice0,
-              platform->o_mempool.slice2);
+              o_Sd,
+              o_rhsRK);
           else
-            cds->subCycleStrongVolumeKernel(
+            graph(cds->subCycleStrongVolumeKernel,
               cds->meshV->NlocalGatherElements,
               cds->meshV->o_localGatherElementList,
               cds->meshV->o_D,
               cds->vFieldOffset,
-              rk * cds->fieldOffset[is],
+              rhsOffset,
+              Nfields,
               cds->mesh[0]->o_invLMM,
               cds->mesh[0]->o_divU,
-              extC[0],
-              extC[1],
-              extC[2],
+              o_extC,
               cds->o_Urst,
-              platform->o_mempool.slice0,
-              platform->o_mempool.slice2);
+              o_Sd,
+              o_rhsRK);
         }
 
-        oogs::finish(o_rhs, 1, cds->fieldOffset[is], ogsDfloat, ogsAdd, cds->gsh);
-
-        cds->subCycleRKUpdateKernel(
-          cds->meshV->Nelements,
-          rk,
-          sdt,
-          cds->fieldOffset[is],
-          cds->o_coeffsfRK,
-          cds->o_weightsRK,
-          platform->o_mempool.slice1,
-          platform->o_mempool.slice2,
-          platform->o_mempool.slice0);
+        graph.host([=]() mutable { oogs::finish(o_rhs, Nfields, fieldOffset, ogsDfloat, ogsAdd, cds->gsh); });
+        if(cds->RKform == SUBCYCLE_LSRK_2N)
+          graph(cds->subCycleRKUpdateKernel,
+            cds->meshV->Nelements,
+            sdt,
+            cds->coeffsfRK[rk],
+            cds->weightsRK[rk],
+            fieldOffset,
+            Nfields,
+            o_rhs,
+            o_S0,
+            o_Sd);
+        else if(cds->RKform == SUBCYCLE_SSPRK_2S)
+          graph(cds->subCycleRKUpdateKernel,
+            cds->meshV->Nelements,
+            sdt,
+            cds->coeffsfRK[rk],
+            cds->weightsRK[rk],
+            fieldOffset,
+            Nfields,
+            o_S0,
+            o_rhs,
+            o_Sd);
+        else
+          graph(cds->subCycleRKUpdateKernel,
+            cds->meshV->Nelements,
+            rk,
+            sdt,
+            fieldOffset,
+            Nfields,
+            cds->o_coeffsfRK,
+            cds->o_weightsRK,
+            o_S0,
+            o_rhsRK,
+            o_Sd);
       }
     }
   }
-  linAlg->axmy(cds->mesh[0]->Nlocal, 1.0, cds->mesh[0]->o_LMM, platform->o_mempool.slice0);
-  return platform->o_mempool.slice0;
+  graph.host([=]() mutable { linAlg->axmyMany(cds->mesh[0]->Nlocal, Nfields, fieldOffset, 0, 1.0, cds->mesh[0]->o_LMM, o_Sd); });
+  graph.endCapture();
+
+  return o_Sd;
 }
 
 void printInfo(nrs_t *nrs, dfloat time, int tstep, double tElapsedStep, double tElapsed)
@@ -1270,6 +1386,12 @@ void printInfo(nrs_t *nrs, dfloat time, int tstep, double tElapsedStep, double t
         }
       }
  
+      if(nrs->meshSolver) {
+        elliptic_t *solver = nrs->meshSolver;
+        printf("  MSH: iter %03d  resNorm00 %e  resNorm0 %e  resNorm %e\n",
+               solver->Niter, solver->res00Norm, solver->res0Norm, solver->resNorm);
+      }
+
       for(int is = 0; is < nrs->Nscalar; is++) {
         elliptic_t * solver = cds->solver[is];
         printf("  S%02d: iter %03d  resNorm00 %e  resNorm0 %e  resNorm %e\n", is,
@@ -1286,6 +1408,7 @@ void printInfo(nrs_t *nrs, dfloat time, int tstep, double tElapsedStep, double t
         printf("  U: %d  V: %d  W: %d  P: %d", 
        	       nrs->uSolver->Niter, nrs->vSolver->Niter, nrs->wSolver->Niter, nrs->pSolver->Niter);
     }
+    if(nrs->meshSolver) printf("  MSH: %d", nrs->meshSolver->Niter);
     for(int is = 0; is < nrs->Nscalar; is++)
       if(cds->compute[is]) printf("  S: %d", cds->solver[is]->Niter);
  